@@ -51,6 +51,11 @@ parser.add_argument(
     "components",
     help="components of a compound flag, if applicable, joined with :",
 )
+parser.add_argument(
+    "compiled_out",
+    help="whether the trace points of the flag are compiled out "
+    "(True or False)",
+)
 
 args = parser.parse_args()
 
@@ -64,6 +69,19 @@ else:
     sys.exit(1)
 components = args.components.split(":") if args.components else []
 
+compiled_out = args.compiled_out.lower()
+if compiled_out == "true":
+    compiled_out = True
+elif compiled_out == "false":
+    compiled_out = False
+else:
+    print(f'Unrecognized "COMPILED_OUT" value {compiled_out}', file=sys.stderr)
+    sys.exit(1)
+
+flag_type = "CompoundFlag" if components else "SimpleFlag"
+if compiled_out:
+    flag_type = f"CompiledOutFlag<{flag_type}>"
+
 code = code_formatter()
 
 code(
@@ -101,7 +119,7 @@ inline union ${{args.name}}
 {
     ~${{args.name}}() {}
 
-    CompoundFlag flag${{args.name}};
+    ${flag_type} flag${{args.name}};
 
     ${{args.name}}() : flag${{args.name}}("${{args.name}}", "${{args.desc}}",
         {
@@ -118,7 +136,7 @@ else:
 inline union ${{args.name}}
 {
     ~${{args.name}}() {}
-    SimpleFlag flag${{args.name}};
+    ${flag_type} flag${{args.name}};
 
     ${{args.name}}() : flag${{args.name}}("${{args.name}}", "${{args.desc}}", ${{"true" if fmt else "false"}}) {}
 
@@ -0,0 +1,181 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script measures the host time needed to simulate a single DRAM
+# channel with deep, full read and write queues, to benchmark the
+# scheduling decisions of the memory controller. The traffic generator
+# issues random requests across all the banks of all the ranks faster
+# than the DRAM can serve them, so the controller queues stay full and
+# every decision has to pick amongst many packets.
+#
+# Example:
+#   build/NULL/gem5.opt configs/dram/sched_bench.py -r 4 --buffer-size 256
+
+import argparse
+import time
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+from m5.util.convert import anyToLatency
+
+addToPath("../")
+
+from common import (
+    MemConfig,
+    ObjectList,
+)
+
+parser = argparse.ArgumentParser()
+
+parser.add_argument(
+    "--mem-type",
+    default="DDR4_2400_16x4",
+    choices=ObjectList.mem_list.get_names(),
+    help="type of memory to use",
+)
+parser.add_argument(
+    "--mem-ranks", "-r", type=int, default=4, help="Number of ranks"
+)
+parser.add_argument(
+    "--buffer-size",
+    type=int,
+    default=256,
+    help="Number of entries of the read and write queues",
+)
+parser.add_argument(
+    "--rd_perc", type=int, default=67, help="Percentage of read commands"
+)
+parser.add_argument(
+    "--sched",
+    default="frfcfs",
+    choices=["fcfs", "frfcfs"],
+    help="Memory scheduling policy",
+)
+parser.add_argument(
+    "--addr-map",
+    choices=ObjectList.dram_addr_map_list.get_names(),
+    default="RoRaBaCoCh",
+    help="DRAM address map policy",
+)
+parser.add_argument(
+    "--duration", default="1ms", help="Simulated time of the benchmark"
+)
+
+args = parser.parse_args()
+
+system = System(membus=IOXBar(width=32))
+system.clk_domain = SrcClockDomain(
+    clock="2.0GHz", voltage_domain=VoltageDomain(voltage="1V")
+)
+
+mem_range = AddrRange("1GiB")
+system.mem_ranges = [mem_range]
+system.mmap_using_noreserve = True
+
+# use a single channel, as the DRAM traffic generator assumes
+args.mem_channels = 1
+args.external_memory_system = 0
+args.tlm_memory = 0
+args.elastic_trace_en = 0
+MemConfig.config_mem(args, system)
+
+ctrl = system.mem_ctrls[0]
+if not isinstance(ctrl, m5.objects.MemCtrl):
+    fatal("This script assumes the controller is a MemCtrl subclass")
+if not isinstance(ctrl.dram, m5.objects.DRAMInterface):
+    fatal("This script assumes the memory is a DRAMInterface subclass")
+
+ctrl.mem_sched_policy = args.sched
+ctrl.dram.null = True
+ctrl.dram.addr_mapping = args.addr_map
+ctrl.dram.read_buffer_size = args.buffer_size
+ctrl.dram.write_buffer_size = args.buffer_size
+
+nbr_banks = ctrl.dram.banks_per_rank.value
+burst_size = int(
+    (
+        ctrl.dram.devices_per_rank.value
+        * ctrl.dram.device_bus_width.value
+        * ctrl.dram.burst_length.value
+    )
+    / 8
+)
+page_size = (
+    ctrl.dram.devices_per_rank.value * ctrl.dram.device_rowbuffer_size.value
+)
+
+# issue requests at twice the peak bandwidth of the DRAM, so that the
+# queues fill up
+itt = (
+    getattr(ctrl.dram.tBURST_MIN, "value", ctrl.dram.tBURST.value)
+    * 1000000000000
+    / 2
+)
+
+system.tgen = PyTrafficGen()
+system.tgen.port = system.membus.cpu_side_ports
+system.system_port = system.membus.cpu_side_ports
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = "timing"
+
+m5.instantiate()
+
+duration = m5.ticks.fromSeconds(anyToLatency(args.duration))
+
+
+def trace():
+    addr_map = ObjectList.dram_addr_map_list.get(args.addr_map)
+    yield system.tgen.createDram(
+        duration,
+        0,
+        mem_range.end,
+        burst_size,
+        int(itt),
+        int(itt),
+        args.rd_perc,
+        0,
+        1,
+        page_size,
+        nbr_banks,
+        nbr_banks,
+        addr_map,
+        args.mem_ranks,
+    )
+    yield system.tgen.createExit(0)
+
+
+system.tgen.start(trace())
+
+start = time.time()
+m5.simulate()
+host_seconds = time.time() - start
+
+print(
+    f"{args.mem_type}, {args.mem_ranks} ranks, {args.buffer_size} entries, "
+    f"{args.sched}: {host_seconds:.2f} host seconds for {args.duration}"
+)
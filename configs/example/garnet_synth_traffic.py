@@ -34,6 +34,7 @@ import m5
 from m5.defines import buildEnv
 from m5.objects import *
 from m5.util import addToPath
+from m5.util.convert import toFrequency
 
 addToPath("../")
 
@@ -178,6 +179,13 @@ root.system.mem_mode = "timing"
 # Not much point in this being higher than the L1 latency
 m5.ticks.setGlobalFrequency("1ps")
 
+if args.garnet_event_queues > 1:
+    # The network regions run in lock-step, one link latency apart
+    m5.ticks.fixGlobalFrequency()
+    root.sim_quantum = m5.ticks.fromSeconds(
+        args.link_latency / toFrequency(args.ruby_clock)
+    )
+
 # instantiate configuration
 m5.instantiate()
 
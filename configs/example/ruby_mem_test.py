@@ -33,6 +33,7 @@ import m5
 from m5.defines import buildEnv
 from m5.objects import *
 from m5.util import addToPath
+from m5.util.convert import toFrequency
 
 addToPath("../")
 
@@ -159,9 +160,10 @@ system.ruby.clk_domain = SrcClockDomain(
 
 #
 # The tester is most effective when randomization is turned on and
-# artifical delay is randomly inserted on messages
+# artifical delay is randomly inserted on messages. Messages crossing
+# event queues can't be randomized, though.
 #
-system.ruby.randomization = True
+system.ruby.randomization = args.ruby_event_queues <= 1
 
 assert len(cpus) == len(system.ruby._cpu_ports)
 
@@ -184,8 +186,17 @@ for i, cpu in enumerate(cpus):
 root = Root(full_system=False, system=system)
 root.system.mem_mode = "timing"
 
-# Not much point in this being higher than the L1 latency
-m5.ticks.setGlobalFrequency("1ns")
+if args.ruby_event_queues > 1:
+    # The event queues run in lock-step, one Ruby cycle apart, which
+    # needs a finer tick
+    m5.ticks.setGlobalFrequency("1ps")
+    m5.ticks.fixGlobalFrequency()
+    root.sim_quantum = m5.ticks.fromSeconds(
+        1 / toFrequency(args.ruby_clock)
+    )
+else:
+    # Not much point in this being higher than the L1 latency
+    m5.ticks.setGlobalFrequency("1ns")
 
 # instantiate configuration
 m5.instantiate()
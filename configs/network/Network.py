@@ -116,6 +116,18 @@ def define_options(parser):
         default=50000,
         help="network-level deadlock threshold.",
     )
+    parser.add_argument(
+        "--garnet-event-queues",
+        action="store",
+        type=int,
+        default=1,
+        help="""number of event queues (host threads) the garnet routers,
+            links and network interfaces are partitioned over, in bands of
+            mesh rows. The controllers and CPUs attached to a network
+            interface follow it. Only supported with the Garnet_standalone
+            protocol, and root.sim_quantum must be set no larger than the
+            link latency.""",
+    )
     parser.add_argument(
         "--simple-physical-channels",
         action="store_true",
@@ -282,3 +294,61 @@ def init_network(options, network, InterfaceClass):
         assert options.network == "garnet"
         network.enable_fault_model = True
         network.fault_model = FaultModel()
+
+
+def partition_network(options, network, cpus, cpu_sequencers):
+    """Partition a garnet network into options.garnet_event_queues regions
+    of neighbouring routers, each simulated on its own event queue. A mesh
+    is cut into bands of rows, any other topology into ranges of router
+    ids. Each link runs on the queue of the object sending on it, so flits
+    and credits only cross queues at the end of a link, where they are
+    handed over at every quantum boundary. Network interfaces, and the
+    controllers, sequencers and CPUs behind them, run on the queue of the
+    router they are attached to."""
+    num_queues = options.garnet_event_queues
+    if num_queues <= 1:
+        return
+
+    if options.network != "garnet":
+        fatal("--garnet-event-queues requires --network=garnet")
+    if buildEnv["PROTOCOL"] != "Garnet_standalone":
+        fatal("--garnet-event-queues requires the Garnet_standalone protocol")
+    if options.ruby_event_queues > 1:
+        fatal("--garnet-event-queues and --ruby-event-queues are exclusive")
+
+    num_routers = len(network.routers)
+    num_rows = options.mesh_rows if options.mesh_rows > 0 else num_routers
+    num_cols = num_routers // num_rows
+    if num_rows < num_queues:
+        fatal(
+            "Cannot partition %d rows of routers over %d event queues",
+            num_rows,
+            num_queues,
+        )
+
+    def queue_of(router):
+        return (router.router_id // num_cols) * num_queues // num_rows
+
+    for router in network.routers:
+        router.eventq_index = queue_of(router)
+
+    for link in network.int_links:
+        if link.src_cdc or link.dst_cdc or link.src_serdes or link.dst_serdes:
+            fatal(
+                "%s: CDC and SerDes are not supported with "
+                "--garnet-event-queues",
+                link,
+            )
+        # Credits flow from the destination back to the source
+        link.network_link.eventq_index = queue_of(link.src_node)
+        link.credit_link.eventq_index = queue_of(link.dst_node)
+
+    for netif, link in zip(network.netifs, network.ext_links):
+        queue = queue_of(link.int_node)
+        link.eventq_index = queue
+        netif.eventq_index = queue
+        # The controller's sequencer and buffers follow it
+        link.ext_node.eventq_index = queue
+
+    for cpu, cpu_seq in zip(cpus, cpu_sequencers):
+        cpu.eventq_index = cpu_seq.get_parent().eventq_index
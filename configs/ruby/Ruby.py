@@ -125,6 +125,16 @@ def define_options(parser):
         help="Recycle latency for ruby controller input buffers",
     )
 
+    parser.add_argument(
+        "--ruby-event-queues",
+        type=int,
+        default=1,
+        help="Number of event queues (host threads) the CPUs and the Ruby "
+        "controllers owning their sequencers are spread over. Requires "
+        "root.sim_quantum to be set no larger than the smallest latency "
+        "between controllers on different queues.",
+    )
+
     protocol = buildEnv["PROTOCOL"]
     exec(f"from . import {protocol}")
     eval(f"{protocol}.define_options(parser)")
@@ -291,6 +301,11 @@ def create_system(
         for cpu_seq in cpu_sequencers:
             cpu_seq.connectIOPorts(piobus)
 
+    partition_event_queues(
+        ruby, cpus, cpu_sequencers, options.ruby_event_queues
+    )
+    Network.partition_network(options, network, cpus, cpu_sequencers)
+
     ruby.number_of_virtual_networks = ruby.network.number_of_virtual_networks
     ruby._cpu_ports = cpu_sequencers
     ruby.num_of_sequencers = len(cpu_sequencers)
@@ -303,6 +318,25 @@ def create_system(
         )
 
 
+def partition_event_queues(ruby, cpus, cpu_sequencers, num_queues):
+    """Spread the CPUs over num_queues event queues, round-robin. Each CPU
+    shares its queue with the controller that owns its sequencer, since
+    they talk through ports. Everything else (the network, shared caches,
+    directories and memory) stays on queue 0. Messages crossing queues
+    are handed over by the MessageBuffers at every quantum boundary."""
+    if num_queues <= 1:
+        return
+
+    for i, cpu_seq in enumerate(cpu_sequencers):
+        queue = i % num_queues
+        cntrl = cpu_seq.get_parent()
+        if cntrl is not ruby:
+            cntrl.eventq_index = queue
+        cpu_seq.eventq_index = queue
+        if i < len(cpus):
+            cpus[i].eventq_index = queue
+
+
 def create_directories(options, bootmem, ruby_system, system):
     dir_cntrl_nodes = []
     for i in range(options.num_dirs):
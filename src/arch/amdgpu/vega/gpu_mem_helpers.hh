@@ -85,14 +85,14 @@ initMemReqHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type,
                 // a given lane's atomic can't cross cache lines
                 assert(!misaligned_acc);
 
-                req = std::make_shared<Request>(vaddr, sizeof(T), 0,
+                req = Request::create(vaddr, sizeof(T), 0,
                     gpuDynInst->computeUnit()->requestorId(), 0,
                     gpuDynInst->wfDynId,
                     gpuDynInst->makeAtomicOpFunctor<T>(
                         &(reinterpret_cast<T*>(gpuDynInst->a_data))[lane],
                         &(reinterpret_cast<T*>(gpuDynInst->x_data))[lane]));
             } else {
-                req = std::make_shared<Request>(vaddr, req_size, 0,
+                req = Request::create(vaddr, req_size, 0,
                                   gpuDynInst->computeUnit()->requestorId(), 0,
                                   gpuDynInst->wfDynId);
             }
@@ -158,7 +158,7 @@ initScratchReqHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type)
             RequestPtr req[N];
             PacketPtr pkt[N];
             for (int dword = 0; dword < N; ++dword) {
-                req[dword] = std::make_shared<Request>(vaddr[dword], req_size,
+                req[dword] = Request::create(vaddr[dword], req_size,
                         0, gpuDynInst->computeUnit()->requestorId(), 0,
                         gpuDynInst->wfDynId);
                 gpuDynInst->setRequestFlags(req[dword]);
@@ -211,7 +211,7 @@ initMemReqScalarHelper(GPUDynInstPtr gpuDynInst, MemCmd mem_req_type)
     if (gpuDynInst->staticInstruction()->hasNoAddr()) {
         flags.set(Request::HAS_NO_ADDR);
     }
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         vaddr, req_size, std::move(flags),
         gpuDynInst->computeUnit()->requestorId(), 0,
         gpuDynInst->wfDynId);
@@ -699,7 +699,7 @@ namespace VegaISA
 
         gpuDynInst->resetEntireStatusVector();
         gpuDynInst->setStatusVector(0, 1);
-        RequestPtr req = std::make_shared<Request>(0, 0, 0,
+        RequestPtr req = Request::create(0, 0, 0,
                                    gpuDynInst->computeUnit()->
                                    requestorId(), 0,
                                    gpuDynInst->wfDynId);
@@ -2589,7 +2589,7 @@ AtOp64::addressTranslation64(ThreadContext* tc,
     // with unexpected atomic snoop requests.
     warn_once("Doing AT (address translation) in functional mode! Fix Me!\n");
 
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
         val, 0, flags,  Request::funcRequestorId,
         tc->pcState().instAddr(), tc->contextId());
 
@@ -220,6 +220,14 @@ class TLBSetAssociative : public TLBIndexingPolicy
         return sets[set_number];
     }
 
+    const std::vector<ReplaceableEntry*> &
+    getPossibleEntries(const KeyType &key,
+                       std::vector<ReplaceableEntry*> &buffer) const override
+    {
+        Addr set_number = (key.va >> key.pageSize) & setMask;
+        return sets[set_number];
+    }
+
     Addr
     regenerateAddr(const KeyType &key,
                    const ReplaceableEntry *entry) const override
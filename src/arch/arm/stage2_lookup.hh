@@ -86,7 +86,7 @@ class Stage2LookUp : public BaseMMU::Translation
         fault(NoFault), complete(false), selfDelete(false), ss(_ss),
         ipaSpace(s1_te.ns ? PASpace::NonSecure : PASpace::Secure)
     {
-        req = std::make_shared<Request>();
+        req = Request::create();
         req->setVirt(s1_te.pAddr(s1Req->getVaddr()), s1Req->getSize(),
                      s1Req->getFlags(), s1Req->requestorId(), 0);
     }
@@ -59,17 +59,21 @@ class BasicDecodeCache
     decode(Decoder *const decoder, EMI mach_inst, Addr addr)
     {
         auto &entry = decodePages.lookup(addr);
-        if (entry.inst && (entry.machInst == mach_inst))
+        if (entry.inst && (entry.machInst == mach_inst)) {
+            ++decoder->decodeCacheStats.addrHits;
             return entry.inst;
+        }
 
         entry.machInst = mach_inst;
 
         auto iter = instMap.find(mach_inst);
         if (iter != instMap.end()) {
+            ++decoder->decodeCacheStats.instHits;
             entry.inst = iter->second;
             return entry.inst;
         }
 
+        ++decoder->decodeCacheStats.misses;
         entry.inst = decoder->decodeInst(mach_inst);
         instMap[mach_inst] = entry.inst;
         return entry.inst;
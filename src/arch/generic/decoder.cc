@@ -32,6 +32,21 @@
 namespace gem5
 {
 
+InstDecoder::DecodeCacheStats::DecodeCacheStats(statistics::Group *parent)
+    : statistics::Group(parent, "decodeCache"),
+      ADD_STAT(addrHits, statistics::units::Count::get(),
+               "Number of instructions found in the cache by address"),
+      ADD_STAT(instHits, statistics::units::Count::get(),
+               "Number of instructions found in the cache by machine "
+               "instruction"),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of instructions decoded"),
+      ADD_STAT(hitRate, statistics::units::Ratio::get(),
+               "Fraction of instructions found in the cache",
+               (addrHits + instHits) / (addrHits + instHits + misses))
+{
+}
+
 StaticInstPtr
 InstDecoder::fetchRomMicroop(MicroPC micropc, StaticInstPtr curMacroop)
 {
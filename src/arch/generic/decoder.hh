@@ -31,6 +31,7 @@
 #include "arch/generic/pcstate.hh"
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/static_inst_fwd.hh"
 #include "params/InstDecoder.hh"
@@ -49,12 +50,26 @@ class InstDecoder : public SimObject
     bool instDone = false;
     bool outOfBytes = true;
 
+    struct DecodeCacheStats : public statistics::Group
+    {
+        DecodeCacheStats(statistics::Group *parent);
+
+        /** Instructions found by address */
+        statistics::Scalar addrHits;
+        /** Instructions found by machine instruction */
+        statistics::Scalar instHits;
+        /** Instructions that had to be decoded */
+        statistics::Scalar misses;
+        statistics::Formula hitRate;
+    } decodeCacheStats;
+
   public:
     template <typename MoreBytesType>
     InstDecoder(const InstDecoderParams &params, MoreBytesType *mb_buf) :
         SimObject(params), _moreBytesPtr(mb_buf),
         _moreBytesSize(sizeof(MoreBytesType)),
-        _pcMask(~mask(floorLog2(_moreBytesSize)))
+        _pcMask(~mask(floorLog2(_moreBytesSize))),
+        decodeCacheStats(this)
     {}
 
     virtual StaticInstPtr fetchRomMicroop(
@@ -676,8 +676,10 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
 
     auto iter = instMap->find(mach_inst);
     if (iter != instMap->end()) {
+        ++decodeCacheStats.instHits;
         si = iter->second;
     } else {
+        ++decodeCacheStats.misses;
         si = decodeInst(mach_inst);
         (*instMap)[mach_inst] = si;
     }
@@ -698,8 +700,10 @@ Decoder::decode(PCStateBase &next_pc)
     updateNPC(next_pc.as<PCState>());
 
     StaticInstPtr &si = instBytes->si;
-    if (si)
+    if (si) {
+        ++decodeCacheStats.addrHits;
         return si;
+    }
 
     // We didn't match in the AddrMap, but we still populated an entry. Fix
     // up its byte masks.
@@ -729,7 +733,8 @@ Decoder::decode(PCStateBase &next_pc)
         start = 0;
     }
 
-    return decode(emi, origPC);
+    si = decode(emi, origPC);
+    return si;
 }
 
 StaticInstPtr
@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_trace.hh"
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+namespace gem5
+{
+
+namespace trace
+{
+
+namespace
+{
+
+const char magic[8] = "gem5trc";
+const uint32_t byteOrderMark = 0x01020304;
+const uint32_t version = 1;
+
+/**
+ * Traces are made of records, each starting with its kind and length.
+ * String records define the next id of a kind of string, and message
+ * records are made of a header followed by the recorded arguments.
+ */
+enum RecordKind : uint8_t
+{
+    NameRecord,
+    FlagRecord,
+    FormatRecord,
+    MessageRecord
+};
+
+/** Tick, followed by the name, flag and format string ids */
+const size_t messageHeaderSize = 8 + 3 * 4;
+
+std::atomic<uint64_t> nextLoggerId(1);
+
+template <typename T>
+void
+append(std::string &buffer, const T &value)
+{
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void
+appendRecord(std::string &buffer, uint8_t kind, const char *data,
+             uint32_t len)
+{
+    append(buffer, kind);
+    append(buffer, len);
+    buffer.append(data, len);
+}
+
+template <typename T>
+bool
+read(std::istream &in, T &value)
+{
+    return bool(in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+}
+
+} // anonymous namespace
+
+BinaryLogger::Ring::Ring(size_t size)
+    : size(size), buffer(new char[size]), head(0), tail(0)
+{
+}
+
+bool
+BinaryLogger::Ring::push(const void *header, size_t header_size,
+                         const void *payload, size_t payload_size)
+{
+    const uint32_t len = header_size + payload_size;
+    const size_t record_size = sizeof(len) + len;
+
+    // Records are contiguous, so the end of the buffer is skipped if
+    // the record doesn't fit in. A zero length marks the skipped bytes
+    // if there is room for it.
+    const size_t h = head.load(std::memory_order_relaxed);
+    size_t pos = h % size;
+    const size_t padding = size - pos < record_size ? size - pos : 0;
+    if (h + padding + record_size - tail.load(std::memory_order_acquire) >
+            size) {
+        return false;
+    }
+
+    if (padding) {
+        if (padding >= sizeof(len))
+            std::memset(&buffer[pos], 0, sizeof(len));
+        pos = 0;
+    }
+
+    std::memcpy(&buffer[pos], &len, sizeof(len));
+    std::memcpy(&buffer[pos + sizeof(len)], header, header_size);
+    std::memcpy(&buffer[pos + sizeof(len) + header_size], payload,
+                payload_size);
+    head.store(h + padding + record_size, std::memory_order_release);
+    return true;
+}
+
+void
+BinaryLogger::Ring::pop(std::string &records)
+{
+    const size_t h = head.load(std::memory_order_acquire);
+    size_t t = tail.load(std::memory_order_relaxed);
+    while (t != h) {
+        const size_t pos = t % size;
+        uint32_t len = 0;
+        if (size - pos >= sizeof(len))
+            std::memcpy(&len, &buffer[pos], sizeof(len));
+
+        if (len == 0) {
+            t += size - pos;
+        } else {
+            appendRecord(records, MessageRecord,
+                         &buffer[pos + sizeof(len)], len);
+            t += sizeof(len) + len;
+        }
+    }
+    tail.store(t, std::memory_order_release);
+}
+
+int
+BinaryLogger::TextBuffer::sync()
+{
+    if (!str().empty()) {
+        logger.logMessage(MaxTick, "", "", str());
+        str("");
+    }
+    return 0;
+}
+
+BinaryLogger::BinaryLogger(std::ostream &stream, size_t buffer_size)
+    : stream(stream), bufferSize(buffer_size), loggerId(nextLoggerId++),
+      stopping(false), textBuffer(*this), textStream(&textBuffer)
+{
+    static_assert((int)NameString == NameRecord &&
+                  (int)FlagString == FlagRecord &&
+                  (int)FormatString == FormatRecord,
+                  "String kinds must match their record kinds");
+
+    recordArgs = true;
+
+    stream.write(magic, sizeof(magic));
+    stream.write(reinterpret_cast<const char *>(&byteOrderMark),
+                 sizeof(byteOrderMark));
+    stream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+
+    drainThread = std::thread([this]() { drainLoop(); });
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    textStream.flush();
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    drainThread.join();
+
+    flush();
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!isEnabled(name))
+        return;
+
+    TraceArgs &args = TraceArgs::scratch();
+    args.clear();
+    args.add(message);
+    logArgs(when, name, flag, "%s", args);
+}
+
+void
+BinaryLogger::logArgs(Tick when, const std::string &name,
+        const std::string &flag, const char *fmt, const TraceArgs &args)
+{
+    ThreadBuffer &buffer = threadBuffer();
+
+    auto format = buffer.formats.find(fmt);
+    if (format == buffer.formats.end() || format->second.first != fmt) {
+        format = buffer.formats.insert_or_assign(
+            fmt, std::make_pair(std::string(fmt),
+                                defineString(FormatString, fmt))).first;
+    }
+
+    const uint32_t ids[] = {
+        stringId(buffer.names, NameString, name),
+        stringId(buffer.flags, FlagString, flag),
+        format->second.second
+    };
+    char header[messageHeaderSize];
+    std::memcpy(header, &when, sizeof(when));
+    std::memcpy(header + sizeof(when), ids, sizeof(ids));
+    static_assert(sizeof(when) + sizeof(ids) == messageHeaderSize);
+
+    // Messages too large for the ring buffer are written right away,
+    // after all the messages logged before them.
+    if (sizeof(uint32_t) + sizeof(header) + args.size() >
+            buffer.ring.maxRecordSize()) {
+        std::string message(header, sizeof(header));
+        message.append(args.data(), args.size());
+        drain(&message);
+        return;
+    }
+
+    while (!buffer.ring.push(header, sizeof(header), args.data(),
+                             args.size())) {
+        wake.notify_one();
+        std::this_thread::yield();
+    }
+
+    if (buffer.ring.halfFull())
+        wake.notify_one();
+}
+
+void
+BinaryLogger::flush()
+{
+    // The background thread already holds the drain lock if it is the
+    // one failing and flushing the trace on its way out.
+    if (std::this_thread::get_id() == drainThread.get_id())
+        return;
+
+    textStream.flush();
+    drain();
+
+    std::lock_guard<std::mutex> lock(drainMutex);
+    stream.flush();
+}
+
+BinaryLogger::ThreadBuffer &
+BinaryLogger::threadBuffer()
+{
+    // Each thread caches its buffer of the last logger it used
+    thread_local uint64_t cached_logger = 0;
+    thread_local ThreadBuffer *cached_buffer = nullptr;
+
+    if (cached_logger != loggerId) {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        auto &buffer = buffers[std::this_thread::get_id()];
+        if (!buffer)
+            buffer.reset(new ThreadBuffer(bufferSize));
+        cached_logger = loggerId;
+        cached_buffer = buffer.get();
+    }
+    return *cached_buffer;
+}
+
+uint32_t
+BinaryLogger::defineString(StringKind kind, const std::string &str)
+{
+    std::lock_guard<std::mutex> lock(stringsMutex);
+
+    const uint32_t id = strings[kind].size();
+    auto it = strings[kind].emplace(str, id);
+    if (it.second)
+        appendRecord(newStrings, kind, str.data(), str.size());
+    return it.first->second;
+}
+
+uint32_t
+BinaryLogger::stringId(std::unordered_map<std::string, uint32_t> &cache,
+                       StringKind kind, const std::string &str)
+{
+    auto it = cache.find(str);
+    if (it == cache.end())
+        it = cache.emplace(str, defineString(kind, str)).first;
+    return it->second;
+}
+
+void
+BinaryLogger::drain(const std::string *oversized)
+{
+    std::lock_guard<std::mutex> drain_lock(drainMutex);
+
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        for (auto &buffer : buffers)
+            buffer.second->ring.pop(drainedMessages);
+    }
+
+    if (oversized) {
+        appendRecord(drainedMessages, MessageRecord, oversized->data(),
+                     oversized->size());
+    }
+
+    // The strings used by the messages drained so far were all defined
+    // before the messages were logged, and have to be written first.
+    {
+        std::lock_guard<std::mutex> lock(stringsMutex);
+        drainedStrings.swap(newStrings);
+    }
+
+    stream.write(drainedStrings.data(), drainedStrings.size());
+    stream.write(drainedMessages.data(), drainedMessages.size());
+    drainedStrings.clear();
+    drainedMessages.clear();
+}
+
+void
+BinaryLogger::drainLoop()
+{
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (!stopping) {
+        wake.wait_for(lock, std::chrono::milliseconds(10));
+
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+}
+
+bool
+renderBinaryTrace(std::istream &in, std::ostream &out)
+{
+    char file_magic[sizeof(magic)];
+    uint32_t file_bom, file_version;
+    if (!in.read(file_magic, sizeof(file_magic)) ||
+        std::memcmp(file_magic, magic, sizeof(magic)) != 0 ||
+        !read(in, file_bom) || file_bom != byteOrderMark ||
+        !read(in, file_version) || file_version != version) {
+        return false;
+    }
+
+    std::vector<std::string> strings[MessageRecord];
+    OstreamLogger logger(out);
+    std::string record;
+    std::ostringstream message;
+
+    uint8_t kind;
+    uint32_t len;
+    // A truncated record ends the trace, e.g., if gem5 didn't exit
+    while (read(in, kind) && read(in, len)) {
+        record.resize(len);
+        if (!in.read(&record[0], len))
+            break;
+
+        if (kind < MessageRecord) {
+            strings[kind].push_back(record);
+            continue;
+        }
+
+        if (kind != MessageRecord || len < messageHeaderSize)
+            return false;
+
+        Tick when;
+        uint32_t ids[MessageRecord];
+        std::memcpy(&when, record.data(), sizeof(when));
+        std::memcpy(ids, record.data() + sizeof(when), sizeof(ids));
+        for (int i = 0; i < MessageRecord; ++i) {
+            if (ids[i] >= strings[i].size())
+                return false;
+        }
+
+        const std::string &fmt = strings[FormatRecord][ids[FormatRecord]];
+        message.str("");
+        TraceArgs::format(message, fmt.c_str(),
+                          record.data() + messageHeaderSize,
+                          len - messageHeaderSize);
+        logger.logMessage(when, strings[NameRecord][ids[NameRecord]],
+                          strings[FlagRecord][ids[FlagRecord]],
+                          message.str());
+    }
+
+    return true;
+}
+
+} // namespace trace
+} // namespace gem5
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BINARY_TRACE_HH__
+#define __BASE_BINARY_TRACE_HH__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "base/trace.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+/**
+ * Debug logger recording messages in a compact binary format, rather
+ * than formatting them as text, to make tracing long simulations
+ * practical.
+ *
+ * Messages are recorded as their tick and the ids of their object name,
+ * flag and format string, followed by their raw arguments (see
+ * TraceArgs). Each simulation thread appends its messages to its own
+ * lock-free ring buffer, and a background thread drains the buffers to
+ * the output stream, along with the strings behind any new id. Messages
+ * which can't be recorded raw are formatted when they are logged and
+ * recorded as a string.
+ *
+ * Traces are turned into text, formatted as by OstreamLogger, with
+ * renderBinaryTrace(), e.g., through util/render_debug_trace.py. The
+ * messages of a thread are recorded in order, but the messages of
+ * different threads are interleaved as they are drained.
+ */
+class BinaryLogger : public Logger
+{
+  public:
+    static constexpr size_t DefaultBufferSize = 1 << 20;
+
+    /**
+     * @param stream Stream to write the trace to.
+     * @param buffer_size Size of the ring buffer of each thread.
+     */
+    BinaryLogger(std::ostream &stream,
+                 size_t buffer_size=DefaultBufferSize);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    /**
+     * Get a stream to log text to directly. Text is recorded as a
+     * message without any tick or name every time the stream is
+     * flushed.
+     */
+    std::ostream &getOstream() override { return textStream; }
+
+    /**
+     * Write all the messages logged so far to the output stream. Also
+     * called when the simulator fails, through Logger::addExitHook().
+     */
+    void flush();
+
+  protected:
+    void logArgs(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            const TraceArgs &args) override;
+
+  private:
+    /** Single producer, single consumer ring buffer of records. */
+    class Ring
+    {
+      public:
+        Ring(size_t size);
+
+        /** Largest record which can be pushed. */
+        size_t maxRecordSize() const { return size / 2; }
+
+        /**
+         * Append a record, made of a header and a payload.
+         *
+         * @return False if there is no room for the record.
+         */
+        bool push(const void *header, size_t header_size,
+                  const void *payload, size_t payload_size);
+
+        bool
+        halfFull() const
+        {
+            return head.load(std::memory_order_relaxed) -
+                tail.load(std::memory_order_relaxed) > size / 2;
+        }
+
+        /** Move all the records to the end of a buffer. */
+        void pop(std::string &records);
+
+      private:
+        const size_t size;
+        std::unique_ptr<char[]> buffer;
+
+        /** Total number of bytes pushed and popped */
+        std::atomic<size_t> head;
+        std::atomic<size_t> tail;
+    };
+
+    /** Records and ids of the strings used by a single thread. */
+    struct ThreadBuffer
+    {
+        ThreadBuffer(size_t size) : ring(size) {}
+
+        Ring ring;
+        std::unordered_map<std::string, uint32_t> names;
+        std::unordered_map<std::string, uint32_t> flags;
+        /**
+         * Format strings are looked up by address first, and their
+         * content is then checked in case the address was reused.
+         */
+        std::unordered_map<const char *, std::pair<std::string, uint32_t>>
+            formats;
+    };
+
+    /** Text stream buffer logging its content on every flush. */
+    class TextBuffer : public std::stringbuf
+    {
+      public:
+        TextBuffer(BinaryLogger &logger) : logger(logger) {}
+
+      protected:
+        int sync() override;
+
+      private:
+        BinaryLogger &logger;
+    };
+
+    enum StringKind : uint8_t
+    {
+        NameString,
+        FlagString,
+        FormatString,
+        NumStringKinds
+    };
+
+    ThreadBuffer &threadBuffer();
+
+    /** Get the id of a string, defining it if it is new. */
+    uint32_t defineString(StringKind kind, const std::string &str);
+
+    /** Get the id of a string, from the cache of the calling thread. */
+    uint32_t stringId(std::unordered_map<std::string, uint32_t> &cache,
+                      StringKind kind, const std::string &str);
+
+    void drain(const std::string *oversized=nullptr);
+    void drainLoop();
+
+    std::ostream &stream;
+    const size_t bufferSize;
+
+    /** Unique id of the logger, identifying the buffer cached by threads */
+    const uint64_t loggerId;
+
+    /** Buffers of all the threads, and the mutex protecting the map */
+    std::mutex buffersMutex;
+    std::map<std::thread::id, std::unique_ptr<ThreadBuffer>> buffers;
+
+    /**
+     * Ids of all the strings defined so far, and the records defining
+     * the strings which haven't been written yet.
+     */
+    std::mutex stringsMutex;
+    std::unordered_map<std::string, uint32_t> strings[NumStringKinds];
+    std::string newStrings;
+
+    /** Serializes the consumers of the ring buffers */
+    std::mutex drainMutex;
+    std::string drainedStrings;
+    std::string drainedMessages;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool stopping;
+    std::thread drainThread;
+
+    TextBuffer textBuffer;
+    std::ostream textStream;
+};
+
+/**
+ * Render a trace recorded by BinaryLogger as text.
+ *
+ * @return False if the input is not a binary trace.
+ */
+bool renderBinaryTrace(std::istream &in, std::ostream &out);
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __BASE_BINARY_TRACE_HH__
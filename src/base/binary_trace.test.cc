@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/binary_trace.hh"
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/gtest/logging.hh"
+
+using namespace gem5;
+
+// Instantiate the mock class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+struct Printable
+{
+    int value;
+};
+
+std::ostream &
+operator<<(std::ostream &os, const Printable &p)
+{
+    return os << "Printable(" << p.value << ")";
+}
+
+/** Log the same messages, of all kinds of arguments, to a logger. */
+void
+logMessages(trace::Logger &logger)
+{
+    const std::string str("string");
+    static const int value = 0;
+
+    logger.dprintf_flag(Tick(100), "Foo", "Flag", "No args\n");
+    logger.dprintf_flag(Tick(101), "Foo", "", "%s %c %d %x %#06x\n",
+        "message", 'A', 217, 0x30, 0x30u);
+    logger.dprintf_flag(Tick(102), "Bar", "Flag", "%d %d %d %x %#o\n",
+        true, (signed char)-1, (unsigned char)255, (short)-1, 8ull);
+    logger.dprintf_flag(Tick(103), "Bar", "", "%x %d %lu %s\n",
+        -1, -1l, 0xffffffffffffffffull, str);
+    logger.dprintf_flag(Tick(104), "Foo", "", "%f %.3f %e %g %5.1f\n",
+        1.5f, 3.14159, 2.5e10, 0.1, -2.25);
+    logger.dprintf_flag(Tick(105), "Foo", "", "%*d|%-4s|%4s|\n",
+        6, 42, "ab", str);
+    logger.dprintf_flag(Tick(106), "Foo", "", "%p\n", &value);
+    logger.dprintf_flag(Tick(107), "Foo", "", "Not raw: %s %d\n",
+        Printable{3}, 4);
+    logger.dprintf_flag(Tick(108), "Foo", "", "Missing %d %d\n", 1);
+    logger.dprintf_flag(Tick(109), "Foo", "", "Extra %d\n", 1, 2);
+    logger.dprintf(MaxTick, "", "Multiple\nlines\n");
+    logger.dump(Tick(110), "Foo", str.data(), str.size(), "Flag");
+    logger.dprintf_flag(Tick(111), "Foo", "", "%s\n",
+        std::string(1000, 'x'));
+}
+
+std::string
+render(const std::stringstream &trace)
+{
+    std::stringstream in(trace.str());
+    std::stringstream out;
+    EXPECT_TRUE(trace::renderBinaryTrace(in, out));
+    return out.str();
+}
+
+} // anonymous namespace
+
+/** Test that rendered messages match the messages logged as text. */
+TEST(BinaryTraceTest, Render)
+{
+    std::stringstream text;
+    trace::OstreamLogger text_logger(text);
+    logMessages(text_logger);
+
+    std::stringstream trace;
+    {
+        trace::BinaryLogger logger(trace);
+        logMessages(logger);
+    }
+
+    EXPECT_EQ(render(trace), text.str());
+}
+
+/**
+ * Test that messages wrap around small ring buffers, and that messages
+ * larger than the buffers are written in order.
+ */
+TEST(BinaryTraceTest, SmallBuffer)
+{
+    std::stringstream text;
+    trace::OstreamLogger text_logger(text);
+    std::stringstream trace;
+    {
+        trace::BinaryLogger logger(trace, 160);
+        for (int i = 0; i < 100; ++i) {
+            logMessages(text_logger);
+            logMessages(logger);
+        }
+    }
+
+    EXPECT_EQ(render(trace), text.str());
+}
+
+/** Test that the messages of each thread are recorded in order. */
+TEST(BinaryTraceTest, Threads)
+{
+    const int num_threads = 4;
+    const int num_messages = 10000;
+
+    std::stringstream trace;
+    {
+        trace::BinaryLogger logger(trace, 4096);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&logger, t]() {
+                const std::string name = "thread" + std::to_string(t);
+                for (int i = 0; i < num_messages; ++i)
+                    logger.dprintf(Tick(i), name, "%d\n", i);
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    std::istringstream lines(render(trace));
+    std::vector<int> next(num_threads, 0);
+    std::string line;
+    while (std::getline(lines, line)) {
+        int tick, thread, value;
+        ASSERT_EQ(std::sscanf(line.c_str(), "%d: thread%d: %d", &tick,
+                              &thread, &value), 3);
+        ASSERT_LT(thread, num_threads);
+        ASSERT_EQ(value, next[thread]);
+        ASSERT_EQ(tick, value);
+        ++next[thread];
+    }
+    for (int t = 0; t < num_threads; ++t)
+        EXPECT_EQ(next[t], num_messages);
+}
+
+/** Test that text written to the stream of the logger is recorded. */
+TEST(BinaryTraceTest, Ostream)
+{
+    std::stringstream trace;
+    {
+        trace::BinaryLogger logger(trace);
+        logger.dprintf_flag(Tick(100), "Foo", "", "Message\n");
+        logger.getOstream() << "Some text" << std::endl;
+        logger.getOstream() << "Unflushed text";
+    }
+
+    EXPECT_EQ(render(trace),
+              "    100: Foo: Message\nSome text\nUnflushed text");
+}
+
+/** Test that ignored objects are not recorded. */
+TEST(BinaryTraceTest, Ignore)
+{
+    std::stringstream trace;
+    {
+        trace::BinaryLogger logger(trace);
+        ObjectMatch ignore_foo("Foo");
+        logger.setIgnore(ignore_foo);
+        logger.dprintf_flag(Tick(100), "Foo", "", "Message\n");
+        logger.dprintf_flag(Tick(101), "Bar", "", "Message %d\n", 1);
+    }
+
+    EXPECT_EQ(render(trace), "    101: Bar: Message 1\n");
+}
+
+/** Test that traces are flushed on demand. */
+TEST(BinaryTraceTest, Flush)
+{
+    std::stringstream trace;
+    trace::BinaryLogger logger(trace);
+    logger.dprintf_flag(Tick(100), "Foo", "", "Message %d\n", 1);
+    logger.flush();
+
+    EXPECT_EQ(render(trace), "    100: Foo: Message 1\n");
+}
+
+/** Test that anything but a binary trace is rejected. */
+TEST(BinaryTraceTest, InvalidTrace)
+{
+    std::stringstream in("    100: Foo: Message 1\n");
+    std::stringstream out;
+    EXPECT_FALSE(trace::renderBinaryTrace(in, out));
+}
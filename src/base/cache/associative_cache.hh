@@ -81,6 +81,9 @@ class AssociativeCache : public Named
     /** The entries */
     std::vector<Entry> entries;
 
+    /** Buffer for the possible entries of lookups, to avoid allocating. */
+    mutable std::vector<ReplaceableEntry*> entryBuffer;
+
     const ::gem5::debug::SimpleFlag* debugFlag = nullptr;
 
   private:
@@ -208,7 +211,8 @@ class AssociativeCache : public Named
     virtual Entry*
     findEntry(const KeyType &key) const
     {
-        auto candidates = indexingPolicy->getPossibleEntries(key);
+        const auto &candidates =
+            indexingPolicy->getPossibleEntries(key, entryBuffer);
 
         for (auto candidate : candidates) {
             Entry *entry = static_cast<Entry*>(candidate);
@@ -228,7 +232,8 @@ class AssociativeCache : public Named
     virtual Entry*
     findVictim(const KeyType &key)
     {
-        auto candidates = indexingPolicy->getPossibleEntries(key);
+        const auto &candidates =
+            indexingPolicy->getPossibleEntries(key, entryBuffer);
 
         auto victim = static_cast<Entry*>(replPolicy->getVictim(candidates));
 
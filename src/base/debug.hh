@@ -84,6 +84,12 @@ class Flag
 
     operator bool() const { return tracing(); }
 
+    /**
+     * Check if the trace points of this flag are compiled out of the
+     * build (see CompiledOutFlag).
+     */
+    virtual bool compiledOut() const { return false; }
+
     static void globalEnable();
     static void globalDisable();
 };
@@ -133,6 +139,25 @@ class CompoundFlag : public Flag
     void disable() override;
 };
 
+/**
+ * A flag whose trace points are compiled out of the build, as it isn't
+ * in the debug flag allowlist of the build (DEBUG_FLAG_ALLOWLIST). The
+ * flag can still be enabled, but it never traces when checked through
+ * its own type, as done by DPRINTF and friends, so the compiler can
+ * optimize these checks and the code they guard away.
+ */
+template <class Base>
+class CompiledOutFlag : public Base
+{
+  public:
+    using Base::Base;
+
+    constexpr bool tracing() const { return false; }
+    constexpr operator bool() const { return false; }
+
+    bool compiledOut() const override { return true; }
+};
+
 class AllFlagsFlag : public CompoundFlag
 {
   protected:
@@ -306,3 +306,33 @@ TEST(DebugFlagTest, DumpDebugFlags)
             "FlagDumpDebugFlagTestE\n");
     }
 }
+
+/** Test that compiled out flags never trace when checked directly. */
+TEST(DebugFlagTest, CompiledOut)
+{
+    debug::Flag::globalEnable();
+    debug::CompiledOutFlag<debug::SimpleFlag> flag_a("CompiledOutTestKidA",
+        "");
+    debug::SimpleFlag flag_b("CompiledOutTestKidB", "");
+    debug::CompiledOutFlag<debug::CompoundFlag> flag(
+        "CompiledOutTest", "", {&flag_a, &flag_b});
+
+    EXPECT_TRUE(flag_a.compiledOut());
+    EXPECT_FALSE(flag_b.compiledOut());
+    EXPECT_TRUE(flag.compiledOut());
+
+    flag.enable();
+    EXPECT_FALSE(flag_a);
+    EXPECT_FALSE(flag_a.tracing());
+    EXPECT_TRUE(flag_b);
+    EXPECT_FALSE(flag);
+
+    // The flag is still enabled when checked through its base class
+    const debug::Flag &base_a = flag_a;
+    EXPECT_TRUE(base_a);
+
+    flag.disable();
+    EXPECT_FALSE(base_a);
+    EXPECT_FALSE(flag_b);
+    debug::Flag::globalDisable();
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/free_list_pool.hh"
+
+#include <algorithm>
+
+namespace gem5
+{
+
+namespace
+{
+
+std::mutex poolsMutex;
+size_t nextPoolId = 0;
+
+std::vector<FreeListPool *> &
+allPools()
+{
+    static std::vector<FreeListPool *> the_pools;
+    return the_pools;
+}
+
+} // anonymous namespace
+
+FreeListPool::FreeListPool(const std::string &name, size_t block_size,
+                           size_t max_free)
+    : _name(name),
+      _blockSize(std::max(block_size, sizeof(FreeBlock))),
+      maxFree(max_free),
+      id([this]() {
+          std::lock_guard<std::mutex> lock(poolsMutex);
+          allPools().push_back(this);
+          return nextPoolId++;
+      }())
+{
+}
+
+FreeListPool::~FreeListPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(poolsMutex);
+        auto &pools = allPools();
+        pools.erase(std::find(pools.begin(), pools.end(), this));
+    }
+
+    // Pool ids are never reused, so the threads will not look up these
+    // caches anymore.
+    for (auto *cache : threadCaches) {
+        while (FreeBlock *block = cache->freeList) {
+            cache->freeList = block->next;
+            ::operator delete(block);
+        }
+        delete cache;
+    }
+}
+
+FreeListPool::ThreadCache &
+FreeListPool::newThreadCache(std::vector<ThreadCache *> &caches)
+{
+    if (caches.size() <= id)
+        caches.resize(id + 1, nullptr);
+
+    auto *cache = new ThreadCache;
+    caches[id] = cache;
+
+    std::lock_guard<std::mutex> lock(cachesMutex);
+    threadCaches.push_back(cache);
+    return *cache;
+}
+
+FreeListPool::Counters
+FreeListPool::counters() const
+{
+    Counters total;
+
+    std::lock_guard<std::mutex> lock(cachesMutex);
+    for (const auto *cache : threadCaches) {
+        total.hits += cache->counters.hits;
+        total.misses += cache->counters.misses;
+        total.frees += cache->counters.frees;
+    }
+
+    return total;
+}
+
+const std::vector<FreeListPool *> &
+FreeListPool::pools()
+{
+    return allPools();
+}
+
+} // namespace gem5
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_FREE_LIST_POOL_HH__
+#define __BASE_FREE_LIST_POOL_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * A pool of fixed-size memory blocks, kept on per-thread free lists.
+ *
+ * Blocks released to the pool are put on the free list of the
+ * releasing thread and handed out again by the next allocation on
+ * that thread, without taking any lock. Requests larger than the
+ * block size, and blocks released to a full free list, go to the
+ * global heap.
+ *
+ * Pools are meant to be created during static initialization and to
+ * live until the end of the simulation. They are registered in a
+ * global list so that their usage can be reported. A pool must not
+ * be destroyed while any of its blocks is in use.
+ */
+class FreeListPool
+{
+  public:
+    /** Usage counters, summed over all threads. */
+    struct Counters
+    {
+        //! Allocations served from a free list
+        uint64_t hits = 0;
+        //! Allocations served from the heap
+        uint64_t misses = 0;
+        //! Blocks released
+        uint64_t frees = 0;
+
+        uint64_t allocs() const { return hits + misses; }
+        uint64_t live() const { return allocs() - frees; }
+    };
+
+    /**
+     * @param name Name of the pool, used for reporting
+     * @param block_size Size of the blocks of the pool
+     * @param max_free Maximum number of free blocks per thread
+     */
+    FreeListPool(const std::string &name, size_t block_size,
+                 size_t max_free=4096);
+
+    ~FreeListPool();
+
+    FreeListPool(const FreeListPool &) = delete;
+    FreeListPool &operator=(const FreeListPool &) = delete;
+
+    const std::string &name() const { return _name; }
+    size_t blockSize() const { return _blockSize; }
+
+    /** Allocate a block of at least size bytes. */
+    void *
+    allocate(size_t size)
+    {
+        if (size > _blockSize)
+            return ::operator new(size);
+
+        ThreadCache &cache = threadCache();
+        if (FreeBlock *block = cache.freeList) {
+            cache.freeList = block->next;
+            --cache.numFree;
+            ++cache.counters.hits;
+            return block;
+        }
+
+        ++cache.counters.misses;
+        return ::operator new(_blockSize);
+    }
+
+    /** Release a block obtained from allocate() with the same size. */
+    void
+    deallocate(void *ptr, size_t size)
+    {
+        if (size > _blockSize) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        ThreadCache &cache = threadCache();
+        ++cache.counters.frees;
+        if (cache.numFree >= maxFree) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        auto *block = static_cast<FreeBlock *>(ptr);
+        block->next = cache.freeList;
+        cache.freeList = block;
+        ++cache.numFree;
+    }
+
+    /**
+     * Sum the counters of all threads. The result is only exact while
+     * no other thread uses the pool.
+     */
+    Counters counters() const;
+
+    /** All the pools, in creation order. */
+    static const std::vector<FreeListPool *> &pools();
+
+  private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    struct ThreadCache
+    {
+        FreeBlock *freeList = nullptr;
+        size_t numFree = 0;
+        Counters counters;
+    };
+
+    ThreadCache &
+    threadCache()
+    {
+        // Each thread keeps its caches in a vector indexed by pool id,
+        // since a thread_local member can not be per pool.
+        thread_local std::vector<ThreadCache *> caches;
+        if (id < caches.size() && caches[id])
+            return *caches[id];
+        return newThreadCache(caches);
+    }
+
+    ThreadCache &newThreadCache(std::vector<ThreadCache *> &caches);
+
+    const std::string _name;
+    const size_t _blockSize;
+    const size_t maxFree;
+    const size_t id;
+
+    //! Caches of all threads that used the pool, which are never freed
+    //! since another thread may still read their counters
+    mutable std::mutex cachesMutex;
+    std::vector<ThreadCache *> threadCaches;
+};
+
+/**
+ * An allocator drawing from a FreeListPool, to be used with the
+ * standard containers and std::allocate_shared.
+ */
+template <typename T>
+class FreeListPoolAllocator
+{
+  public:
+    typedef T value_type;
+
+    FreeListPoolAllocator(FreeListPool &_pool) : pool(&_pool) {}
+
+    template <typename U>
+    FreeListPoolAllocator(const FreeListPoolAllocator<U> &other)
+        : pool(other.pool)
+    {}
+
+    T *
+    allocate(size_t n)
+    {
+        return static_cast<T *>(pool->allocate(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T *ptr, size_t n)
+    {
+        pool->deallocate(ptr, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool
+    operator==(const FreeListPoolAllocator<U> &other) const
+    {
+        return pool == other.pool;
+    }
+
+    template <typename U>
+    bool
+    operator!=(const FreeListPoolAllocator<U> &other) const
+    {
+        return pool != other.pool;
+    }
+
+  private:
+    template <typename U>
+    friend class FreeListPoolAllocator;
+
+    FreeListPool *pool;
+};
+
+} // namespace gem5
+
+#endif // __BASE_FREE_LIST_POOL_HH__
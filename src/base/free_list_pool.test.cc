@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "base/free_list_pool.hh"
+
+using namespace gem5;
+
+TEST(FreeListPool, Registered)
+{
+    FreeListPool pool("registered", 32);
+
+    const auto &pools = FreeListPool::pools();
+    EXPECT_NE(std::find(pools.begin(), pools.end(), &pool), pools.end());
+    EXPECT_EQ(pool.name(), "registered");
+    EXPECT_EQ(pool.blockSize(), 32);
+}
+
+TEST(FreeListPool, Unregistered)
+{
+    auto pool = std::make_unique<FreeListPool>("unregistered", 32);
+    const FreeListPool *ptr = pool.get();
+    pool.reset();
+
+    const auto &pools = FreeListPool::pools();
+    EXPECT_EQ(std::find(pools.begin(), pools.end(), ptr), pools.end());
+}
+
+TEST(FreeListPool, ReuseBlocks)
+{
+    FreeListPool pool("reuse", 32);
+
+    void *a = pool.allocate(32);
+    void *b = pool.allocate(16);
+    EXPECT_EQ(pool.counters().misses, 2);
+    EXPECT_EQ(pool.counters().live(), 2);
+
+    pool.deallocate(a, 32);
+    pool.deallocate(b, 16);
+    EXPECT_EQ(pool.counters().frees, 2);
+    EXPECT_EQ(pool.counters().live(), 0);
+
+    // Blocks are handed out again in LIFO order
+    EXPECT_EQ(pool.allocate(32), b);
+    EXPECT_EQ(pool.allocate(8), a);
+    EXPECT_EQ(pool.counters().hits, 2);
+    EXPECT_EQ(pool.counters().live(), 2);
+
+    pool.deallocate(a, 32);
+    pool.deallocate(b, 32);
+}
+
+TEST(FreeListPool, OversizedBypassesPool)
+{
+    FreeListPool pool("oversized", 32);
+
+    void *p = pool.allocate(64);
+    pool.deallocate(p, 64);
+
+    const auto counters = pool.counters();
+    EXPECT_EQ(counters.allocs(), 0);
+    EXPECT_EQ(counters.frees, 0);
+}
+
+TEST(FreeListPool, MaxFree)
+{
+    FreeListPool pool("max_free", 32, 1);
+
+    void *a = pool.allocate(32);
+    void *b = pool.allocate(32);
+    pool.deallocate(a, 32);
+    // The free list is full, so this one goes back to the heap
+    pool.deallocate(b, 32);
+
+    EXPECT_EQ(pool.allocate(32), a);
+    b = pool.allocate(32);
+    EXPECT_EQ(pool.counters().hits, 1);
+    EXPECT_EQ(pool.counters().misses, 3);
+
+    pool.deallocate(a, 32);
+    pool.deallocate(b, 32);
+}
+
+TEST(FreeListPool, PerThreadCounters)
+{
+    FreeListPool pool("threads", 32);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&pool]() {
+            for (int j = 0; j < 100; j++)
+                pool.deallocate(pool.allocate(32), 32);
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    // Each thread only misses on its first allocation
+    const auto counters = pool.counters();
+    EXPECT_EQ(counters.misses, 4);
+    EXPECT_EQ(counters.hits, 396);
+    EXPECT_EQ(counters.live(), 0);
+}
+
+TEST(FreeListPoolAllocator, SharedPtr)
+{
+    FreeListPool pool("shared_ptr", sizeof(uint64_t) + 4 * sizeof(void *));
+
+    std::shared_ptr<uint64_t> p = std::allocate_shared<uint64_t>(
+            FreeListPoolAllocator<uint64_t>(pool), 42);
+    EXPECT_EQ(*p, 42);
+    EXPECT_EQ(pool.counters().misses, 1);
+    EXPECT_EQ(pool.counters().live(), 1);
+
+    p.reset();
+    EXPECT_EQ(pool.counters().live(), 0);
+
+    p = std::allocate_shared<uint64_t>(
+            FreeListPoolAllocator<uint64_t>(pool), 43);
+    EXPECT_EQ(pool.counters().hits, 1);
+}
+
+TEST(FreeListPoolAllocator, Equality)
+{
+    FreeListPool pool_a("equality_a", 32);
+    FreeListPool pool_b("equality_b", 32);
+
+    FreeListPoolAllocator<int> a(pool_a);
+    FreeListPoolAllocator<char> a2(a);
+    FreeListPoolAllocator<int> b(pool_b);
+
+    EXPECT_TRUE(a == a2);
+    EXPECT_FALSE(a != a2);
+    EXPECT_TRUE(a != b);
+}
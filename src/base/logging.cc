@@ -40,7 +40,10 @@
 
 #include "base/logging.hh"
 
+#include <atomic>
+#include <mutex>
 #include <sstream>
+#include <vector>
 
 #include "base/hostinfo.hh"
 
@@ -49,6 +52,15 @@ namespace gem5
 
 namespace {
 
+std::mutex exitHooksMutex;
+
+std::vector<std::function<void()>> &
+exitHooks()
+{
+    static auto *hooks = new std::vector<std::function<void()>>;
+    return *hooks;
+}
+
 class ExitLogger : public Logger
 {
   public:
@@ -62,6 +74,19 @@ class ExitLogger : public Logger
         ccprintf(ss, "Memory Usage: %ld KBytes\n", memUsage());
         Logger::log(loc, s + ss.str());
     }
+
+    void
+    exit() override
+    {
+        // A hook failing would come back here, so only run them once.
+        static std::atomic<bool> exiting(false);
+        if (exiting.exchange(true))
+            return;
+
+        std::lock_guard<std::mutex> lock(exitHooksMutex);
+        for (auto &hook: exitHooks())
+            hook();
+    }
 };
 
 class FatalLogger : public ExitLogger
@@ -70,7 +95,7 @@ class FatalLogger : public ExitLogger
     using ExitLogger::ExitLogger;
 
   protected:
-    void exit() override { ::exit(1); }
+    void exit() override { ExitLogger::exit(); ::exit(1); }
 };
 
 } // anonymous namespace
@@ -81,6 +106,13 @@ class FatalLogger : public ExitLogger
 // veriables to ensure they are initialized ondemand, so it is also safe to use
 // them inside constructor of other global objects.
 
+void
+Logger::addExitHook(std::function<void()> hook)
+{
+    std::lock_guard<std::mutex> lock(exitHooksMutex);
+    exitHooks().push_back(std::move(hook));
+}
+
 Logger&
 Logger::getPanic() {
     static ExitLogger* panic_logger = new ExitLogger("panic: ");
@@ -42,6 +42,7 @@
 #define __BASE_LOGGING_HH__
 
 #include <cassert>
+#include <functional>
 #include <sstream>
 #include <utility>
 
@@ -64,6 +65,12 @@ class Logger
     static Logger &getInfo();
     static Logger &getHack();
 
+    /**
+     * Add a function to call before panic() and fatal() terminate the
+     * simulator, e.g., to write out output which is still buffered.
+     */
+    static void addExitHook(std::function<void()> hook);
+
     enum LogLevel
     {
         PANIC, FATAL, WARN, INFO, HACK,
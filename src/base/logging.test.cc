@@ -527,6 +527,26 @@ TEST(LoggingDeathTest, Fatal)
         ::testing::HasSubstr("fatal: message\nMemory Usage:"));
 }
 
+/** Test that the exit hooks run after the message of a panic. */
+TEST(LoggingDeathTest, PanicExitHook)
+{
+    ASSERT_DEATH({
+        Logger::addExitHook([]() { std::cerr << "hook\n"; });
+        panic("message\n");
+    }, ::testing::AllOf(::testing::HasSubstr("panic: message\n"),
+                        ::testing::EndsWith("hook\n")));
+}
+
+/** Test that the exit hooks run after the message of a fatal. */
+TEST(LoggingDeathTest, FatalExitHook)
+{
+    ASSERT_DEATH({
+        Logger::addExitHook([]() { std::cerr << "hook\n"; });
+        fatal("message\n");
+    }, ::testing::AllOf(::testing::HasSubstr("fatal: message\n"),
+                        ::testing::EndsWith("hook\n")));
+}
+
 /** Test that panic_if only prints the message when the condition is true. */
 TEST(LoggingDeathTest, PanicIf)
 {
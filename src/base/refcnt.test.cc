@@ -70,6 +70,11 @@ class TestRC : public RefCounted
 };
 typedef RefCountingPtr<TestRC> Ptr;
 
+class DerivedRC : public TestRC
+{
+};
+typedef RefCountingPtr<DerivedRC> DerivedPtr;
+
 } // anonymous namespace
 
 TEST(RefcntTest, NullPointerCheck)
@@ -96,6 +101,20 @@ TEST(RefcntTest, ConstructionFromExistingPointer)
     EXPECT_EQ(1, liveListSize());
 }
 
+TEST(RefcntTest, ConstructionFromDerivedPointer)
+{
+    // Construct a Ptr from a Ptr to a derived class.
+    DerivedPtr derived = new DerivedRC();
+    {
+        Ptr base = derived;
+        EXPECT_EQ(base.get(), derived.get());
+        EXPECT_EQ(1, liveListSize());
+        derived = NULL;
+        EXPECT_EQ(1, liveListSize());
+    }
+    EXPECT_EQ(0, liveListSize());
+}
+
 TEST(RefcntTest, DestroyPointer)
 {
     // Test a Ptr being destroyed.
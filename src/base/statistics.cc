@@ -56,6 +56,16 @@ namespace gem5
 namespace statistics
 {
 
+namespace
+{
+
+/** Number of the stat dump in progress, or zero */
+uint64_t dumpNumber = 0;
+/** Number of the last stat dump */
+uint64_t lastDumpNumber = 0;
+
+} // anonymous namespace
+
 // We wrap these in a function to make sure they're built in time.
 std::list<Info *> &
 statsList()
@@ -207,14 +217,35 @@ Formula::operator/=(Temp r)
 void
 Formula::result(VResult &vec) const
 {
-    if (root)
+    if (!root)
+        return;
+
+    if (!dumpNumber) {
         vec = root->result();
+        return;
+    }
+
+    if (dumpResultNumber != dumpNumber) {
+        dumpResult = root->result();
+        dumpResultNumber = dumpNumber;
+    }
+    vec = dumpResult;
 }
 
 Result
 Formula::total() const
 {
-    return root ? root->total() : 0.0;
+    if (!root)
+        return 0.0;
+
+    if (!dumpNumber)
+        return root->total();
+
+    if (dumpTotalNumber != dumpNumber) {
+        dumpTotal = root->total();
+        dumpTotalNumber = dumpNumber;
+    }
+    return dumpTotal;
 }
 
 size_type
@@ -296,6 +327,18 @@ enable()
     _enabled = true;
 }
 
+void
+beginDump()
+{
+    dumpNumber = ++lastDumpNumber;
+}
+
+void
+endDump()
+{
+    dumpNumber = 0;
+}
+
 void
 dump()
 {
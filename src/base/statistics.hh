@@ -2625,6 +2625,16 @@ class Formula : public DataWrapVec<Formula, FormulaInfoProxy>
     bool zero() const;
 
     std::string str() const;
+
+  private:
+    /**
+     * Results memoized during a stat dump, and the number of the dump
+     * they were computed in.
+     */
+    mutable VResult dumpResult;
+    mutable Result dumpTotal = 0.0;
+    mutable uint64_t dumpResultNumber = 0;
+    mutable uint64_t dumpTotalNumber = 0;
 };
 
 class FormulaNode : public Node
@@ -2881,6 +2891,16 @@ sum(Temp val)
 
 /** Dump all statistics data to the registered outputs */
 void dump();
+
+/**
+ * Mark the beginning and the end of a stat dump to the registered
+ * outputs. Formulas are evaluated at most once during a dump, when
+ * they are first visited or used by another formula, since the stats
+ * they are computed from can't change in the meantime.
+ */
+void beginDump();
+void endDump();
+
 void reset();
 void enable();
 bool enabled();
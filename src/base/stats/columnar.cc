@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/columnar.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <ostream>
+#include <sstream>
+
+#include "base/stats/info.hh"
+#include "base/stats/units.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+const char magic[8] = "gem5col";
+const uint32_t byteOrderMark = 0x01020304;
+const uint32_t version = 1;
+
+/** Label of the i-th element of a vector, as used by the text output. */
+std::string
+subLabel(const std::vector<std::string> &subnames, size_t i)
+{
+    if (i < subnames.size() && !subnames[i].empty())
+        return subnames[i];
+    return std::to_string(i);
+}
+
+} // anonymous namespace
+
+Columnar::Columnar(std::ostream &stream, bool changes, bool desc,
+                   bool formulas)
+    : stream(&stream), enableChanges(changes), enableDescriptions(desc),
+      enableFormula(formulas), layoutPos(0), layoutChanged(false),
+      schemaBase(0)
+{
+    put(magic, sizeof(magic));
+    put(byteOrderMark);
+    put(version);
+    this->stream->write(record.data(), record.size());
+    record.clear();
+}
+
+void
+Columnar::begin()
+{
+    assert(path.empty());
+    layoutPos = 0;
+    layoutChanged = false;
+    values.clear();
+}
+
+void
+Columnar::end()
+{
+    // Stats were removed at the end of the layout
+    if (!layoutChanged && layoutPos != layout.size()) {
+        layoutChanged = true;
+        schemaBase = layoutPos;
+        layout.resize(layoutPos);
+    }
+
+    if (layoutChanged)
+        writeSchema();
+    writeDump();
+    stream->flush();
+}
+
+bool
+Columnar::valid() const
+{
+    return stream->good();
+}
+
+void
+Columnar::beginGroup(const char *name)
+{
+    path.emplace_back(name);
+}
+
+void
+Columnar::endGroup()
+{
+    assert(!path.empty());
+    path.pop_back();
+}
+
+bool
+Columnar::noOutput(const Info &info) const
+{
+    // Stats are stored regardless of their prerequisites, so that the
+    // schema does not change from one dump to the next.
+    return !info.flags.isSet(display);
+}
+
+bool
+Columnar::beginStat(const Info &info, size_t num_cols,
+                    const std::vector<double> &shape)
+{
+    if (!layoutChanged) {
+        if (layoutPos < layout.size() && layout[layoutPos].info == &info &&
+            layout[layoutPos].numCols == num_cols &&
+            layout[layoutPos].shape == shape) {
+            ++layoutPos;
+            return false;
+        }
+
+        layoutChanged = true;
+        schemaBase = layoutPos;
+        layout.resize(layoutPos);
+    }
+
+    layout.push_back({&info, num_cols, shape});
+    ++layoutPos;
+    return true;
+}
+
+Columnar::StatSchema &
+Columnar::addSchema(const Info &info, const char *type)
+{
+    std::string name;
+    for (const auto &group : path) {
+        name += group;
+        name += '.';
+    }
+    name += info.name;
+
+    schemas.push_back({std::move(name), type, info.unit->getUnitString(),
+                       enableDescriptions ? info.desc : std::string(), {}});
+    return schemas.back();
+}
+
+size_t
+Columnar::distColumns(const DistData &data)
+{
+    switch (data.type) {
+      case Deviation:
+        return 3;
+      case Hist:
+        return 4 + data.cvec.size();
+      case Dist:
+      default:
+        return 7 + data.cvec.size();
+    }
+}
+
+void
+Columnar::distShape(const DistData &data, std::vector<double> &shape)
+{
+    // Histograms move and widen their buckets as they grow, without
+    // changing their number
+    if (data.type != Deviation) {
+        shape.push_back(data.min);
+        shape.push_back(data.max);
+        shape.push_back(data.bucket_size);
+    }
+}
+
+void
+Columnar::appendDist(const DistData &data)
+{
+    values.push_back(data.samples);
+    values.push_back(data.sum);
+    values.push_back(data.squares);
+
+    if (data.type == Deviation)
+        return;
+
+    if (data.type == Hist) {
+        values.push_back(data.logs);
+    } else {
+        values.push_back(data.underflow);
+        values.push_back(data.overflow);
+        values.push_back(data.min_val);
+        values.push_back(data.max_val);
+    }
+    values.insert(values.end(), data.cvec.begin(), data.cvec.end());
+}
+
+void
+Columnar::distLabels(const DistData &data, const std::string &prefix,
+                     std::vector<std::string> &labels) const
+{
+    labels.push_back(prefix + "samples");
+    labels.push_back(prefix + "sum");
+    labels.push_back(prefix + "squares");
+
+    if (data.type == Deviation)
+        return;
+
+    if (data.type == Hist) {
+        labels.push_back(prefix + "logs");
+    } else {
+        labels.push_back(prefix + "underflows");
+        labels.push_back(prefix + "overflows");
+        labels.push_back(prefix + "min_value");
+        labels.push_back(prefix + "max_value");
+    }
+
+    for (size_t i = 0; i < data.cvec.size(); ++i) {
+        std::stringstream label;
+        label << prefix;
+
+        Counter low = i * data.bucket_size + data.min;
+        Counter high = std::min(low + data.bucket_size - 1.0, data.max);
+        label << low;
+        if (low < high)
+            label << "-" << high;
+
+        labels.push_back(label.str());
+    }
+}
+
+void
+Columnar::visit(const ScalarInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    if (beginStat(info, 1))
+        addSchema(info, "Scalar").labels.emplace_back();
+    values.push_back(info.result());
+}
+
+void
+Columnar::visit(const VectorInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    const VResult &vr = info.result();
+    if (beginStat(info, vr.size())) {
+        auto &labels = addSchema(info, "Vector").labels;
+        for (size_t i = 0; i < vr.size(); ++i)
+            labels.push_back(subLabel(info.subnames, i));
+    }
+    values.insert(values.end(), vr.begin(), vr.end());
+}
+
+void
+Columnar::visit(const DistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    statShape.clear();
+    distShape(info.data, statShape);
+    if (beginStat(info, distColumns(info.data), statShape))
+        distLabels(info.data, "", addSchema(info, "Distribution").labels);
+    appendDist(info.data);
+}
+
+void
+Columnar::visit(const VectorDistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    size_t num_cols = 0;
+    statShape.clear();
+    for (const auto &data : info.data) {
+        num_cols += distColumns(data);
+        distShape(data, statShape);
+    }
+
+    if (beginStat(info, num_cols, statShape)) {
+        auto &labels = addSchema(info, "VectorDistribution").labels;
+        for (size_t i = 0; i < info.data.size(); ++i) {
+            distLabels(info.data[i], subLabel(info.subnames, i) + "::",
+                       labels);
+        }
+    }
+    for (const auto &data : info.data)
+        appendDist(data);
+}
+
+void
+Columnar::visit(const Vector2dInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    if (beginStat(info, info.cvec.size())) {
+        auto &labels = addSchema(info, "Vector2d").labels;
+        for (size_t i = 0; i < info.x; ++i) {
+            for (size_t j = 0; j < info.y; ++j) {
+                labels.push_back(subLabel(info.subnames, i) + "::" +
+                                 subLabel(info.y_subnames, j));
+            }
+        }
+    }
+    values.insert(values.end(), info.cvec.begin(), info.cvec.end());
+}
+
+void
+Columnar::visit(const FormulaInfo &info)
+{
+    if (!enableFormula || noOutput(info))
+        return;
+
+    const VResult &vr = info.result();
+    if (beginStat(info, vr.size())) {
+        auto &schema = addSchema(info, "Formula");
+        for (size_t i = 0; i < vr.size(); ++i)
+            schema.labels.push_back(subLabel(info.subnames, i));
+    }
+    values.insert(values.end(), vr.begin(), vr.end());
+}
+
+void
+Columnar::visit(const SparseHistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    // The keys may change without changing their number
+    statShape.clear();
+    for (const auto &bucket : info.data.cmap)
+        statShape.push_back(bucket.first);
+
+    if (beginStat(info, 1 + info.data.cmap.size(), statShape)) {
+        auto &labels = addSchema(info, "SparseHist").labels;
+        labels.push_back("samples");
+        for (const auto &bucket : info.data.cmap) {
+            std::stringstream label;
+            label << bucket.first;
+            labels.push_back(label.str());
+        }
+    }
+    values.push_back(info.data.samples);
+    for (const auto &bucket : info.data.cmap)
+        values.push_back(bucket.second);
+}
+
+void
+Columnar::writeSchema()
+{
+    assert(schemaBase + schemas.size() == layout.size());
+
+    put(uint32_t(schemaBase));
+    put(uint32_t(schemas.size()));
+    for (const auto &schema : schemas) {
+        put(schema.name);
+        put(std::string(schema.type));
+        put(schema.unit);
+        put(schema.desc);
+        put(uint32_t(schema.labels.size()));
+        for (const auto &label : schema.labels)
+            put(label);
+    }
+    writeRecord(SchemaRecord);
+
+    schemas.clear();
+}
+
+void
+Columnar::writeDump()
+{
+    put(uint64_t(curTick()));
+
+    // The change encoding needs 12 bytes per changed column instead of
+    // 8 bytes per column, so only use it if few enough columns changed.
+    size_t num_changed = values.size();
+    if (enableChanges && !layoutChanged) {
+        assert(lastValues.size() == values.size());
+        num_changed = 0;
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (std::memcmp(&values[i], &lastValues[i], sizeof(double)))
+                ++num_changed;
+        }
+    }
+
+    if (num_changed * 12 + 4 < values.size() * 8) {
+        put(uint32_t(ChangeEncoding));
+        put(uint32_t(num_changed));
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (std::memcmp(&values[i], &lastValues[i], sizeof(double))) {
+                put(uint32_t(i));
+                put(values[i]);
+            }
+        }
+    } else {
+        put(uint32_t(FullEncoding));
+        put(values.data(), values.size() * sizeof(double));
+    }
+    writeRecord(DumpRecord);
+
+    if (enableChanges)
+        lastValues.swap(values);
+}
+
+void
+Columnar::writeRecord(RecordKind kind)
+{
+    const uint32_t kind_value = kind;
+    const uint64_t length = record.size();
+    stream->write(reinterpret_cast<const char *>(&kind_value),
+                  sizeof(kind_value));
+    stream->write(reinterpret_cast<const char *>(&length), sizeof(length));
+    stream->write(record.data(), record.size());
+    record.clear();
+}
+
+void
+Columnar::put(const void *data, size_t size)
+{
+    record.append(static_cast<const char *>(data), size);
+}
+
+void
+Columnar::put(const std::string &str)
+{
+    put(uint32_t(str.size()));
+    put(str.data(), str.size());
+}
+
+std::unique_ptr<Output>
+initColumnar(const std::string &filename, bool changes, bool desc,
+             bool formulas)
+{
+    return std::unique_ptr<Output>(
+        new Columnar(*simout.create(filename, true)->stream(), changes, desc,
+                     formulas));
+}
+
+} // namespace statistics
+} // namespace gem5
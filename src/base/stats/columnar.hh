@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_COLUMNAR_HH__
+#define __BASE_STATS_COLUMNAR_HH__
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/output.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+/**
+ * Binary, columnar stat output.
+ *
+ * Every stat is flattened into one or more double-precision columns
+ * (e.g., one per vector element or histogram bucket). The names, types
+ * and column labels of the stats are written once in a schema record,
+ * and each dump only appends the vector of column values. When change
+ * encoding is enabled, a dump only stores the columns whose value
+ * differs from the previous dump if that is smaller. A new schema
+ * record is only written if the set of stats or their shape changes
+ * (e.g., a sparse histogram gets a new key, or the buckets of a
+ * histogram grow to cover a larger range), in which case the next
+ * dump is stored in full. A schema record only describes the stats
+ * from the first one that changed on, and replaces the schema of those
+ * and all following stats.
+ *
+ * Derived values (vector totals, distribution means, etc.) are not
+ * stored, but can be computed by the reader. Distributions store their
+ * raw samples, sum, squares and buckets instead.
+ *
+ * All values are stored in the byte order of the host, which is given
+ * by the byte order mark in the file header:
+ *
+ * @verbatim
+ file   := magic[8] = "gem5col\0", bom:u32 = 0x01020304, version:u32,
+           record*
+ record := kind:u32, length:u64, payload[length]
+ schema := (kind 1) first:u32, num_stats:u32, stat[num_stats]
+ stat   := name:str, type:str, unit:str, desc:str, num_cols:u32,
+           label:str[num_cols]
+ dump   := (kind 2) tick:u64, encoding:u32, values
+ values := f64[total columns]                    (encoding 0, full)
+         | count:u32, (column:u32, f64)[count]   (encoding 1, changes)
+ str    := length:u32, bytes[length]
+ @endverbatim
+ *
+ * The single column of a scalar stat has an empty label.
+ */
+class Columnar : public Output
+{
+  public:
+    /**
+     * @param stream Output stream, not owned
+     * @param changes Enable the change encoding of dumps
+     * @param desc Store stat descriptions
+     * @param formulas Store formula stats
+     */
+    Columnar(std::ostream &stream, bool changes, bool desc, bool formulas);
+
+    Columnar() = delete;
+    Columnar(const Columnar &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    /** Record kinds */
+    enum RecordKind : uint32_t
+    {
+        SchemaRecord = 1,
+        DumpRecord = 2,
+    };
+
+    /** Dump encodings */
+    enum Encoding : uint32_t
+    {
+        FullEncoding = 0,
+        ChangeEncoding = 1,
+    };
+
+    /** Schema of a stat, only kept until it is written */
+    struct StatSchema
+    {
+        std::string name;
+        const char *type;
+        std::string unit;
+        std::string desc;
+        std::vector<std::string> labels;
+    };
+
+    /** Stat layout of the last dump, to detect schema changes cheaply */
+    struct StatLayout
+    {
+        const Info *info;
+        size_t numCols;
+        //! Values the column labels are derived from, e.g., the range
+        //! and bucket size of histograms
+        std::vector<double> shape;
+    };
+
+    bool noOutput(const Info &info) const;
+
+    /**
+     * Start appending the columns of a stat.
+     *
+     * @param shape Values the column labels are derived from, besides
+     * the number of columns
+     * @return True if the stat schema has to be built, because it
+     * differs from the last dump.
+     */
+    bool beginStat(const Info &info, size_t num_cols,
+                   const std::vector<double> &shape = {});
+
+    /** Add the schema of the current stat. */
+    StatSchema &addSchema(const Info &info, const char *type);
+
+    /** Append the columns of a distribution. */
+    void appendDist(const DistData &data);
+
+    /** Add the column labels of a distribution. */
+    void distLabels(const DistData &data, const std::string &prefix,
+                    std::vector<std::string> &labels) const;
+
+    /** Number of columns of a distribution. */
+    static size_t distColumns(const DistData &data);
+
+    /** Append the values the labels of a distribution depend on. */
+    static void distShape(const DistData &data, std::vector<double> &shape);
+
+    void writeSchema();
+    void writeDump();
+    void writeRecord(RecordKind kind);
+
+    void put(const void *data, size_t size);
+    void put(uint32_t value) { put(&value, sizeof(value)); }
+    void put(uint64_t value) { put(&value, sizeof(value)); }
+    void put(double value) { put(&value, sizeof(value)); }
+    void put(const std::string &str);
+
+  protected:
+    std::ostream *stream;
+
+    const bool enableChanges;
+    const bool enableDescriptions;
+    const bool enableFormula;
+
+    //! Names of the enclosing groups
+    std::vector<std::string> path;
+
+    //! Stat layout of the last dump and the position in it
+    std::vector<StatLayout> layout;
+    size_t layoutPos;
+    //! The layout of this dump differs from the last one
+    bool layoutChanged;
+    //! Shape of the current stat, kept to reuse its storage
+    std::vector<double> statShape;
+
+    //! Schemas of the stats from the first changed one on
+    std::vector<StatSchema> schemas;
+    //! Index of the first stat in schemas
+    size_t schemaBase;
+
+    //! Column values of this dump and the last one
+    std::vector<double> values;
+    std::vector<double> lastValues;
+
+    //! Payload of the record being written
+    std::string record;
+};
+
+/**
+ * Create a columnar stat output writing to a file in the output
+ * directory.
+ */
+std::unique_ptr<Output> initColumnar(const std::string &filename,
+                                     bool changes = true, bool desc = true,
+                                     bool formulas = true);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_COLUMNAR_HH__
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/stats/columnar.hh"
+#include "base/stats/info.hh"
+#include "base/stats/storage.hh"
+
+using namespace gem5;
+
+// Instantiate the fake class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+class TestDistInfo : public statistics::DistInfo
+{
+  public:
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+class TestSparseHistInfo : public statistics::SparseHistInfo
+{
+  public:
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+/** A record of a columnar stat file, only keeping its kind and payload. */
+struct Record
+{
+    uint32_t kind;
+    std::string payload;
+};
+
+/** Split a columnar stat file in its records. */
+std::vector<Record>
+readRecords(const std::string &file)
+{
+    std::vector<Record> records;
+    size_t pos = 16;
+    while (pos + 12 <= file.size()) {
+        uint32_t kind;
+        uint64_t length;
+        std::memcpy(&kind, file.data() + pos, sizeof(kind));
+        std::memcpy(&length, file.data() + pos + 4, sizeof(length));
+        records.push_back({kind, file.substr(pos + 12, length)});
+        pos += 12 + length;
+    }
+    return records;
+}
+
+/** The column labels of the first stat of a schema record. */
+std::vector<std::string>
+schemaLabels(const std::string &payload)
+{
+    size_t pos = 8;
+    auto read_u32 = [&]() {
+        uint32_t value;
+        std::memcpy(&value, payload.data() + pos, sizeof(value));
+        pos += sizeof(value);
+        return value;
+    };
+    auto read_str = [&]() {
+        uint32_t length = read_u32();
+        std::string str = payload.substr(pos, length);
+        pos += length;
+        return str;
+    };
+
+    // Skip the name, type, unit and description
+    for (int i = 0; i < 4; ++i)
+        read_str();
+
+    std::vector<std::string> labels(read_u32());
+    for (auto &label : labels)
+        label = read_str();
+    return labels;
+}
+
+/**
+ * Test that a new schema is written each time the buckets of a histogram
+ * grow, even if their number stays the same.
+ */
+TEST(StatsColumnarTest, GrowingHistogram)
+{
+    TestDistInfo info;
+    info.setName("hist", false);
+    info.flags = statistics::display;
+
+    statistics::HistStor::Params params(4);
+    statistics::HistStor stor(&params);
+
+    std::stringstream stream;
+    statistics::Columnar columnar(stream, true, false, false);
+    auto dump = [&]() {
+        stor.prepare(&params, info.data);
+        columnar.begin();
+        columnar.visit(info);
+        columnar.end();
+    };
+
+    // Buckets [0,1[ to [3,4[
+    stor.sample(1, 1);
+    dump();
+    stor.sample(2, 1);
+    dump();
+    // Buckets [0,2[ to [6,8[
+    stor.sample(6, 1);
+    dump();
+    // Buckets [0,4[ to [12,16[
+    stor.sample(12, 1);
+    dump();
+    dump();
+
+    auto records = readRecords(stream.str());
+    ASSERT_EQ(records.size(), 8);
+    const uint32_t kinds[] = {1, 2, 2, 1, 2, 1, 2, 2};
+    for (int i = 0; i < 8; ++i)
+        ASSERT_EQ(records[i].kind, kinds[i]);
+
+    const std::vector<std::string> labels0 = {
+        "samples", "sum", "squares", "logs", "0", "1", "2", "3"};
+    const std::vector<std::string> labels1 = {
+        "samples", "sum", "squares", "logs", "0-1", "2-3", "4-5", "6-7"};
+    const std::vector<std::string> labels2 = {
+        "samples", "sum", "squares", "logs", "0-3", "4-7", "8-11",
+        "12-15"};
+    ASSERT_EQ(schemaLabels(records[0].payload), labels0);
+    ASSERT_EQ(schemaLabels(records[3].payload), labels1);
+    ASSERT_EQ(schemaLabels(records[5].payload), labels2);
+}
+
+/**
+ * Test that a new schema is written when the keys of a sparse histogram
+ * change, even if their number stays the same.
+ */
+TEST(StatsColumnarTest, SparseHistogramKeys)
+{
+    TestSparseHistInfo info;
+    info.setName("sparse", false);
+    info.flags = statistics::display;
+
+    std::stringstream stream;
+    statistics::Columnar columnar(stream, true, false, false);
+    auto dump = [&]() {
+        columnar.begin();
+        columnar.visit(info);
+        columnar.end();
+    };
+
+    info.data.samples = 2;
+    info.data.cmap[1] = 1;
+    info.data.cmap[2] = 1;
+    dump();
+    info.data.cmap[1] = 2;
+    dump();
+    info.data.cmap.clear();
+    info.data.cmap[3] = 1;
+    info.data.cmap[4] = 1;
+    dump();
+
+    auto records = readRecords(stream.str());
+    ASSERT_EQ(records.size(), 5);
+    const uint32_t kinds[] = {1, 2, 2, 1, 2};
+    for (int i = 0; i < 5; ++i)
+        ASSERT_EQ(records[i].kind, kinds[i]);
+
+    const std::vector<std::string> labels = {"samples", "3", "4"};
+    ASSERT_EQ(schemaLabels(records[3].payload), labels);
+}
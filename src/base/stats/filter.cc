@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/filter.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+void
+StatFilter::addGlob(const std::string &pattern)
+{
+    std::string regex;
+    std::string prefix;
+    bool literal = true;
+
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        const char c = pattern[i];
+        if (c == '*') {
+            regex += ".*";
+            literal = false;
+        } else if (c == '?') {
+            regex += '.';
+            literal = false;
+        } else if (c == '[' && pattern.find(']', i + 2) != std::string::npos) {
+            const size_t end = pattern.find(']', i + 2);
+            regex += '[';
+            size_t j = i + 1;
+            if (pattern[j] == '!') {
+                regex += '^';
+                ++j;
+            }
+            for (; j < end; ++j) {
+                if (pattern[j] == '\\' || pattern[j] == '[')
+                    regex += '\\';
+                regex += pattern[j];
+            }
+            regex += ']';
+            i = end;
+            literal = false;
+        } else {
+            if (std::strchr("\\^$.|+(){}[]", c))
+                regex += '\\';
+            regex += c;
+            if (literal)
+                prefix += c;
+        }
+    }
+
+    add(regex, std::move(prefix));
+}
+
+void
+StatFilter::addRegex(const std::string &pattern)
+{
+    // Find the literal prefix of the expression, if there is no
+    // alternative at all.
+    std::string prefix;
+    if (pattern.find('|') == std::string::npos) {
+        size_t i = !pattern.empty() && pattern[0] == '^' ? 1 : 0;
+        for (; i < pattern.size(); ++i) {
+            char c = pattern[i];
+            if (c == '\\' && i + 1 < pattern.size() &&
+                std::strchr("\\^$.|?*+()[]{}", pattern[i + 1])) {
+                c = pattern[++i];
+            } else if (std::strchr("\\^$.|?*+()[]{}", c)) {
+                // A quantifier makes the last character optional
+                if (!prefix.empty() && std::strchr("?*{", c))
+                    prefix.pop_back();
+                break;
+            }
+            prefix += c;
+        }
+    }
+
+    add(pattern, std::move(prefix));
+}
+
+void
+StatFilter::add(const std::string &regex, std::string prefix)
+{
+    try {
+        patterns.push_back({std::regex(regex, std::regex::optimize),
+                            std::move(prefix)});
+    } catch (const std::regex_error &e) {
+        fatal("Invalid stat selection pattern '%s': %s\n", regex, e.what());
+    }
+}
+
+bool
+StatFilter::match(const std::string &name) const
+{
+    if (patterns.empty())
+        return true;
+
+    for (const auto &pattern : patterns) {
+        if (name.compare(0, pattern.prefix.size(), pattern.prefix) == 0 &&
+            std::regex_match(name, pattern.regex)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+StatFilter::mayMatchPrefix(const std::string &prefix) const
+{
+    if (patterns.empty())
+        return true;
+
+    for (const auto &pattern : patterns) {
+        const size_t len = std::min(prefix.size(), pattern.prefix.size());
+        if (prefix.compare(0, len, pattern.prefix, 0, len) == 0)
+            return true;
+    }
+    return false;
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_FILTER_HH__
+#define __BASE_STATS_FILTER_HH__
+
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+/**
+ * A set of glob or regular expression patterns selecting stats by their
+ * full, dot-separated name (e.g., "system.cpu.ipc"). A stat is selected
+ * if any pattern matches its whole name. An empty filter selects all
+ * stats.
+ *
+ * In globs, '*' matches any sequence of characters, dots included, '?'
+ * matches any single character and '[...]' matches any of the enclosed
+ * characters ('[!...]' any other character). Regular expressions use
+ * the ECMAScript syntax.
+ *
+ * The filter is only applied when the stats are enabled or the patterns
+ * change, after which groups without any selected stat are skipped
+ * entirely when preparing and dumping stats. Filters can tell cheaply
+ * whether a group may contain selected stats from the literal prefix
+ * of their patterns.
+ */
+class StatFilter
+{
+  public:
+    void addGlob(const std::string &pattern);
+    void addRegex(const std::string &pattern);
+
+    bool empty() const { return patterns.empty(); }
+
+    /** Check if a stat is selected by its full name. */
+    bool match(const std::string &name) const;
+
+    /**
+     * Check if any stat whose full name starts with the given prefix
+     * may be selected.
+     */
+    bool mayMatchPrefix(const std::string &prefix) const;
+
+  private:
+    struct Pattern
+    {
+        std::regex regex;
+        //! Literal prefix of all the names matched by the pattern
+        std::string prefix;
+    };
+
+    void add(const std::string &regex, std::string prefix);
+
+    std::vector<Pattern> patterns;
+};
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_FILTER_HH__
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "base/stats/filter.hh"
+
+using namespace gem5;
+
+/** Test that an empty filter selects all stats. */
+TEST(StatsFilterTest, Empty)
+{
+    statistics::StatFilter filter;
+    ASSERT_TRUE(filter.empty());
+    ASSERT_TRUE(filter.match("system.cpu.ipc"));
+    ASSERT_TRUE(filter.mayMatchPrefix("system.cpu."));
+}
+
+/** Test the glob wildcards. */
+TEST(StatsFilterTest, Glob)
+{
+    statistics::StatFilter filter;
+    filter.addGlob("system.cpu*.ipc");
+    ASSERT_FALSE(filter.empty());
+    ASSERT_TRUE(filter.match("system.cpu.ipc"));
+    ASSERT_TRUE(filter.match("system.cpu12.ipc"));
+    ASSERT_TRUE(filter.match("system.cpu.core.ipc"));
+    ASSERT_FALSE(filter.match("system.cpu.ipcs"));
+    ASSERT_FALSE(filter.match("system.cpu0.cpi"));
+    ASSERT_FALSE(filter.match("systemXcpu.ipc"));
+
+    statistics::StatFilter filter2;
+    filter2.addGlob("system.l?.[!r]*");
+    ASSERT_TRUE(filter2.match("system.l2.misses"));
+    ASSERT_FALSE(filter2.match("system.l2.replacements"));
+    ASSERT_FALSE(filter2.match("system.l22.misses"));
+}
+
+/** Test that only full names match regular expressions. */
+TEST(StatsFilterTest, Regex)
+{
+    statistics::StatFilter filter;
+    filter.addRegex("system\\.cpu[0-9]+\\.(ipc|cpi)");
+    ASSERT_TRUE(filter.match("system.cpu0.ipc"));
+    ASSERT_TRUE(filter.match("system.cpu15.cpi"));
+    ASSERT_FALSE(filter.match("system.cpu.ipc"));
+    ASSERT_FALSE(filter.match("system.cpu0.ipc2"));
+}
+
+/** Test that any pattern may select a stat. */
+TEST(StatsFilterTest, MultiplePatterns)
+{
+    statistics::StatFilter filter;
+    filter.addGlob("simSeconds");
+    filter.addRegex("system\\.mem_ctrl\\..*");
+    ASSERT_TRUE(filter.match("simSeconds"));
+    ASSERT_TRUE(filter.match("system.mem_ctrl.readReqs"));
+    ASSERT_FALSE(filter.match("simTicks"));
+}
+
+/** Test the pruning of groups based on the literal prefix. */
+TEST(StatsFilterTest, MayMatchPrefix)
+{
+    statistics::StatFilter filter;
+    filter.addGlob("system.cpu*.ipc");
+    ASSERT_TRUE(filter.mayMatchPrefix(""));
+    ASSERT_TRUE(filter.mayMatchPrefix("system."));
+    ASSERT_TRUE(filter.mayMatchPrefix("system.cpu0."));
+    ASSERT_TRUE(filter.mayMatchPrefix("system.cpu0.fetch."));
+    ASSERT_FALSE(filter.mayMatchPrefix("system.l2."));
+
+    statistics::StatFilter filter2;
+    filter2.addRegex("^system\\.l2c?\\.misses");
+    ASSERT_TRUE(filter2.mayMatchPrefix("system.l2."));
+    ASSERT_TRUE(filter2.mayMatchPrefix("system.l2c."));
+    ASSERT_FALSE(filter2.mayMatchPrefix("system.cpu."));
+
+    // Alternatives may match anything
+    statistics::StatFilter filter3;
+    filter3.addRegex("system\\.l2\\.misses|simSeconds");
+    ASSERT_TRUE(filter3.mayMatchPrefix("system.cpu."));
+}
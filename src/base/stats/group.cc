@@ -40,7 +40,9 @@
 #include "base/compiler.hh"
 #include "base/logging.hh"
 #include "base/named.hh"
+#include "base/stats/filter.hh"
 #include "base/stats/info.hh"
+#include "base/stats/output.hh"
 #include "base/trace.hh"
 #include "debug/Stats.hh"
 
@@ -51,7 +53,7 @@ namespace statistics
 {
 
 Group::Group(Group *parent, const char *name)
-    : mergedParent(nullptr)
+    : statsSelected(true), mergedParent(nullptr)
 {
     if (parent && name) {
         parent->addStatGroup(name, this);
@@ -177,6 +179,55 @@ Group::mergeStatGroup(Group *block)
     block->mergedParent = this;
 }
 
+bool
+Group::selectStats(const StatFilter &filter, const std::string &path)
+{
+    const std::string prefix = path.empty() ? path : path + ".";
+    const bool may_match = filter.mayMatchPrefix(prefix);
+
+    statsSelected = false;
+    for (auto &s : stats) {
+        s->selected = may_match && filter.match(prefix + s->name);
+        statsSelected |= s->selected;
+    }
+
+    for (auto &g : statGroups)
+        statsSelected |= g.second->selectStats(filter, prefix + g.first);
+
+    return statsSelected;
+}
+
+void
+Group::prepareStats()
+{
+    for (auto &s : stats) {
+        if (s->selected)
+            s->prepare();
+    }
+
+    for (auto &g : statGroups) {
+        if (g.second->statsSelected)
+            g.second->prepareStats();
+    }
+}
+
+void
+Group::visitStats(Output &visitor)
+{
+    for (auto &s : stats) {
+        if (s->selected)
+            s->visit(visitor);
+    }
+
+    for (auto &g : statGroups) {
+        if (g.second->statsSelected) {
+            visitor.beginGroup(g.first.c_str());
+            g.second->visitStats(visitor);
+            visitor.endGroup();
+        }
+    }
+}
+
 const std::map<std::string, Group *> &
 Group::getStatGroups() const
 {
@@ -78,6 +78,8 @@ namespace statistics
 {
 
 class Info;
+class StatFilter;
+struct Output;
 
 /**
  * Statistics container.
@@ -211,7 +213,33 @@ class Group
      */
     void mergeStatGroup(Group *block);
 
+    /**
+     * Select the stats of this group and its sub-groups to prepare
+     * and dump.
+     *
+     * @param filter Filter to apply to the full stat names
+     * @param path Full name of this group, empty for the root group
+     * @return True if any stat of this group or its sub-groups is
+     * selected.
+     */
+    bool selectStats(const StatFilter &filter, const std::string &path);
+
+    /**
+     * Prepare the selected stats of this group and its sub-groups for
+     * dumping.
+     */
+    void prepareStats();
+
+    /**
+     * Visit the selected stats of this group and its sub-groups.
+     * Sub-groups without any selected stat are skipped.
+     */
+    void visitStats(Output &visitor);
+
   private:
+    /** Does this group or any of its sub-groups have selected stats? */
+    bool statsSelected;
+
     /** Parent pointer if merged into parent */
     Group *mergedParent;
 
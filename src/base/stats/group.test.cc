@@ -29,6 +29,7 @@
 #include <gtest/gtest-spi.h>
 #include <gtest/gtest.h>
 
+#include "base/stats/filter.hh"
 #include "base/stats/group.hh"
 #include "base/stats/info.hh"
 #include "base/stats/output.hh"
@@ -657,3 +658,42 @@ TEST(StatsGroupTest, ResolveStatMergedSubGroup)
     ASSERT_NE(info_found, nullptr);
     ASSERT_EQ(info_found->name, "InfoResolveStatMergedSubGroup");
 }
+
+/** Test that stats are selected based on their full name. */
+TEST(StatsGroupTest, SelectStats)
+{
+    statistics::Group root(nullptr);
+    statistics::Group node1(nullptr);
+    statistics::Group node2(nullptr);
+
+    DummyInfo info1;
+    info1.setName("info1");
+    root.addStat(&info1);
+    DummyInfo info2;
+    info2.setName("info2");
+    node1.addStat(&info2);
+    DummyInfo info3;
+    info3.setName("info3");
+    node2.addStat(&info3);
+
+    root.addStatGroup("Node1", &node1);
+    root.addStatGroup("Node2", &node2);
+
+    statistics::StatFilter filter;
+    filter.addGlob("Node1.*");
+    ASSERT_TRUE(root.selectStats(filter, ""));
+    ASSERT_FALSE(info1.selected);
+    ASSERT_TRUE(info2.selected);
+    ASSERT_FALSE(info3.selected);
+
+    filter.addGlob("info1");
+    ASSERT_FALSE(node2.selectStats(filter, "Node2"));
+    ASSERT_TRUE(root.selectStats(filter, ""));
+    ASSERT_TRUE(info1.selected);
+    ASSERT_TRUE(info2.selected);
+    ASSERT_FALSE(info3.selected);
+
+    // An empty filter selects all stats
+    ASSERT_TRUE(root.selectStats(statistics::StatFilter(), ""));
+    ASSERT_TRUE(info3.selected);
+}
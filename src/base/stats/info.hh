@@ -99,6 +99,8 @@ class Info
      */
     static int id_count;
     int id;
+    /** Is the stat selected to be prepared and dumped? */
+    bool selected = true;
 
   private:
     std::unique_ptr<const StorageParams> storageParams;
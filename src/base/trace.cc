@@ -32,6 +32,7 @@
 #include "base/trace.hh"
 
 #include <cctype>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -103,6 +104,119 @@ disable()
 
 ObjectMatch ignore;
 
+namespace
+{
+
+/** Read a recorded argument of type T and pass it on to ccprintf. */
+template <typename T>
+bool
+replayArg(cp::Print &print, const char *&data, const char *end)
+{
+    T value;
+    if (end - data < (ptrdiff_t)sizeof(value))
+        return false;
+    std::memcpy(&value, data, sizeof(value));
+    data += sizeof(value);
+    print.addArg(value);
+    return true;
+}
+
+bool
+replayString(cp::Print &print, const char *&data, const char *end)
+{
+    uint32_t len;
+    if (end - data < (ptrdiff_t)sizeof(len))
+        return false;
+    std::memcpy(&len, data, sizeof(len));
+    data += sizeof(len);
+    if (end - data < (ptrdiff_t)len)
+        return false;
+    print.addArg(std::string(data, len));
+    data += len;
+    return true;
+}
+
+} // anonymous namespace
+
+void
+TraceArgs::format(std::ostream &stream, const char *fmt, const char *data,
+                  size_t size)
+{
+    cp::Print print(stream, fmt);
+
+    const char *end = data + size;
+    bool valid = true;
+    while (valid && data < end) {
+        switch (Type(*data++)) {
+          case Bool:
+            valid = replayArg<bool>(print, data, end);
+            break;
+          case Char:
+            valid = replayArg<char>(print, data, end);
+            break;
+          case SignedChar:
+            valid = replayArg<signed char>(print, data, end);
+            break;
+          case UnsignedChar:
+            valid = replayArg<unsigned char>(print, data, end);
+            break;
+          case Int16:
+            valid = replayArg<int16_t>(print, data, end);
+            break;
+          case UInt16:
+            valid = replayArg<uint16_t>(print, data, end);
+            break;
+          case Int32:
+            valid = replayArg<int32_t>(print, data, end);
+            break;
+          case UInt32:
+            valid = replayArg<uint32_t>(print, data, end);
+            break;
+          case Int64:
+            valid = replayArg<int64_t>(print, data, end);
+            break;
+          case UInt64:
+            valid = replayArg<uint64_t>(print, data, end);
+            break;
+          case Float:
+            valid = replayArg<float>(print, data, end);
+            break;
+          case Double:
+            valid = replayArg<double>(print, data, end);
+            break;
+          case String:
+            valid = replayString(print, data, end);
+            break;
+          case Pointer:
+            valid = replayArg<const void *>(print, data, end);
+            break;
+          default:
+            valid = false;
+            break;
+        }
+    }
+    print.endArgs();
+
+    if (!valid)
+        stream << "<bad recorded arg>";
+}
+
+TraceArgs &
+TraceArgs::scratch()
+{
+    thread_local TraceArgs args;
+    return args;
+}
+
+void
+Logger::logArgs(Tick when, const std::string &name, const std::string &flag,
+        const char *fmt, const TraceArgs &args)
+{
+    std::ostringstream line;
+    TraceArgs::format(line, fmt, args.data(), args.size());
+    logMessage(when, name, flag, line.str());
+}
+
 
 void
 Logger::dump(Tick when, const std::string &name,
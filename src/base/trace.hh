@@ -41,6 +41,7 @@
 #include "base/debug.hh"
 #include "base/logging.hh"
 #include "base/match.hh"
+#include "base/trace_args.hh"
 #include "base/types.hh"
 #include "sim/cur_tick.hh"
 
@@ -79,6 +80,17 @@ class Logger
         return true;
     }
 
+    /**
+     * Set by loggers which record the raw arguments of messages through
+     * logArgs() instead of formatting them when they are logged.
+     */
+    bool recordArgs = false;
+
+    /** Log a message from its format string and recorded arguments. */
+    virtual void logArgs(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            const TraceArgs &args);
+
   public:
     /** Log a single message */
     template <typename ...Args>
@@ -96,6 +108,15 @@ class Logger
     {
         if (!isEnabled(name))
             return;
+        if constexpr (TraceArgs::recordable<Args...>()) {
+            if (recordArgs) {
+                TraceArgs &raw = TraceArgs::scratch();
+                raw.clear();
+                raw.add(args...);
+                logArgs(when, name, flag, fmt, raw);
+                return;
+            }
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
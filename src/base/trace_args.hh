@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_TRACE_ARGS_HH__
+#define __BASE_TRACE_ARGS_HH__
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace gem5
+{
+
+namespace trace
+{
+
+/**
+ * The raw arguments of a debug message, as recorded by loggers which
+ * format messages after the fact rather than when they are logged.
+ * Each argument is stored as a type tag followed by its value, and
+ * format() passes the arguments back to ccprintf with their original
+ * type, so that the message is formatted exactly as it would have
+ * been in the first place.
+ *
+ * Only arguments of fundamental types, strings and pointers to objects
+ * can be recorded. Messages with any other argument, e.g., a class or
+ * an enumeration with its own operator<<, have to be formatted when
+ * they are logged.
+ */
+class TraceArgs
+{
+  public:
+    enum Type : uint8_t
+    {
+        Invalid,
+        Bool,
+        Char,
+        SignedChar,
+        UnsignedChar,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Float,
+        Double,
+        String,
+        Pointer,
+    };
+
+    /** The type tag used to record arguments of type T. */
+    template <typename T>
+    static constexpr Type
+    typeOf()
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            return Bool;
+        } else if constexpr (std::is_same_v<T, char>) {
+            return Char;
+        } else if constexpr (std::is_same_v<T, signed char>) {
+            return SignedChar;
+        } else if constexpr (std::is_same_v<T, unsigned char>) {
+            return UnsignedChar;
+        } else if constexpr (std::is_same_v<T, short> ||
+                             std::is_same_v<T, int> ||
+                             std::is_same_v<T, long> ||
+                             std::is_same_v<T, long long>) {
+            return sizeof(T) == 2 ? Int16 : sizeof(T) == 4 ? Int32 : Int64;
+        } else if constexpr (std::is_same_v<T, unsigned short> ||
+                             std::is_same_v<T, unsigned int> ||
+                             std::is_same_v<T, unsigned long> ||
+                             std::is_same_v<T, unsigned long long>) {
+            return sizeof(T) == 2 ? UInt16 : sizeof(T) == 4 ? UInt32 : UInt64;
+        } else if constexpr (std::is_same_v<T, float>) {
+            return Float;
+        } else if constexpr (std::is_same_v<T, double>) {
+            return Double;
+        } else if constexpr (std::is_same_v<T, std::string> ||
+                             std::is_same_v<T, const char *> ||
+                             std::is_same_v<T, char *>) {
+            return String;
+        } else if constexpr (std::is_pointer_v<T>) {
+            // Streams print pointers to other characters as strings,
+            // and pointers to functions or volatile data as booleans.
+            using Pointee = std::remove_cv_t<std::remove_pointer_t<T>>;
+            if constexpr ((std::is_object_v<Pointee> ||
+                           std::is_void_v<Pointee>) &&
+                          !std::is_volatile_v<std::remove_pointer_t<T>> &&
+                          !std::is_same_v<Pointee, signed char> &&
+                          !std::is_same_v<Pointee, unsigned char>) {
+                return Pointer;
+            } else {
+                return Invalid;
+            }
+        } else {
+            return Invalid;
+        }
+    }
+
+    /** Check if messages with the given arguments can be recorded. */
+    template <typename ...Args>
+    static constexpr bool
+    recordable()
+    {
+        return ((typeOf<std::decay_t<const Args &>>() != Invalid) && ...);
+    }
+
+    void clear() { buffer.clear(); }
+
+    const char *data() const { return buffer.data(); }
+    size_t size() const { return buffer.size(); }
+
+    template <typename ...Args>
+    void
+    add(const Args &...args)
+    {
+        (addArg<std::decay_t<const Args &>>(args), ...);
+    }
+
+    /**
+     * Format a message from its format string and recorded arguments,
+     * as ccprintf would.
+     */
+    static void format(std::ostream &stream, const char *fmt,
+                       const char *data, size_t size);
+
+    /**
+     * Get a buffer owned by the calling thread, to record the arguments
+     * of a message without allocating memory.
+     */
+    static TraceArgs &scratch();
+
+  private:
+    template <typename T>
+    void
+    addArg(const T &arg)
+    {
+        constexpr Type type = typeOf<T>();
+        static_assert(type != Invalid, "Argument can't be recorded");
+
+        buffer.push_back(char(type));
+        if constexpr (type == String) {
+            const char *str;
+            uint32_t len;
+            if constexpr (std::is_same_v<T, std::string>) {
+                str = arg.data();
+                len = arg.size();
+            } else if (arg) {
+                str = arg;
+                len = std::strlen(arg);
+            } else {
+                buffer.back() = char(Pointer);
+                put(static_cast<const void *>(nullptr));
+                return;
+            }
+            put(len);
+            buffer.append(str, len);
+        } else if constexpr (type == Pointer) {
+            put(static_cast<const void *>(arg));
+        } else {
+            put(arg);
+        }
+    }
+
+    template <typename T>
+    void
+    put(const T &value)
+    {
+        buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    std::string buffer;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __BASE_TRACE_ARGS_HH__
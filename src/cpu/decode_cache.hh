@@ -29,10 +29,13 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
+#include <cstddef>
+#include <memory_resource>
 #include <unordered_map>
 
 #include "base/bitfield.hh"
 #include "base/compiler.hh"
+#include "base/types.hh"
 #include "cpu/static_inst_fwd.hh"
 
 namespace gem5
@@ -42,8 +45,42 @@ namespace decode_cache
 {
 
 /// Hash for decoded instructions.
+///
+/// Decoded instructions are never removed, so the nodes of the hash
+/// map are carved out of an arena, which keeps them close together and
+/// saves a heap allocation per instruction. The buckets are reserved
+/// up front so that the map does not need to rehash while warming up.
 template <typename EMI>
-using InstMap = std::unordered_map<EMI, StaticInstPtr>;
+class InstMap
+{
+  private:
+    static constexpr size_t DefaultCapacity = 1024;
+
+    // The arena must outlive the map, so it is declared first.
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::unordered_map<EMI, StaticInstPtr> map;
+
+  public:
+    typedef typename std::pmr::unordered_map<EMI, StaticInstPtr>::iterator
+        iterator;
+
+    explicit InstMap(size_t capacity=DefaultCapacity) :
+        // Leave room for the bucket array and the first nodes.
+        arena(capacity * (sizeof(void *) + sizeof(EMI) +
+                          sizeof(StaticInstPtr))),
+        map(&arena)
+    {
+        map.reserve(capacity);
+    }
+
+    InstMap(const InstMap &) = delete;
+    InstMap &operator=(const InstMap &) = delete;
+
+    iterator find(const EMI &mach_inst) { return map.find(mach_inst); }
+    iterator end() { return map.end(); }
+    StaticInstPtr &operator[](const EMI &mach_inst) { return map[mach_inst]; }
+    size_t size() const { return map.size(); }
+};
 
 /// A sparse map from an Addr to a Value, stored in page chunks.
 template<class Value, Addr CacheChunkShift = 12>
@@ -71,62 +108,49 @@ class AddrMap
     };
     // A map of cache chunks which allows a sparse mapping.
     typedef typename std::unordered_map<Addr, CacheChunk *> ChunkMap;
-    typedef typename ChunkMap::iterator ChunkIt;
-    // Mini cache of recent lookups.
-    ChunkIt recent[2];
     ChunkMap chunkMap;
 
-    /// Update the mini cache of recent lookups.
-    /// @param recentest The most recent result;
-    void
-    update(ChunkIt recentest)
+    // Direct-mapped table of recently used chunks, indexed by the low
+    // bits of the chunk number, which is checked before the hash map.
+    static constexpr size_t FrontTableSize = 16;
+    struct FrontEntry
     {
-        recent[1] = recent[0];
-        recent[0] = recentest;
+        Addr chunkAddr = 0;
+        CacheChunk *chunk = nullptr;
+    };
+    FrontEntry frontTable[FrontTableSize];
+
+    static constexpr size_t
+    frontIndex(Addr chunk_addr)
+    {
+        return (chunk_addr >> CacheChunkShift) & (FrontTableSize - 1);
     }
 
     /// Attempt to find the CacheChunk which goes with a particular
-    /// address. First check the small cache of recent results, then
-    /// actually look in the hash map.
+    /// address. First check the front table, then actually look in
+    /// the hash map.
     /// @param addr The address to look up.
     CacheChunk *
     getChunk(Addr addr)
     {
         Addr chunk_addr = chunkStart(addr);
 
-        // Check against recent lookups.
-        if (recent[0] != chunkMap.end()) {
-            if (recent[0]->first == chunk_addr)
-                return recent[0]->second;
-            if (recent[1] != chunkMap.end() &&
-                    recent[1]->first == chunk_addr) {
-                update(recent[1]);
-                // recent[1] has just become recent[0].
-                return recent[0]->second;
-            }
-        }
-
-        // Actually look in the hash_map.
-        ChunkIt it = chunkMap.find(chunk_addr);
-        if (it != chunkMap.end()) {
-            update(it);
-            return it->second;
-        }
-
-        // Didn't find an existing chunk, so add a new one.
-        CacheChunk *newChunk = new CacheChunk;
-        typename ChunkMap::value_type to_insert(chunk_addr, newChunk);
-        update(chunkMap.insert(to_insert).first);
-        return newChunk;
-    }
+        FrontEntry &front = frontTable[frontIndex(chunk_addr)];
+        if (front.chunk && front.chunkAddr == chunk_addr)
+            return front.chunk;
 
-  public:
-    /// Constructor
-    AddrMap()
-    {
-        recent[0] = recent[1] = chunkMap.end();
+        // Actually look in the hash_map, and add a new chunk if there
+        // isn't one yet.
+        CacheChunk *&chunk = chunkMap[chunk_addr];
+        if (!chunk)
+            chunk = new CacheChunk;
+
+        front.chunkAddr = chunk_addr;
+        front.chunk = chunk;
+        return chunk;
     }
 
+  public:
     Value &
     lookup(Addr addr)
     {
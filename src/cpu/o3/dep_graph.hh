@@ -37,10 +37,11 @@
  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
-
 #ifndef __CPU_O3_DEP_GRAPH_HH__
 #define __CPU_O3_DEP_GRAPH_HH__
 
+#include <vector>
+
 #include "cpu/o3/comm.hh"
 
 namespace gem5
@@ -49,19 +50,22 @@ namespace gem5
 namespace o3
 {
 
-/** Node in a linked list. */
+/** Node in a linked list, linked by its index in the node pool. */
 template <class DynInstPtr>
 class DependencyEntry
 {
   public:
+    /** Index of the end of a list. */
+    static constexpr int Null = -1;
+
     DependencyEntry()
-        : inst(NULL), next(NULL)
+        : inst(NULL), next(Null)
     { }
 
     DynInstPtr inst;
     //Might want to include data about what arch. register the
     //dependence is waiting on.
-    DependencyEntry<DynInstPtr> *next;
+    int next;
 };
 
 /** Array of linked list that maintains the dependencies between
@@ -72,6 +76,11 @@ class DependencyEntry
  * the producing instruction of that register.  Instructions are put
  * on the list upon reaching the IQ, and are removed from the list
  * either when the producer completes, or the instruction is squashed.
+ *
+ * The consumer nodes are kept in a single pool and linked by their
+ * index in it, so that no node is allocated once the pool reached the
+ * number of dependences in flight.  Freed nodes are kept on a free list
+ * and reused first.
 */
 template <class DynInstPtr>
 class DependencyGraph
@@ -81,7 +90,8 @@ class DependencyGraph
 
     /** Default construction.  Must call resize() prior to use. */
     DependencyGraph()
-        : numEntries(0), memAllocCounter(0), nodesTraversed(0), nodesRemoved(0)
+        : numEntries(0), freeNodes(DepEntry::Null), memAllocCounter(0),
+          nodesTraversed(0), nodesRemoved(0)
     { }
 
     ~DependencyGraph();
@@ -110,16 +120,26 @@ class DependencyGraph
     DynInstPtr pop(RegIndex idx);
 
     /** Checks if the entire dependency graph is empty. */
-    bool empty() const;
+    bool empty() const { return memAllocCounter == 0; }
 
     /** Checks if there are any dependents on a specific register. */
-    bool empty(RegIndex idx) const { return !dependGraph[idx].next; }
+    bool
+    empty(RegIndex idx) const
+    {
+        return dependGraph[idx].next == DepEntry::Null;
+    }
 
     /** Debugging function to dump out the dependency graph.
      */
     void dump();
 
   private:
+    /** Takes a node from the free list, or adds one to the pool. */
+    int allocNode();
+
+    /** Returns a node to the free list. */
+    void freeNode(int node);
+
     /** Array of linked lists.  Each linked list is a list of all the
      *  instructions that depend upon a given register.  The actual
      *  register's index is used to index into the graph; ie all
@@ -128,10 +148,16 @@ class DependencyGraph
      */
     std::vector<DepEntry> dependGraph;
 
+    /** Pool of the consumer nodes of all the linked lists. */
+    std::vector<DepEntry> nodes;
+
     /** Number of linked lists; identical to the number of registers. */
     int numEntries;
 
-    // Debug variable, remove when done testing.
+    /** Head of the list of free nodes in the pool. */
+    int freeNodes;
+
+    /** Number of nodes in use. */
     unsigned memAllocCounter;
 
   public:
@@ -159,28 +185,46 @@ void
 DependencyGraph<DynInstPtr>::reset()
 {
     // Clear the dependency graph
-    DepEntry *curr;
-    DepEntry *prev;
-
     for (int i = 0; i < numEntries; ++i) {
-        curr = dependGraph[i].next;
+        dependGraph[i].inst = NULL;
+        dependGraph[i].next = DepEntry::Null;
+    }
 
-        while (curr) {
-            memAllocCounter--;
+    // Release the instructions, but keep the pool allocated
+    freeNodes = DepEntry::Null;
+    for (int i = nodes.size() - 1; i >= 0; --i) {
+        nodes[i].inst = NULL;
+        nodes[i].next = freeNodes;
+        freeNodes = i;
+    }
+    memAllocCounter = 0;
+}
 
-            prev = curr;
-            curr = prev->next;
-            prev->inst = NULL;
+template <class DynInstPtr>
+int
+DependencyGraph<DynInstPtr>::allocNode()
+{
+    ++memAllocCounter;
 
-            delete prev;
-        }
+    if (freeNodes == DepEntry::Null) {
+        nodes.emplace_back();
+        return nodes.size() - 1;
+    }
 
-        if (dependGraph[i].inst) {
-            dependGraph[i].inst = NULL;
-        }
+    int node = freeNodes;
+    freeNodes = nodes[node].next;
+    return node;
+}
 
-        dependGraph[i].next = NULL;
-    }
+template <class DynInstPtr>
+void
+DependencyGraph<DynInstPtr>::freeNode(int node)
+{
+    --memAllocCounter;
+
+    nodes[node].inst = NULL;
+    nodes[node].next = freeNodes;
+    freeNodes = node;
 }
 
 template <class DynInstPtr>
@@ -192,14 +236,12 @@ DependencyGraph<DynInstPtr>::insert(RegIndex idx, const DynInstPtr &new_inst)
 
     // First create the entry that will be added to the head of the
     // dependency chain.
-    DepEntry *new_entry = new DepEntry;
-    new_entry->next = dependGraph[idx].next;
-    new_entry->inst = new_inst;
+    int new_entry = allocNode();
+    nodes[new_entry].next = dependGraph[idx].next;
+    nodes[new_entry].inst = new_inst;
 
     // Then actually add it to the chain.
     dependGraph[idx].next = new_entry;
-
-    ++memAllocCounter;
 }
 
 
@@ -208,89 +250,67 @@ void
 DependencyGraph<DynInstPtr>::remove(RegIndex idx,
                                     const DynInstPtr &inst_to_remove)
 {
-    DepEntry *prev = &dependGraph[idx];
-    DepEntry *curr = dependGraph[idx].next;
+    int *prev_next = &dependGraph[idx].next;
+    int curr = dependGraph[idx].next;
 
     // Make sure curr isn't NULL.  Because this instruction is being
     // removed from a dependency list, it must have been placed there at
     // an earlier time.  The dependency chain should not be empty,
     // unless the instruction dependent upon it is already ready.
-    if (curr == NULL) {
+    if (curr == DepEntry::Null) {
         return;
     }
 
     nodesRemoved++;
 
     // Find the instruction to remove within the dependency linked list.
-    while (curr->inst != inst_to_remove) {
-        prev = curr;
-        curr = curr->next;
+    while (nodes[curr].inst != inst_to_remove) {
+        prev_next = &nodes[curr].next;
+        curr = nodes[curr].next;
         nodesTraversed++;
 
-        assert(curr != NULL);
+        assert(curr != DepEntry::Null);
     }
 
     // Now remove this instruction from the list.
-    prev->next = curr->next;
-
-    --memAllocCounter;
-
-    // Could push this off to the destructor of DependencyEntry
-    curr->inst = NULL;
+    *prev_next = nodes[curr].next;
 
-    delete curr;
+    freeNode(curr);
 }
 
 template <class DynInstPtr>
 DynInstPtr
 DependencyGraph<DynInstPtr>::pop(RegIndex idx)
 {
-    DepEntry *node;
-    node = dependGraph[idx].next;
+    int node = dependGraph[idx].next;
     DynInstPtr inst = NULL;
-    if (node) {
-        inst = node->inst;
-        dependGraph[idx].next = node->next;
-        node->inst = NULL;
-        memAllocCounter--;
-        delete node;
+    if (node != DepEntry::Null) {
+        inst = std::move(nodes[node].inst);
+        dependGraph[idx].next = nodes[node].next;
+        freeNode(node);
     }
     return inst;
 }
 
-template <class DynInstPtr>
-bool
-DependencyGraph<DynInstPtr>::empty() const
-{
-    for (int i = 0; i < numEntries; ++i) {
-        if (!empty(i))
-            return false;
-    }
-    return true;
-}
-
 template <class DynInstPtr>
 void
 DependencyGraph<DynInstPtr>::dump()
 {
-    DepEntry *curr;
-
     for (int i = 0; i < numEntries; ++i)
     {
-        curr = &dependGraph[i];
+        const DepEntry &head = dependGraph[i];
 
-        if (curr->inst) {
+        if (head.inst) {
             cprintf("dependGraph[%i]: producer: %s [sn:%lli] consumer: ",
-                    i, curr->inst->pcState(), curr->inst->seqNum);
+                    i, head.inst->pcState(), head.inst->seqNum);
         } else {
             cprintf("dependGraph[%i]: No producer. consumer: ", i);
         }
 
-        while (curr->next != NULL) {
-            curr = curr->next;
-
+        for (int curr = head.next; curr != DepEntry::Null;
+             curr = nodes[curr].next) {
             cprintf("%s [sn:%lli] ",
-                    curr->inst->pcState(), curr->inst->seqNum);
+                    nodes[curr].inst->pcState(), nodes[curr].inst->seqNum);
         }
 
         cprintf("\n");
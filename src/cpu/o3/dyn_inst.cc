@@ -43,6 +43,7 @@
 #include <algorithm>
 
 #include "base/intmath.hh"
+#include "cpu/o3/inst_buffer_pool.hh"
 #include "debug/DynInst.hh"
 #include "debug/IQ.hh"
 #include "debug/O3PipeView.hh"
@@ -107,15 +108,16 @@ DynInst::DynInst(const Arrays &arrays, const StaticInstPtr &_staticInst,
 {}
 
 /*
- * This custom "new" operator uses the default "new" operator to allocate space
- * for a DynInst, but also pads out the number of bytes to make room for some
+ * This custom "new" operator gets space for a DynInst from the buffer pool,
+ * but also pads out the number of bytes to make room for some
  * extra structures the DynInst needs. We save time and improve performance by
- * only going to the heap once to get space for all these structures.
+ * only getting one buffer for all these structures, which is usually a
+ * recycled one rather than fresh memory from the heap.
  *
  * When a DynInst is allocated with new, the compiler will call this "new"
  * operator with "count" set to the number of bytes it needs to store the
- * DynInst. We ultimately call into the default new operator to get those
- * bytes, but before we do, we pad out "count" so that there will be extra
+ * DynInst. We ultimately get those bytes from the buffer pool, but before
+ * we do, we pad out "count" so that there will be extra
  * space for some structures the DynInst needs. We take into account both the
  * absolute size of these structures, and also what alignment they need.
  *
@@ -136,6 +138,9 @@ DynInst::DynInst(const Arrays &arrays, const StaticInstPtr &_staticInst,
 void *
 DynInst::operator new(size_t count, Arrays &arrays)
 {
+    static_assert(alignof(DynInst) <= InstBufferPool::HeaderSize,
+                  "Buffers from the pool are not aligned enough");
+
     // Convenience variables for brevity.
     const auto num_dests = arrays.numDests;
     const auto num_srcs = arrays.numSrcs;
@@ -168,7 +173,7 @@ DynInst::operator new(size_t count, Arrays &arrays)
     size_t total_size = ready_src_idx + ready_src_idx_size;
 
     // Actually allocate it.
-    uint8_t *buf = (uint8_t *)::operator new(total_size);
+    uint8_t *buf = (uint8_t *)InstBufferPool::get().alloc(total_size);
 
     // Fill in "arrays" with pointers to all the arrays.
     arrays.flatDestIdx = (RegId *)(buf + flat_dest_idx);
@@ -187,13 +192,12 @@ DynInst::operator new(size_t count, Arrays &arrays)
     return buf;
 }
 
-// Because of the custom "new" operator that allocates more bytes than the
-// size of the DynInst object, AddressSanitizer throw new-delete-type-mismatch.
-// Adding a custom delete function is enough to shut down this false positive
+// The custom "new" operator allocates more bytes than the size of the
+// DynInst object from the buffer pool, so the buffer must go back to it.
 void
 DynInst::operator delete(void *ptr)
 {
-    ::operator delete(ptr);
+    InstBufferPool::get().free(ptr);
 }
 
 DynInst::~DynInst()
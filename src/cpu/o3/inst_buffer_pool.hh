@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_INST_BUFFER_POOL_HH__
+#define __CPU_O3_INST_BUFFER_POOL_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Buffers of deleted DynInsts, which are reused for the next DynInsts
+ * of the same size. Instructions, wrong-path ones included, are created
+ * and destroyed at a very high rate, so this avoids going to the heap
+ * for almost all of them. The buffers are grouped in classes of
+ * ClassSize bytes, as their size only depends on the number of register
+ * operands.
+ *
+ * Each simulation thread has its own pool, so no locking is needed.
+ * A pool never holds more buffers than the peak number of instructions
+ * alive at once on its thread. A buffer records its size class, so it
+ * may be freed to the pool of another thread.
+ */
+class InstBufferPool
+{
+  public:
+    /** Space in front of each buffer recording its size class. */
+    static constexpr size_t HeaderSize = alignof(std::max_align_t);
+    static constexpr size_t ClassSize = 64;
+
+    /** The pool of the calling thread. */
+    static InstBufferPool &
+    get()
+    {
+        // Never destroyed, as instructions may outlive the thread's
+        // other objects.
+        thread_local InstBufferPool *pool = new InstBufferPool;
+        return *pool;
+    }
+
+    /**
+     * Get a buffer of at least the given size, aligned like memory
+     * from operator new.
+     */
+    void *
+    alloc(size_t size)
+    {
+        const size_t size_class = divCeil(size, ClassSize);
+        uint8_t *buf;
+        if (size_class < freeBuffers.size() &&
+            !freeBuffers[size_class].empty()) {
+            buf = freeBuffers[size_class].back();
+            freeBuffers[size_class].pop_back();
+        } else {
+            buf = (uint8_t *)::operator new(
+                HeaderSize + size_class * ClassSize);
+            *(size_t *)buf = size_class;
+        }
+        return buf + HeaderSize;
+    }
+
+    /** Keep a buffer from alloc() for reuse. */
+    void
+    free(void *ptr)
+    {
+        uint8_t *buf = (uint8_t *)ptr - HeaderSize;
+        const size_t size_class = *(size_t *)buf;
+        if (size_class >= freeBuffers.size())
+            freeBuffers.resize(size_class + 1);
+        freeBuffers[size_class].push_back(buf);
+    }
+
+    /** The number of buffers kept for reuse. */
+    size_t
+    numFree() const
+    {
+        size_t num = 0;
+        for (const auto &buffers : freeBuffers)
+            num += buffers.size();
+        return num;
+    }
+
+  private:
+    std::vector<std::vector<uint8_t *>> freeBuffers;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_INST_BUFFER_POOL_HH__
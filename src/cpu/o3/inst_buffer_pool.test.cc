@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "cpu/o3/inst_buffer_pool.hh"
+
+using namespace gem5;
+using namespace gem5::o3;
+
+/** Buffers are aligned like memory from operator new, and usable. */
+TEST(InstBufferPoolTest, Alignment)
+{
+    InstBufferPool pool;
+    std::vector<void *> bufs;
+    for (size_t size = 1; size < 2000; size += 37) {
+        void *buf = pool.alloc(size);
+        EXPECT_EQ((uintptr_t)buf % alignof(std::max_align_t), 0);
+        memset(buf, 0xa5, size);
+        bufs.push_back(buf);
+    }
+    for (void *buf : bufs)
+        pool.free(buf);
+    EXPECT_EQ(pool.numFree(), bufs.size());
+}
+
+/** Freed buffers are reused for sizes of the same size class only. */
+TEST(InstBufferPoolTest, ReuseBySizeClass)
+{
+    InstBufferPool pool;
+    const size_t class_size = InstBufferPool::ClassSize;
+
+    void *small = pool.alloc(class_size * 3);
+    void *large = pool.alloc(class_size * 7 + 1);
+    pool.free(small);
+    pool.free(large);
+
+    // A larger size of the same class gets the larger buffer back
+    EXPECT_EQ(pool.alloc(class_size * 8), large);
+    // A size of no class in the pool gets a new buffer
+    void *other = pool.alloc(class_size * 5);
+    EXPECT_NE(other, small);
+    EXPECT_EQ(pool.alloc(class_size * 2 + 1), small);
+    EXPECT_EQ(pool.numFree(), 0);
+
+    pool.free(other);
+    pool.free(small);
+    pool.free(large);
+}
+
+/**
+ * A pool never holds more buffers than were alive at once, when
+ * windows of instructions are repeatedly created and squashed.
+ */
+TEST(InstBufferPoolTest, BoundedByPeakLive)
+{
+    InstBufferPool pool;
+    std::vector<void *> live;
+    std::set<void *> seen;
+    size_t peak = 0;
+    for (int round = 0; round < 50; round++) {
+        const size_t window = 10 + (round * 7) % 40;
+        for (size_t i = 0; i < window; i++) {
+            live.push_back(pool.alloc(100 + (i % 3) * 64));
+            seen.insert(live.back());
+        }
+        peak = std::max(peak, live.size());
+        // Squash the youngest half, retire the rest
+        while (live.size() > window / 2) {
+            pool.free(live.back());
+            live.pop_back();
+        }
+        for (void *buf : live)
+            pool.free(buf);
+        live.clear();
+        EXPECT_LE(pool.numFree(), peak);
+    }
+    EXPECT_EQ(seen.size(), pool.numFree());
+}
+
+/** Buffers may be freed to the pool of another thread. */
+TEST(InstBufferPoolTest, FreeOnOtherThread)
+{
+    void *buf = InstBufferPool::get().alloc(300);
+    InstBufferPool *other = nullptr;
+    std::thread thread([&]() {
+        other = &InstBufferPool::get();
+        other->free(buf);
+        EXPECT_EQ(other->alloc(300), buf);
+        other->free(buf);
+    });
+    thread.join();
+    EXPECT_NE(other, &InstBufferPool::get());
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_READY_QUEUE_AGES_HH__
+#define __CPU_O3_READY_QUEUE_AGES_HH__
+
+#include <bitset>
+
+#include "base/bitfield.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/op_class.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Age order of the ready queues of the instruction queue, one per op
+ * class. It keeps the set of the non-empty queues and the sequence
+ * number of the oldest instruction of each, i.e., of the instruction at
+ * its top, so that select can find the queue with the oldest ready
+ * instruction amongst some op classes without looking at the
+ * instructions themselves.
+ */
+class ReadyQueueAges
+{
+  public:
+    typedef std::bitset<Num_OpClasses> OpClassSet;
+
+    /** Returns the set of the op classes with ready instructions. */
+    const OpClassSet &nonEmpty() const { return queues; }
+
+    /** Returns the oldest instruction of a non-empty ready queue. */
+    InstSeqNum oldest(OpClass op_class) const { return oldestInst[op_class]; }
+
+    /** Records that an instruction was added to a ready queue. */
+    void
+    push(OpClass op_class, InstSeqNum seq_num)
+    {
+        // Update the age of the queue if it was empty or this
+        // instruction is older than its oldest one.
+        if (!queues[op_class] || seq_num < oldestInst[op_class]) {
+            queues.set(op_class);
+            oldestInst[op_class] = seq_num;
+        }
+    }
+
+    /**
+     * Records the new oldest instruction of a ready queue, after its
+     * oldest one was removed.
+     */
+    void
+    update(OpClass op_class, InstSeqNum seq_num)
+    {
+        oldestInst[op_class] = seq_num;
+    }
+
+    /** Records that a ready queue became empty. */
+    void remove(OpClass op_class) { queues.reset(op_class); }
+
+    /** Records that all the ready queues are empty. */
+    void clear() { queues.reset(); }
+
+    /**
+     * Returns the op class of the given set whose ready queue has the
+     * oldest instruction, or Num_OpClasses if the set is empty.
+     */
+    OpClass
+    oldestQueue(const OpClassSet &candidates) const
+    {
+        OpClass oldest = Num_OpClasses;
+        for (OpClassSet left = candidates; left.any();) {
+            const int op_class = findLsbSet(left);
+            left.reset(op_class);
+
+            if (oldest == Num_OpClasses ||
+                oldestInst[op_class] < oldestInst[oldest]) {
+                oldest = (OpClass)op_class;
+            }
+        }
+        return oldest;
+    }
+
+  private:
+    /** Set of the op classes whose ready queue is not empty. */
+    OpClassSet queues;
+
+    /** Sequence number of the oldest instruction of each non-empty
+     *  ready queue. */
+    InstSeqNum oldestInst[Num_OpClasses];
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_READY_QUEUE_AGES_HH__
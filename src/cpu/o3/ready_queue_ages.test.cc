@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "cpu/o3/ready_queue_ages.hh"
+
+using namespace gem5;
+using namespace gem5::o3;
+
+namespace
+{
+
+/** Ready queue of an op class, oldest instruction at the top. */
+typedef std::priority_queue<InstSeqNum, std::vector<InstSeqNum>,
+                            std::greater<InstSeqNum>> ReadyQueue;
+
+/** Issued instructions, as (op class, sequence number) pairs. */
+typedef std::vector<std::pair<int, InstSeqNum>> IssueOrder;
+
+/** Tells if a FU is available for an op class, and takes it if so. */
+typedef std::function<bool(int)> GetFU;
+
+/**
+ * The select of the instruction queue with a list of the ready queues
+ * sorted by age, as done before the ready queue ages were tracked.
+ */
+class ListOrderSelect
+{
+  public:
+    ListOrderSelect()
+    {
+        for (int i = 0; i < Num_OpClasses; ++i) {
+            queueOnList[i] = false;
+            readyIt[i] = listOrder.end();
+        }
+    }
+
+    void
+    push(int op_class, InstSeqNum seq_num)
+    {
+        readyInsts[op_class].push(seq_num);
+
+        if (!queueOnList[op_class]) {
+            addToOrderList(op_class);
+        } else if (readyInsts[op_class].top() <
+                   readyIt[op_class]->oldestInst) {
+            listOrder.erase(readyIt[op_class]);
+            addToOrderList(op_class);
+        }
+    }
+
+    IssueOrder
+    select(size_t width, const GetFU &get_fu)
+    {
+        IssueOrder issued;
+        auto order_it = listOrder.begin();
+        while (issued.size() < width && order_it != listOrder.end()) {
+            const int op_class = order_it->queueType;
+            const InstSeqNum seq_num = readyInsts[op_class].top();
+            EXPECT_EQ(seq_num, order_it->oldestInst);
+
+            if (!get_fu(op_class)) {
+                ++order_it;
+                continue;
+            }
+
+            readyInsts[op_class].pop();
+            if (!readyInsts[op_class].empty()) {
+                moveToYoungerInst(order_it);
+            } else {
+                readyIt[op_class] = listOrder.end();
+                queueOnList[op_class] = false;
+            }
+            listOrder.erase(order_it++);
+            issued.emplace_back(op_class, seq_num);
+        }
+        return issued;
+    }
+
+  private:
+    struct ListOrderEntry
+    {
+        int queueType;
+        InstSeqNum oldestInst;
+    };
+
+    typedef std::list<ListOrderEntry>::iterator ListOrderIt;
+
+    void
+    addToOrderList(int op_class)
+    {
+        ListOrderEntry queue_entry{op_class, readyInsts[op_class].top()};
+
+        auto list_it = listOrder.begin();
+        while (list_it != listOrder.end()) {
+            if (list_it->oldestInst > queue_entry.oldestInst)
+                break;
+            list_it++;
+        }
+
+        readyIt[op_class] = listOrder.insert(list_it, queue_entry);
+        queueOnList[op_class] = true;
+    }
+
+    void
+    moveToYoungerInst(ListOrderIt list_order_it)
+    {
+        const int op_class = list_order_it->queueType;
+        ListOrderEntry queue_entry{op_class, readyInsts[op_class].top()};
+
+        auto next_it = list_order_it;
+        ++next_it;
+        while (next_it != listOrder.end() &&
+               next_it->oldestInst < queue_entry.oldestInst) {
+            ++next_it;
+        }
+
+        readyIt[op_class] = listOrder.insert(next_it, queue_entry);
+    }
+
+    ReadyQueue readyInsts[Num_OpClasses];
+    std::list<ListOrderEntry> listOrder;
+    bool queueOnList[Num_OpClasses];
+    ListOrderIt readyIt[Num_OpClasses];
+};
+
+/** The select of the instruction queue, with the ready queue ages. */
+class AgeSelect
+{
+  public:
+    void
+    push(int op_class, InstSeqNum seq_num)
+    {
+        readyInsts[op_class].push(seq_num);
+        ages.push((OpClass)op_class, seq_num);
+    }
+
+    IssueOrder
+    select(size_t width, const GetFU &get_fu)
+    {
+        IssueOrder issued;
+        ReadyQueueAges::OpClassSet candidates = ages.nonEmpty();
+        while (issued.size() < width && candidates.any()) {
+            const OpClass op_class = ages.oldestQueue(candidates);
+            const InstSeqNum seq_num = readyInsts[op_class].top();
+            EXPECT_EQ(seq_num, ages.oldest(op_class));
+
+            if (!get_fu(op_class)) {
+                candidates.reset(op_class);
+                continue;
+            }
+
+            readyInsts[op_class].pop();
+            if (readyInsts[op_class].empty()) {
+                ages.remove(op_class);
+            } else {
+                ages.update(op_class, readyInsts[op_class].top());
+            }
+            candidates[op_class] = ages.nonEmpty()[op_class];
+            issued.emplace_back(op_class, seq_num);
+        }
+        return issued;
+    }
+
+    bool empty() const { return ages.nonEmpty().none(); }
+
+  private:
+    ReadyQueue readyInsts[Num_OpClasses];
+    ReadyQueueAges ages;
+};
+
+/**
+ * Make instructions ready at random, out of age order and in a few op
+ * classes, and check that both selects issue the same instructions in
+ * the same order. Each cycle a random number of FUs is available per
+ * op class, so some op classes are skipped after issuing.
+ */
+void
+checkRandomSelect(unsigned seed, int num_classes, int width)
+{
+    std::mt19937 rng(seed);
+    auto random = [&rng](unsigned n) { return rng() % n; };
+
+    ListOrderSelect list_select;
+    AgeSelect age_select;
+    std::vector<InstSeqNum> waiting;
+    InstSeqNum next_seq_num = 1;
+
+    for (int cycle = 0; cycle < 2000; ++cycle) {
+        // Fetch a few instructions, and make a random subset of the
+        // waiting ones ready, older ones not necessarily first
+        for (int i = random(2 * width); i > 0; --i)
+            waiting.push_back(next_seq_num++);
+        std::shuffle(waiting.begin(), waiting.end(), rng);
+        for (int i = random(waiting.size() + 1); i > 0; --i) {
+            const int op_class = random(num_classes);
+            list_select.push(op_class, waiting.back());
+            age_select.push(op_class, waiting.back());
+            waiting.pop_back();
+        }
+
+        std::vector<int> free_fus(num_classes);
+        for (auto &fus : free_fus)
+            fus = random(3);
+        std::vector<int> list_fus = free_fus;
+        std::vector<int> age_fus = free_fus;
+
+        const IssueOrder list_issued = list_select.select(width,
+            [&list_fus](int op_class) { return list_fus[op_class]-- > 0; });
+        const IssueOrder age_issued = age_select.select(width,
+            [&age_fus](int op_class) { return age_fus[op_class]-- > 0; });
+        ASSERT_EQ(list_issued, age_issued) << "cycle " << cycle;
+    }
+
+    // Drain the ready queues
+    for (int cycle = 0; !age_select.empty(); ++cycle) {
+        ASSERT_LT(cycle, 100000);
+        auto any_fu = [](int) { return true; };
+        ASSERT_EQ(list_select.select(width, any_fu),
+                  age_select.select(width, any_fu));
+    }
+    ASSERT_TRUE(list_select.select(width, [](int) { return true; }).empty());
+}
+
+} // anonymous namespace
+
+TEST(ReadyQueueAgesTest, OldestQueue)
+{
+    ReadyQueueAges ages;
+    EXPECT_TRUE(ages.nonEmpty().none());
+    EXPECT_EQ(ages.oldestQueue(ages.nonEmpty()), Num_OpClasses);
+
+    ages.push((OpClass)1, 30);
+    ages.push((OpClass)2, 20);
+    ages.push((OpClass)1, 10);
+    ages.push((OpClass)2, 40);
+    EXPECT_EQ(ages.oldest((OpClass)1), 10);
+    EXPECT_EQ(ages.oldest((OpClass)2), 20);
+    EXPECT_EQ(ages.oldestQueue(ages.nonEmpty()), 1);
+
+    ReadyQueueAges::OpClassSet candidates = ages.nonEmpty();
+    candidates.reset(1);
+    EXPECT_EQ(ages.oldestQueue(candidates), 2);
+
+    ages.update((OpClass)1, 30);
+    EXPECT_EQ(ages.oldestQueue(ages.nonEmpty()), 2);
+    ages.remove((OpClass)2);
+    EXPECT_EQ(ages.oldestQueue(ages.nonEmpty()), 1);
+
+    ages.clear();
+    EXPECT_TRUE(ages.nonEmpty().none());
+}
+
+TEST(ReadyQueueAgesTest, SelectMatchesListOrder)
+{
+    for (unsigned seed = 0; seed < 8; ++seed)
+        checkRandomSelect(seed, 4, 4);
+}
+
+TEST(ReadyQueueAgesTest, SelectMatchesListOrderAllClasses)
+{
+    for (unsigned seed = 0; seed < 4; ++seed)
+        checkRandomSelect(seed, Num_OpClasses, 8);
+}
+
+TEST(ReadyQueueAgesTest, SelectMatchesListOrderSingleIssue)
+{
+    for (unsigned seed = 0; seed < 4; ++seed)
+        checkRandomSelect(seed, 2, 1);
+}
@@ -109,6 +109,17 @@ class BTBSetAssociative : public BTBIndexingPolicy
         return sets[set_idx];
     }
 
+    const std::vector<ReplaceableEntry*> &
+    getPossibleEntries(const KeyType &key,
+                       std::vector<ReplaceableEntry*> &buffer) const override
+    {
+        auto set_idx = extractSet(key);
+
+        assert(set_idx < sets.size());
+
+        return sets[set_idx];
+    }
+
     /**
      * Set number of threads sharing the BTB
      */
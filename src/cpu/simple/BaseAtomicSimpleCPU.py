@@ -61,6 +61,17 @@ class BaseAtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    fetch_cache_lines = Param.Unsigned(
+        0,
+        "Number of instruction memory lines to keep in the CPU, which "
+        "speeds up fast-forwarding (0 disables the fetch cache)",
+    )
+    block_cache_blocks = Param.Unsigned(
+        0,
+        "Number of blocks of instructions decoded from the fetch cache "
+        "to keep in the CPU, which skips fetching and decoding them "
+        "(0 disables the block cache, requires the fetch cache)",
+    )
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
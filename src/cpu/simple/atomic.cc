@@ -54,6 +54,7 @@
 #include "params/BaseAtomicSimpleCPU.hh"
 #include "sim/faults.hh"
 #include "sim/full_system.hh"
+#include "sim/stats.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -69,6 +70,10 @@ AtomicSimpleCPU::init()
     data_read_req->setContext(cid);
     data_write_req->setContext(cid);
     data_amo_req->setContext(cid);
+
+    // Let the fetch cache notice the writes of other CPUs and devices
+    if (fetchCache.enabled())
+        system->getPhysMem().countWrites();
 }
 
 AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
@@ -81,15 +86,151 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       icachePort(name() + ".icache_port"),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
+      fetchCache(this, p.fetch_cache_lines, cacheLineSize()),
+      blockCache(this, p.block_cache_blocks),
       ppCommit(nullptr)
 {
+    fatal_if(fetchCache.enabled() && simulate_inst_stalls,
+             "%s: The fetch cache can not be used when simulating icache "
+             "stalls.", name());
+    fatal_if(blockCache.enabled() && !fetchCache.enabled(),
+             "%s: The block cache requires the fetch cache.", name());
+    fatal_if(blockCache.enabled() && numThreads > 1,
+             "%s: The block cache does not support multiple threads.",
+             name());
+
     _status = Idle;
-    ifetch_req = std::make_shared<Request>();
-    data_read_req = std::make_shared<Request>();
-    data_write_req = std::make_shared<Request>();
-    data_amo_req = std::make_shared<Request>();
+    ifetch_req = Request::create();
+    data_read_req = Request::create();
+    data_write_req = Request::create();
+    data_amo_req = Request::create();
+}
+
+
+AtomicSimpleCPU::FetchCache::FetchCache(statistics::Group *parent,
+                                        unsigned num_lines,
+                                        unsigned line_size)
+    : statistics::Group(parent, "fetchCache"),
+      tags(num_lines), data(num_lines * line_size), lineSize(line_size),
+      ADD_STAT(hits, statistics::units::Count::get(),
+               "Number of fetches served by the fetch cache"),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of fetches that missed in the fetch cache"),
+      ADD_STAT(invalidations, statistics::units::Count::get(),
+               "Number of lines invalidated by writes"),
+      ADD_STAT(flushes, statistics::units::Count::get(),
+               "Number of times the whole fetch cache was flushed")
+{
+    fatal_if(!isPowerOf2(num_lines) && num_lines != 0,
+             "The number of fetch cache lines must be a power of 2.");
+}
+
+uint8_t *
+AtomicSimpleCPU::FetchCache::allocate(Addr line_addr,
+                                      const std::atomic<uint32_t> *write_count)
+{
+    const size_t idx = index(line_addr);
+    tags[idx].addr = line_addr;
+    tags[idx].generation = generation;
+    tags[idx].writeCount = write_count;
+    tags[idx].writes = write_count->load(std::memory_order_acquire);
+    tags[idx].fill = ++fills;
+    return &data[idx * lineSize];
 }
 
+void
+AtomicSimpleCPU::FetchCache::invalidate(Addr addr, Addr size)
+{
+    if (!enabled())
+        return;
+
+    const Addr end = addr + std::max<Addr>(size, 1);
+    for (Addr line_addr = roundDown(addr, lineSize); line_addr < end;
+         line_addr += lineSize) {
+        Tag &tag = tags[index(line_addr)];
+        if (tag.generation == generation && tag.addr == line_addr) {
+            tag.generation = 0;
+            ++invalidations;
+        }
+    }
+}
+
+AtomicSimpleCPU::BlockCache::BlockCache(AtomicSimpleCPU *cpu,
+                                        unsigned num_blocks)
+    : statistics::Group(cpu, "blockCache"),
+      blocks(num_blocks),
+      ADD_STAT(hits, statistics::units::Count::get(),
+               "Number of blocks replayed"),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of blocks recorded"),
+      ADD_STAT(replayedInsts, statistics::units::Count::get(),
+               "Number of instructions replayed from blocks"),
+      ADD_STAT(flushes, statistics::units::Count::get(),
+               "Number of times all blocks were dropped"),
+      ADD_STAT(mips, statistics::units::Rate<
+                statistics::units::Count, statistics::units::Second>::get(),
+               "Simulated instructions per host second, in millions")
+{
+    fatal_if(!isPowerOf2(num_blocks) && num_blocks != 0,
+             "The number of blocks must be a power of 2.");
+
+    mips = cpu->baseStats.numInsts / hostSeconds /
+        statistics::constant(1e6);
+}
+
+const AtomicSimpleCPU::BlockCache::Inst *
+AtomicSimpleCPU::BlockCache::enter(Addr paddr, const PCStateBase &pc,
+                                   const FetchCache &fetch_cache)
+{
+    Block &block = blocks[index(paddr)];
+    if (block.generation == generation && block.addr == paddr &&
+        !block.insts.empty() &&
+        replayable(block.insts.front(), pc, fetch_cache)) {
+        ++hits;
+        ++replayedInsts;
+        replayBlock = &block;
+        replayIdx = 1;
+        recordBlock = nullptr;
+        return &block.insts.front();
+    }
+
+    ++misses;
+    block.addr = paddr;
+    block.generation = generation;
+    block.insts.clear();
+    replayBlock = nullptr;
+    recordBlock = &block;
+    return nullptr;
+}
+
+void
+AtomicSimpleCPU::BlockCache::record(const PCStateBase &pc,
+                                    const PCStateBase &decoded_pc,
+                                    const StaticInstPtr &static_inst,
+                                    Addr line_addr, uint64_t fill)
+{
+    auto &insts = recordBlock->insts;
+    if (insts.size() == maxBlockInsts || (!insts.empty() &&
+            roundDown(pc.instAddr(), regionBytes) !=
+            roundDown(insts.front().pc->instAddr(), regionBytes))) {
+        recordBlock = nullptr;
+        return;
+    }
+
+    insts.push_back({std::unique_ptr<PCStateBase>(pc.clone()),
+                     std::unique_ptr<PCStateBase>(decoded_pc.clone()),
+                     static_inst, line_addr, fill});
+}
+
+bool
+AtomicSimpleCPU::writesMiscReg(const StaticInstPtr &inst)
+{
+    for (int i = 0; i < inst->numDestRegs(); i++) {
+        if (inst->destRegIdx(i).is(MiscRegClass))
+            return true;
+    }
+    return false;
+}
 
 AtomicSimpleCPU::~AtomicSimpleCPU()
 {
@@ -148,6 +289,9 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory may have been written while the CPU was not running
+    flushFetchCaches();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -206,6 +350,8 @@ AtomicSimpleCPU::takeOverFrom(BaseCPU *old_cpu)
 
     // The tick event should have been descheduled by drain()
     assert(!tickEvent.scheduled());
+
+    flushFetchCaches();
 }
 
 void
@@ -298,6 +444,7 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
             t_info->thread->getIsaPtr()->handleLockedSnoop(pkt,
                     cacheBlockMask);
         }
+        cpu->fetchCache.invalidate(pkt->getAddr(), pkt->getSize());
     }
 
     return 0;
@@ -325,6 +472,9 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
                     cacheBlockMask);
         }
     }
+
+    if (pkt->isInvalidate() || pkt->isWrite())
+        cpu->fetchCache.invalidate(pkt->getAddr(), pkt->getSize());
 }
 
 bool
@@ -501,6 +651,11 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                 } else {
                     dcache_latency += sendPacket(dcachePort, &pkt);
 
+                    // The write may stay in a cache, so count it for the
+                    // fetch caches of all the CPUs
+                    system->getPhysMem().recordWrite(pkt.getAddr(),
+                                                     pkt.getSize());
+
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
                 }
@@ -590,6 +745,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         } else {
             dcache_latency += sendPacket(dcachePort, &pkt);
+            system->getPhysMem().recordWrite(pkt.getAddr(), pkt.getSize());
         }
 
         dcache_access = true;
@@ -652,11 +808,25 @@ AtomicSimpleCPU::tick()
         const PCStateBase &pc = thread->pcState();
 
         bool needToFetch = !isRomMicroPC(pc.microPC()) && !curMacroStaticInst;
-        if (needToFetch) {
+
+        // Instructions replayed from the block cache are neither
+        // translated nor fetched
+        const BlockCache::Inst *decoded = nullptr;
+        if (needToFetch && blockCache.enabled())
+            decoded = blockCache.next(pc, fetchCache);
+
+        if (needToFetch && !decoded) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
             fault = thread->mmu->translateAtomic(ifetch_req, thread->getTC(),
                                                  BaseMMU::Execute);
+
+            if (fault == NoFault && blockCache.enabled() &&
+                t_info.fetchOffset == 0 && !blockCache.recording()) {
+                const Addr paddr = ifetch_req->getPaddr() +
+                    (pc.instAddr() - ifetch_req->getVaddr());
+                decoded = blockCache.enter(paddr, pc, fetchCache);
+            }
         }
 
         if (fault == NoFault) {
@@ -664,7 +834,7 @@ AtomicSimpleCPU::tick()
             bool icache_access = false;
             dcache_access = false; // assume no dcache access
 
-            if (needToFetch) {
+            if (needToFetch && !decoded) {
                 // This is commented out because the decoder would act like
                 // a tiny cache otherwise. It wouldn't be flushed when needed
                 // like the I cache. It should be flushed, and when that works
@@ -677,8 +847,31 @@ AtomicSimpleCPU::tick()
                 //}
             }
 
+            std::unique_ptr<PCStateBase> recorded_pc;
+            if (decoded) {
+                predecodedInst = decoded->staticInst;
+                predecodedPC = decoded->decodedPC.get();
+            } else if (needToFetch && blockCache.recording()) {
+                recorded_pc.reset(pc.clone());
+            }
+
             preExecute();
 
+            if (recorded_pc) {
+                const Addr line_addr =
+                    roundDown(ifetch_req->getPaddr(), cacheLineSize());
+                const uint64_t fill = fetchCache.fillId(line_addr);
+                // Instructions fetched in several parts are not recorded
+                if (t_info.stayAtPC || !fill) {
+                    blockCache.end();
+                } else {
+                    blockCache.record(*recorded_pc, thread->pcState(),
+                            curMacroStaticInst ? curMacroStaticInst :
+                                                 curStaticInst,
+                            line_addr, fill);
+                }
+            }
+
             Tick stall_ticks = 0;
             if (curStaticInst) {
                 fault = curStaticInst->execute(&t_info, traceData);
@@ -691,6 +884,18 @@ AtomicSimpleCPU::tick()
                     traceFault();
                 }
 
+                // Memory may have been written behind the back of the
+                // memory system, e.g., by an emulated system call
+                if (fault != NoFault || curStaticInst->isSyscall() ||
+                    curStaticInst->isSerializing() ||
+                    curStaticInst->isNonSpeculative()) {
+                    flushFetchCaches();
+                } else if (blockCache.enabled() &&
+                           writesMiscReg(curStaticInst)) {
+                    // Decoding and translation may depend on it
+                    blockCache.flush();
+                }
+
                 if (fault != NoFault &&
                     std::dynamic_pointer_cast<SyscallRetryFault>(fault)) {
                     // Retry execution of system calls after a delay.
@@ -741,6 +946,9 @@ AtomicSimpleCPU::tick()
 Tick
 AtomicSimpleCPU::fetchInstMem()
 {
+    if (fetchCache.enabled() && !ifetch_req->isUncacheable())
+        return fetchInstMemCached();
+
     auto &decoder = threadInfo[curThread]->thread->decoder;
 
     Packet pkt = Packet(ifetch_req, MemCmd::ReadReq);
@@ -756,6 +964,51 @@ AtomicSimpleCPU::fetchInstMem()
     return latency;
 }
 
+Tick
+AtomicSimpleCPU::fetchInstMemCached()
+{
+    auto &decoder = threadInfo[curThread]->thread->decoder;
+
+    const Addr paddr = ifetch_req->getPaddr();
+    const Addr line_addr = roundDown(paddr, cacheLineSize());
+    const unsigned size = ifetch_req->getSize();
+    assert(paddr + size <= line_addr + cacheLineSize());
+
+    Tick latency = 0;
+    std::vector<uint8_t> uncached_line;
+    const uint8_t *line = fetchCache.lookup(line_addr);
+    if (!line) {
+        // Fetch the whole line on behalf of the fetch request
+        RequestPtr req = Request::create(line_addr, cacheLineSize(),
+                ifetch_req->getFlags(), ifetch_req->requestorId());
+        req->setContext(ifetch_req->contextId());
+        req->taskId(ifetch_req->taskId());
+
+        // Only the lines of memories counting their writes are kept,
+        // since the writes to other devices go unnoticed
+        const std::atomic<uint32_t> *write_count =
+            system->getPhysMem().writeCount(line_addr);
+        uint8_t *line_data;
+        if (write_count) {
+            line_data = fetchCache.allocate(line_addr, write_count);
+        } else {
+            uncached_line.resize(cacheLineSize());
+            line_data = uncached_line.data();
+        }
+
+        Packet pkt(req, MemCmd::ReadReq);
+        pkt.dataStatic(line_data);
+
+        latency = sendPacket(icachePort, &pkt);
+        panic_if(pkt.isError(), "Instruction fetch (%s) failed: %s",
+                pkt.getAddrRange().to_string(), pkt.print());
+        line = line_data;
+    }
+
+    memcpy(decoder->moreBytesPtr(), line + (paddr - line_addr), size);
+    return latency;
+}
+
 void
 AtomicSimpleCPU::regProbePoints()
 {
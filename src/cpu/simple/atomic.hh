@@ -41,6 +41,11 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "base/statistics.hh"
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
 #include "mem/request.hh"
@@ -141,7 +146,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     {
 
       public:
-        AtomicCPUDPort(const std::string &_name, BaseSimpleCPU *_cpu)
+        AtomicCPUDPort(const std::string &_name, AtomicSimpleCPU *_cpu)
             : AtomicCPUPort(_name), cpu(_cpu)
         {
             cacheBlockMask = ~(cpu->cacheLineSize() - 1);
@@ -151,7 +156,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
         Addr cacheBlockMask;
       protected:
-        BaseSimpleCPU *cpu;
+        AtomicSimpleCPU *cpu;
 
         virtual Tick recvAtomicSnoop(PacketPtr pkt);
         virtual void recvFunctionalSnoop(PacketPtr pkt);
@@ -170,6 +175,269 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     bool dcache_access;
     Tick dcache_latency;
 
+    /**
+     * A direct-mapped cache of instruction memory lines, indexed by
+     * physical address, which lets the CPU fetch without going through
+     * the memory system. It is meant for fast-forwarding, since the
+     * fetches that hit neither reach the instruction cache nor take
+     * any time.
+     *
+     * Each line remembers the write count of its page in physical
+     * memory (see PhysicalMemory::writeCount()), and is stale once the
+     * count changes, which it does on every write to the page, by any
+     * CPU or device. Lines are also invalidated by the snoops the CPU
+     * receives. As memory may be written behind the back of the memory
+     * system, e.g., by emulated system calls, the whole cache is
+     * flushed after faults, system calls and serializing instructions.
+     */
+    class FetchCache : public statistics::Group
+    {
+      public:
+        FetchCache(statistics::Group *parent, unsigned num_lines,
+                   unsigned line_size);
+
+        bool enabled() const { return !tags.empty(); }
+
+        /** Get the data of a line, or nullptr if it is not cached. */
+        const uint8_t *
+        lookup(Addr line_addr)
+        {
+            const size_t idx = index(line_addr);
+            if (valid(tags[idx], line_addr)) {
+                ++hits;
+                return &data[idx * lineSize];
+            }
+            ++misses;
+            return nullptr;
+        }
+
+        /**
+         * Identify the current contents of a line, which lets users of
+         * the data of a line notice when it is invalidated or refilled.
+         *
+         * @return A non-zero id unique to the fill of the line, or 0 if
+         *         the line is not cached
+         */
+        uint64_t
+        fillId(Addr line_addr) const
+        {
+            const Tag &tag = tags[index(line_addr)];
+            return valid(tag, line_addr) ? tag.fill : 0;
+        }
+
+        /**
+         * Allocate a line and return the buffer to fill with its data.
+         *
+         * @param line_addr Physical address of the line
+         * @param write_count Write count of the page of the line, read
+         *        before the line is filled
+         */
+        uint8_t *allocate(Addr line_addr,
+                          const std::atomic<uint32_t> *write_count);
+
+        /** Invalidate the lines overlapping an address range. */
+        void invalidate(Addr addr, Addr size);
+
+        /** Invalidate all lines. */
+        void
+        flush()
+        {
+            ++generation;
+            ++flushes;
+        }
+
+      private:
+        size_t
+        index(Addr line_addr) const
+        {
+            return (line_addr / lineSize) & (tags.size() - 1);
+        }
+
+        struct Tag
+        {
+            Addr addr = 0;
+            //! The line is valid if this matches the cache generation
+            uint64_t generation = 0;
+            //! The write count of the page, and its value when filled
+            const std::atomic<uint32_t> *writeCount = nullptr;
+            uint32_t writes = 0;
+            //! Unique id of the fill of the line
+            uint64_t fill = 0;
+        };
+
+        bool
+        valid(const Tag &tag, Addr line_addr) const
+        {
+            return tag.generation == generation && tag.addr == line_addr &&
+                tag.writeCount->load(std::memory_order_acquire) ==
+                tag.writes;
+        }
+
+        std::vector<Tag> tags;
+        std::vector<uint8_t> data;
+        const unsigned lineSize;
+        uint64_t generation = 1;
+        uint64_t fills = 0;
+
+        statistics::Scalar hits;
+        statistics::Scalar misses;
+        statistics::Scalar invalidations;
+        statistics::Scalar flushes;
+    } fetchCache;
+
+    /**
+     * A direct-mapped cache of the instructions decoded from the lines
+     * of the fetch cache, recorded as they run in blocks indexed by the
+     * physical address of their first instruction. Replaying a block
+     * skips the fetch translation, the fetch and the decoding of its
+     * instructions. An instruction is only replayed if the PC matches
+     * the one it was decoded at, and if the fetch cache line it was
+     * decoded from was not refilled since, so everything invalidating
+     * the fetch cache, e.g., self-modifying code, also invalidates the
+     * blocks.
+     *
+     * Blocks stay within a 4 KiB aligned virtual region, which is mapped
+     * by a single page on all ISAs, so only their first instruction is
+     * translated. Decoders depend on ISA state kept in misc registers,
+     * e.g., the x86 operating mode, and so do translations, so all
+     * blocks are dropped whenever a misc register is written.
+     */
+    class BlockCache : public statistics::Group
+    {
+      public:
+        /** An instruction decoded from the fetch cache. */
+        struct Inst
+        {
+            //! The PC before and after decoding the instruction
+            std::unique_ptr<PCStateBase> pc;
+            std::unique_ptr<PCStateBase> decodedPC;
+            StaticInstPtr staticInst;
+            //! Fetch cache line of the instruction and the id of its fill
+            Addr lineAddr;
+            uint64_t fill;
+        };
+
+        BlockCache(AtomicSimpleCPU *cpu, unsigned num_blocks);
+
+        bool enabled() const { return !blocks.empty(); }
+
+        /**
+         * Get the next instruction of the block being replayed, ending
+         * the replay unless the instruction may run at this PC.
+         */
+        const Inst *
+        next(const PCStateBase &pc, const FetchCache &fetch_cache)
+        {
+            if (!replayBlock)
+                return nullptr;
+
+            if (replayIdx < replayBlock->insts.size()) {
+                const Inst &inst = replayBlock->insts[replayIdx];
+                if (replayable(inst, pc, fetch_cache)) {
+                    ++replayIdx;
+                    ++replayedInsts;
+                    return &inst;
+                }
+            }
+            replayBlock = nullptr;
+            return nullptr;
+        }
+
+        /**
+         * Start replaying the block of the instruction at a physical
+         * address, or start recording a new block for it.
+         *
+         * @return The first instruction of the block if it is replayed
+         */
+        const Inst *enter(Addr paddr, const PCStateBase &pc,
+                          const FetchCache &fetch_cache);
+
+        bool recording() const { return recordBlock != nullptr; }
+
+        /**
+         * Append an instruction to the block being recorded, or end the
+         * recording if it does not fit in the block.
+         */
+        void record(const PCStateBase &pc, const PCStateBase &decoded_pc,
+                    const StaticInstPtr &static_inst, Addr line_addr,
+                    uint64_t fill);
+
+        /** Stop replaying and recording blocks. */
+        void
+        end()
+        {
+            replayBlock = nullptr;
+            recordBlock = nullptr;
+        }
+
+        /** Drop all blocks. */
+        void
+        flush()
+        {
+            if (!enabled())
+                return;
+            ++generation;
+            ++flushes;
+            end();
+        }
+
+      private:
+        struct Block
+        {
+            Addr addr = 0;
+            //! The block is valid if this matches the cache generation
+            uint64_t generation = 0;
+            std::vector<Inst> insts;
+        };
+
+        /** Maximum number of instructions per block. */
+        static constexpr size_t maxBlockInsts = 64;
+
+        /** Size of the virtual regions blocks are confined to. */
+        static constexpr Addr regionBytes = 4096;
+
+        static bool
+        replayable(const Inst &inst, const PCStateBase &pc,
+                   const FetchCache &fetch_cache)
+        {
+            return inst.pc->equals(pc) &&
+                fetch_cache.fillId(inst.lineAddr) == inst.fill;
+        }
+
+        size_t
+        index(Addr addr) const
+        {
+            return (addr ^ (addr >> 12)) & (blocks.size() - 1);
+        }
+
+        std::vector<Block> blocks;
+        uint64_t generation = 1;
+
+        const Block *replayBlock = nullptr;
+        size_t replayIdx = 0;
+        Block *recordBlock = nullptr;
+
+        statistics::Scalar hits;
+        statistics::Scalar misses;
+        statistics::Scalar replayedInsts;
+        statistics::Scalar flushes;
+        statistics::Formula mips;
+    } blockCache;
+
+    /** Drop the fetch cache and all the blocks decoded from it. */
+    void
+    flushFetchCaches()
+    {
+        fetchCache.flush();
+        blockCache.flush();
+    }
+
+    /** Check if an instruction writes a misc register. */
+    static bool writesMiscReg(const StaticInstPtr &inst);
+
+    /** Fetch the current instruction bytes through the fetch cache. */
+    Tick fetchInstMemCached();
+
     /** Probe Points. */
     ProbePointArg<std::pair<SimpleThread *, const StaticInstPtr>> *ppCommit;
 
@@ -348,16 +348,22 @@ BaseSimpleCPU::preExecute()
         //We're not in the middle of a macro instruction
         StaticInstPtr instPtr = NULL;
 
-        //Predecode, ie bundle up an ExtMachInst
-        //If more fetch data is needed, pass it in.
-        Addr fetch_pc =
-            (pc_state.instAddr() & decoder->pcMask()) + t_info.fetchOffset;
+        if (predecodedInst) {
+            instPtr = predecodedInst;
+            set(pc_state, *predecodedPC);
+            predecodedInst = nullptr;
+        } else {
+            //Predecode, ie bundle up an ExtMachInst
+            //If more fetch data is needed, pass it in.
+            Addr fetch_pc = (pc_state.instAddr() & decoder->pcMask()) +
+                t_info.fetchOffset;
 
-        decoder->moreBytes(pc_state, fetch_pc);
+            decoder->moreBytes(pc_state, fetch_pc);
 
-        //Decode an instruction if one is ready. Otherwise, we'll have to
-        //fetch beyond the MachInst at the current pc.
-        instPtr = decoder->decode(pc_state);
+            //Decode an instruction if one is ready. Otherwise, we'll have
+            //to fetch beyond the MachInst at the current pc.
+            instPtr = decoder->decode(pc_state);
+        }
         if (instPtr) {
             t_info.stayAtPC = false;
             thread->pcState(pc_state);
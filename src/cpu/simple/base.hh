@@ -132,6 +132,14 @@ class BaseSimpleCPU : public BaseCPU
 
     std::unique_ptr<PCStateBase> preExecuteTempPC;
 
+    /**
+     * Instruction decoded ahead of preExecute(), e.g., from a cache of
+     * decoded instructions, and the PC decoding it yields. preExecute()
+     * uses it instead of the decoder, and clears it.
+     */
+    StaticInstPtr predecodedInst;
+    const PCStateBase *predecodedPC = nullptr;
+
   public:
     void checkForInterrupts();
     void setupFetchRequest(const RequestPtr &req);
@@ -74,6 +74,11 @@ DmaPort::handleRespPacket(PacketPtr pkt, Tick delay)
     auto *state = dynamic_cast<DmaReqState*>(pkt->senderState);
     assert(state);
 
+    // The write may stay in a cache, so count it for the CPUs caching
+    // the contents of memory
+    if (MemCmd(state->cmd).isWrite())
+        sys->getPhysMem().recordWrite(pkt->getAddr(), pkt->req->getSize());
+
     handleResp(state, pkt->getAddr(), pkt->req->getSize(), delay);
 
     delete pkt;
@@ -127,7 +132,7 @@ DmaPort::handleResp(DmaReqState *state, Addr addr, Addr size, Tick delay)
 PacketPtr
 DmaPort::DmaReqState::createPacket()
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
             gen.addr(), gen.size(), flags, id);
     req->setStreamId(sid);
     req->setSubstreamId(ssid);
@@ -370,6 +375,10 @@ DmaPort::sendAtomicBdReq(DmaReqState *state)
                 memcpy(bd_data, state_data, handled);
         }
 
+        // Writes through the backdoor bypass the memory, so count them
+        if (MemCmd(state->cmd).isWrite())
+            sys->getPhysMem().recordWrite(state->gen.addr(), handled);
+
         // Advance the chunk generator past this region of memory.
         state->gen.setNext(state->gen.addr() + handled);
 
@@ -265,7 +265,7 @@ GPUCommandProcessor::submitDispatchPkt(void *raw_pkt, uint32_t queue_id,
                     dummy, BaseMMU::Mode::Read, is_system_page);
 
                 Request::Flags flags = Request::PHYSICAL;
-                RequestPtr request = std::make_shared<Request>(chunk_addr,
+                RequestPtr request = Request::create(chunk_addr,
                     akc_alignment_granularity, flags,
                     walker->getDevRequestor());
                 PacketPtr readPkt = new Packet(request, MemCmd::ReadReq);
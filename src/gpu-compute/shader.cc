@@ -214,9 +214,9 @@ Shader::prepareInvalidate(HSAQueueEntry *task) {
     for (int i_cu = 0; i_cu < n_cu; ++i_cu) {
         // create a request to hold INV info; the request's fields will
         // be updated in cu before use
-        auto tcc_req = std::make_shared<Request>(0, 0, 0,
-                                                 cuList[i_cu]->requestorId(),
-                                                 0, -1);
+        auto tcc_req = Request::create(0, 0, 0,
+                                       cuList[i_cu]->requestorId(),
+                                       0, -1);
 
         _dispatcher.updateInvCounter(kernId, +1);
         // all necessary INV flags are all set now, call cu to execute
@@ -225,9 +225,9 @@ Shader::prepareInvalidate(HSAQueueEntry *task) {
 
         // A set of CUs share a single SQC cache. Send a single invalidate
         // request to each SQC
-        auto sqc_req = std::make_shared<Request>(0, 0, 0,
-                                                 cuList[i_cu]->requestorId(),
-                                                 0, -1);
+        auto sqc_req = Request::create(0, 0, 0,
+                                       cuList[i_cu]->requestorId(),
+                                       0, -1);
 
         if ((i_cu % n_cu_per_sqc) == 0) {
             cuList[i_cu]->doSQCInvalidate(sqc_req, task->dispatchId());
@@ -404,7 +404,7 @@ Shader::AccessMem(uint64_t address, void *ptr, uint32_t size, int cu_id,
     for (ChunkGenerator gen(address, size, cuList.at(cu_id)->cacheLineSize());
          !gen.done(); gen.next()) {
 
-        RequestPtr req = std::make_shared<Request>(
+        RequestPtr req = Request::create(
             gen.addr(), gen.size(), 0,
             cuList[0]->requestorId(), 0, 0, nullptr);
 
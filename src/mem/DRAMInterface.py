@@ -70,6 +70,14 @@ class DRAMInterface(MemInterface):
     # performance being lower when enabled
     enable_dram_powerdown = Param.Bool(False, "Enable powerdown states")
 
+    # Coalesce the refresh events of the ranks while the controller is
+    # idle, and account for the refreshes when the ranks are next used.
+    # This does not change the results, and is only done when powerdown
+    # is disabled.
+    coalesce_refresh = Param.Bool(
+        True, "Coalesce the refresh events of idle ranks"
+    )
+
     # For power modelling we need to know if the DRAM has a DLL or not
     dll = Param.Bool(True, "DRAM has DLL or not")
 
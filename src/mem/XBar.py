@@ -100,6 +100,14 @@ class BaseXBar(ClockedObject):
         False, "Perform address mapping for the default port"
     )
 
+    # Peers running on other event queues hand their packets over at
+    # quantum boundaries, where they wait in a buffer of limited size
+    cross_queue_buffer_size = Param.Unsigned(
+        16,
+        "Packets of each type that can wait for a quantum boundary "
+        "when crossing event queues",
+    )
+
 
 class NoncoherentXBar(BaseXBar):
     type = "NoncoherentXBar"
@@ -46,6 +46,8 @@
 #ifndef __MEM_ABSTRACT_MEMORY_HH__
 #define __MEM_ABSTRACT_MEMORY_HH__
 
+#include <atomic>
+
 #include "mem/backdoor.hh"
 #include "mem/port.hh"
 #include "params/AbstractMemory.hh"
@@ -120,6 +122,10 @@ class AbstractMemory : public ClockedObject
     // Backdoor to access this memory.
     MemBackdoor backdoor;
 
+    // Number of writes to each page of this memory, shared with the
+    // other memories of its backing store, if the writes are counted
+    std::atomic<uint32_t> *writeCounts = nullptr;
+
     // Enable specific memories to be reported to the configuration table
     const bool confTableReported;
 
@@ -244,6 +250,35 @@ class AbstractMemory : public ClockedObject
      */
     void setBackingStore(uint8_t* pmem_addr);
 
+    /** Granularity at which the writes to memory are counted */
+    static constexpr Addr WriteCountPageSize = 4096;
+
+    /**
+     * Count the writes to each page of this memory, e.g., to let the
+     * CPUs caching instructions notice the writes of other requestors.
+     *
+     * @param write_counts Counter of each page of the backing store
+     */
+    void
+    setWriteCounts(std::atomic<uint32_t> *write_counts)
+    {
+        writeCounts = write_counts;
+    }
+
+    /** Count a write to an address range of this memory, if enabled. */
+    void
+    countWrite(Addr addr, Addr size)
+    {
+        if (!writeCounts)
+            return;
+        const Addr last = (addr + size - 1 - range.start()) /
+            WriteCountPageSize;
+        for (Addr page = (addr - range.start()) / WriteCountPageSize;
+             page <= last; page++) {
+            writeCounts[page].fetch_add(1, std::memory_order_release);
+        }
+    }
+
     void
     getBackdoor(MemBackdoorPtr &bd_ptr)
     {
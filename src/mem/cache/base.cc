@@ -250,7 +250,7 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
             // Basically we need to get the MSHR in the same state as if
             // we had missed and just received the response.
             // Request *req2 = new Request(*(pkt->req));
-            RequestPtr req2 = std::make_shared<Request>(*(pkt->req));
+            RequestPtr req2 = Request::create(*(pkt->req));
             PacketPtr pkt2 = new Packet(req2, pkt->cmd);
             MSHR *mshr = allocateMissBuffer(pkt2, curTick(), true);
             // Mark the MSHR "in service" (even though it's not) to prevent
@@ -1716,7 +1716,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1759,7 +1759,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
@@ -1833,7 +1833,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isSet(CacheBlk::DirtyBit)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
 
         request->taskId(blk.getTaskId());
@@ -2626,6 +2626,16 @@ CpuSidePort::CpuSidePort(const std::string &_name, BaseCache& _cache,
 {
 }
 
+void
+BaseCache::CpuSidePort::getExpressSnoopEventQueues(
+    std::set<EventQueue *> &eqs) const
+{
+    // express snoops we send towards memory, also on behalf of the
+    // ones we receive, are snooped up by the crossbars below
+    eqs.insert(cache.eventQueue());
+    cache.memSidePort.getPeerExpressSnoopEventQueues(eqs);
+}
+
 ///////////////
 //
 // MemSidePort
@@ -2715,6 +2725,15 @@ BaseCache::MemSidePort::MemSidePort(const std::string &_name,
 {
 }
 
+void
+BaseCache::MemSidePort::getSnoopEventQueues(
+    std::set<EventQueue *> &eqs) const
+{
+    eqs.insert(cache->eventQueue());
+    if (cache->cpuSidePort.isSnooping())
+        cache->cpuSidePort.getPeerSnoopEventQueues(eqs);
+}
+
 void
 WriteAllocator::updateMode(Addr write_addr, unsigned write_size,
                            Addr blk_addr)
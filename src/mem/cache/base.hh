@@ -48,6 +48,7 @@
 
 #include <cassert>
 #include <cstdint>
+#include <set>
 #include <string>
 
 #include "base/addr_range.hh"
@@ -243,6 +244,9 @@ class BaseCache : public ClockedObject
 
         MemSidePort(const std::string &_name, BaseCache *_cache,
                     const std::string &_label);
+
+        void getSnoopEventQueues(
+            std::set<EventQueue *> &eqs) const override;
     };
 
     /**
@@ -312,6 +316,16 @@ class BaseCache : public ClockedObject
         CpuSidePort(const std::string &_name, BaseCache& _cache,
                     const std::string &_label);
 
+        void getExpressSnoopEventQueues(
+            std::set<EventQueue *> &eqs) const override;
+
+        /** The cache snoops upwards if it forwards snoops at all. */
+        bool
+        originatesSnoops() const override
+        {
+            return cache.cpuSidePort.isSnooping();
+        }
+
     };
 
     CpuSidePort cpuSidePort;
@@ -45,10 +45,13 @@
 #ifndef __MEM_CACHE_QUEUE_HH__
 #define __MEM_CACHE_QUEUE_HH__
 
+#include <algorithm>
 #include <cassert>
 #include <string>
 #include <type_traits>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/named.hh"
 #include "base/trace.hh"
@@ -101,6 +104,43 @@ class Queue : public Drainable, public Named
     /** Holds non allocated entries. */
     typename Entry::List freeList;
 
+    /**
+     * Number of bits of the block address hash used to index
+     * blockIndex, which has at least twice as many buckets as entries.
+     */
+    const unsigned indexBits;
+
+    /**
+     * Hash index of the allocated entries by block address. Each bucket
+     * holds its entries in allocation order, i.e., in the same relative
+     * order as allocatedList, so that looking up a bucket finds the same
+     * entry as scanning the allocated list. Buckets keep their storage
+     * once grown, so the index does not allocate in steady state.
+     */
+    std::vector<std::vector<Entry*>> blockIndex;
+
+    std::vector<Entry*> &indexBucket(Addr blk_addr)
+    {
+        return blockIndex[(blk_addr * 0x9e3779b97f4a7c15ULL) >>
+                          (64 - indexBits)];
+    }
+
+    const std::vector<Entry*> &indexBucket(Addr blk_addr) const
+    {
+        return blockIndex[(blk_addr * 0x9e3779b97f4a7c15ULL) >>
+                          (64 - indexBits)];
+    }
+
+    /**
+     * Add a newly allocated entry at the end of the allocated list and
+     * of the block address index.
+     */
+    void insertAllocated(Entry* entry)
+    {
+        entry->allocIter = allocatedList.insert(allocatedList.end(), entry);
+        indexBucket(entry->blkAddr).push_back(entry);
+    }
+
     typename Entry::Iterator addToReadyList(Entry* entry)
     {
         if (readyList.empty() ||
@@ -135,6 +175,7 @@ class Queue : public Drainable, public Named
         Named(name),
         label(_label), numEntries(num_entries + reserve),
         numReserve(reserve), entries(numEntries, name + ".entry"),
+        indexBits(ceilLog2(2 * numEntries)), blockIndex(1ULL << indexBits),
         _numInService(0), allocated(0)
     {
         for (int i = 0; i < numEntries; ++i) {
@@ -168,7 +209,7 @@ class Queue : public Drainable, public Named
     Entry* findMatch(Addr blk_addr, bool is_secure,
                      bool ignore_uncacheable = true) const
     {
-        for (const auto& entry : allocatedList) {
+        for (const auto& entry : indexBucket(blk_addr)) {
             // we ignore any entries allocated for uncacheable
             // accesses and simply ignore them when matching, in the
             // cache we never check for matches when adding new
@@ -185,8 +226,16 @@ class Queue : public Drainable, public Named
 
     bool trySatisfyFunctional(PacketPtr pkt)
     {
+        if (allocatedList.empty()) {
+            return false;
+        }
+
+        // All the entries of a queue track blocks of the same size, so
+        // only the entries indexed by the block of the packet can match
+        const Addr blk_addr =
+            pkt->getBlockAddr(allocatedList.front()->blkSize);
         pkt->pushLabel(label);
-        for (const auto& entry : allocatedList) {
+        for (const auto& entry : indexBucket(blk_addr)) {
             if (entry->matchBlockAddr(pkt) &&
                 entry->trySatisfyFunctional(pkt)) {
                 pkt->popLabel();
@@ -206,6 +255,21 @@ class Queue : public Drainable, public Named
      */
     Entry* findPending(const QueueEntry* entry) const
     {
+        // Entries that are not in service are on the ready list, which
+        // only needs to be scanned to order several conflicting entries
+        Entry* pending = nullptr;
+        int num_pending = 0;
+        for (const auto& indexed_entry : indexBucket(entry->blkAddr)) {
+            if (!indexed_entry->inService &&
+                indexed_entry->conflictAddr(entry)) {
+                pending = indexed_entry;
+                ++num_pending;
+            }
+        }
+        if (num_pending <= 1) {
+            return pending;
+        }
+
         for (const auto& ready_entry : readyList) {
             if (ready_entry->conflictAddr(entry)) {
                 return ready_entry;
@@ -241,6 +305,8 @@ class Queue : public Drainable, public Named
     deallocate(Entry *entry)
     {
         allocatedList.erase(entry->allocIter);
+        auto &bucket = indexBucket(entry->blkAddr);
+        bucket.erase(std::find(bucket.begin(), bucket.end(), entry));
         freeList.push_front(entry);
         allocated--;
         if (entry->inService) {
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/cache/queue.hh"
+#include "mem/cache/queue_entry.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** A queue entry that only keeps the fields the lookups depend on. */
+class TestEntry : public QueueEntry
+{
+  public:
+    typedef std::list<TestEntry *> List;
+    typedef List::iterator Iterator;
+
+    Iterator readyIter;
+    Iterator allocIter;
+
+    TestEntry(const std::string &name) : QueueEntry(name) {}
+
+    void
+    allocate(Addr blk_addr, bool is_secure, bool uncacheable, Tick ready)
+    {
+        blkAddr = blk_addr;
+        blkSize = 64;
+        isSecure = is_secure;
+        _isUncacheable = uncacheable;
+        readyTime = ready;
+        inService = false;
+    }
+
+    void deallocate() { inService = false; }
+
+    bool
+    matchBlockAddr(const Addr addr, const bool is_secure) const override
+    {
+        return blkAddr == addr && isSecure == is_secure;
+    }
+
+    bool matchBlockAddr(const PacketPtr pkt) const override { return false; }
+
+    bool
+    conflictAddr(const QueueEntry *entry) const override
+    {
+        return entry->matchBlockAddr(blkAddr, isSecure);
+    }
+
+    bool sendPacket(BaseCache &cache) override { return false; }
+    Target *getTarget() override { return nullptr; }
+};
+
+/**
+ * A queue that exposes its bookkeeping the way the MSHR queue and the
+ * write queue drive it, along with the linear scans of the allocated
+ * and ready lists that the block address index replaces.
+ */
+class TestQueue : public Queue<TestEntry>
+{
+  public:
+    TestQueue(int num_entries)
+        : Queue<TestEntry>("test", num_entries, 0, "queue")
+    {}
+
+    TestEntry *
+    allocate(Addr blk_addr, bool is_secure, bool uncacheable, Tick ready)
+    {
+        TestEntry *entry = freeList.front();
+        freeList.pop_front();
+        entry->allocate(blk_addr, is_secure, uncacheable, ready);
+        insertAllocated(entry);
+        entry->readyIter = addToReadyList(entry);
+        allocated += 1;
+        return entry;
+    }
+
+    void
+    markInService(TestEntry *entry)
+    {
+        entry->inService = true;
+        readyList.erase(entry->readyIter);
+        _numInService += 1;
+    }
+
+    void
+    markPending(TestEntry *entry)
+    {
+        entry->inService = false;
+        --_numInService;
+        entry->readyIter = addToReadyList(entry);
+    }
+
+    const TestEntry::List &allocatedEntries() const { return allocatedList; }
+
+    TestEntry *
+    scanMatch(Addr blk_addr, bool is_secure, bool ignore_uncacheable) const
+    {
+        for (const auto &entry : allocatedList) {
+            if (!(ignore_uncacheable && entry->isUncacheable()) &&
+                entry->matchBlockAddr(blk_addr, is_secure)) {
+                return entry;
+            }
+        }
+        return nullptr;
+    }
+
+    TestEntry *
+    scanPending(const QueueEntry *entry) const
+    {
+        for (const auto &ready_entry : readyList) {
+            if (ready_entry->conflictAddr(entry)) {
+                return ready_entry;
+            }
+        }
+        return nullptr;
+    }
+};
+
+/**
+ * Drive a queue with a random mix of allocations, deallocations and
+ * service state changes, and check after every step that the indexed
+ * lookups find the same entries as the linear scans for every address.
+ * Few distinct blocks are used so that several entries often track the
+ * same block and unrelated blocks share index buckets.
+ */
+void
+checkRandomSequence(int num_entries, int num_blocks, int num_steps,
+                    unsigned seed)
+{
+    TestQueue queue(num_entries);
+    std::vector<TestEntry *> live;
+    std::mt19937 rng(seed);
+    TestEntry probe("probe");
+
+    auto random = [&rng](unsigned n) { return rng() % n; };
+
+    for (int step = 0; step < num_steps; ++step) {
+        const unsigned op = random(4);
+        if (op < 2 && !queue.isFull()) {
+            // Ready times out of allocation order make the ready list
+            // order differ from the order of the index buckets
+            live.push_back(queue.allocate(random(num_blocks) * 64,
+                                          random(2), random(4) == 0,
+                                          random(100)));
+        } else if (op == 2 && !live.empty()) {
+            const unsigned i = random(live.size());
+            queue.deallocate(live[i]);
+            live.erase(live.begin() + i);
+        } else if (op == 3 && !live.empty()) {
+            TestEntry *entry = live[random(live.size())];
+            if (entry->inService) {
+                queue.markPending(entry);
+            } else {
+                queue.markInService(entry);
+            }
+        }
+
+        ASSERT_EQ(queue.allocatedEntries().size(), live.size());
+        for (int blk = 0; blk < num_blocks; ++blk) {
+            for (bool secure : {false, true}) {
+                const Addr addr = blk * 64;
+                for (bool ignore : {false, true}) {
+                    ASSERT_EQ(queue.findMatch(addr, secure, ignore),
+                              queue.scanMatch(addr, secure, ignore))
+                        << "step " << step << " addr " << addr;
+                }
+                probe.allocate(addr, secure, false, 0);
+                ASSERT_EQ(queue.findPending(&probe),
+                          queue.scanPending(&probe))
+                    << "step " << step << " addr " << addr;
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(QueueTest, IndexedLookupsMatchScan)
+{
+    for (unsigned seed = 0; seed < 4; ++seed) {
+        checkRandomSequence(16, 24, 4000, seed);
+    }
+}
+
+TEST(QueueTest, IndexedLookupsMatchScanManyDuplicates)
+{
+    for (unsigned seed = 0; seed < 4; ++seed) {
+        checkRandomSequence(12, 3, 4000, seed);
+    }
+}
+
+TEST(QueueTest, IndexedLookupsMatchScanLargeQueue)
+{
+    checkRandomSequence(256, 512, 500, 1);
+}
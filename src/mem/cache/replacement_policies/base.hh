@@ -29,7 +29,10 @@
 #ifndef __MEM_CACHE_REPLACEMENT_POLICIES_BASE_HH__
 #define __MEM_CACHE_REPLACEMENT_POLICIES_BASE_HH__
 
+#include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
@@ -48,6 +51,54 @@ typedef std::vector<ReplaceableEntry*> ReplacementCandidates;
 namespace replacement_policy
 {
 
+/**
+ * Allocator of the replacement data of a policy's entries. The data are
+ * stored in large chunks rather than allocated one by one, which saves a
+ * heap allocation and a shared_ptr control block per entry. Only the
+ * allocation changes: the policies still reach the data of each entry
+ * through its replacementData pointer, and victim searches still visit
+ * the candidates one by one. A chunk is freed once none of its data is
+ * referenced anymore.
+ *
+ * @tparam Data The type of the replacement data.
+ */
+template <class Data>
+class ReplacementDataPool
+{
+  public:
+    /**
+     * Instantiate the replacement data of an entry.
+     *
+     * @param args Arguments of the constructor of the data.
+     * @return A shared pointer to the new replacement data.
+     */
+    template <typename... Args>
+    std::shared_ptr<Data>
+    instantiate(Args&&... args)
+    {
+        if (!chunk || chunk->size() == chunk->capacity()) {
+            // Grow the chunks, so small tables waste little memory
+            chunkSize = std::min(2 * chunkSize, MaxChunkSize);
+            chunk = std::make_shared<std::vector<Data>>();
+            chunk->reserve(chunkSize);
+        }
+
+        // The chunk never grows past its capacity, so the data of the
+        // entries never move
+        chunk->emplace_back(std::forward<Args>(args)...);
+        return std::shared_ptr<Data>(chunk, &chunk->back());
+    }
+
+  private:
+    static constexpr size_t MaxChunkSize = 4096;
+
+    /** Capacity of the current chunk. */
+    size_t chunkSize = 8;
+
+    /** Chunk in which the next data are instantiated. */
+    std::shared_ptr<std::vector<Data>> chunk;
+};
+
 /**
  * A common base class of cache replacement policy objects.
  */
@@ -60,6 +60,9 @@ class LRU : public Base
         LRUReplData() : lastTouchTick(0) {}
     };
 
+    /** Allocator of the replacement data. */
+    ReplacementDataPool<LRUReplData> replDataPool;
+
   public:
     typedef LRURPParams Params;
     LRU(const Params &p);
@@ -93,6 +93,9 @@ class SHiP : public BRRIP
         bool wasReReferenced() const;
     };
 
+    /** Allocator of the SHiP-specific replacement data. */
+    ReplacementDataPool<SHiPReplData> shipReplDataPool;
+
     /**
      * Saturation percentage at which an entry starts being inserted as
      * intermediate re-reference.
@@ -82,8 +82,8 @@ CacheBlk*
 BaseTags::findBlock(const CacheBlk::KeyType &key) const
 {
     // Find possible entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
-        indexingPolicy->getPossibleEntries(key);
+    const std::vector<ReplaceableEntry*> &entries =
+        indexingPolicy->getPossibleEntries(key, lookupBuffer);
 
     // Search for block
     for (const auto& location : entries) {
@@ -97,6 +97,23 @@ BaseTags::findBlock(const CacheBlk::KeyType &key) const
     return nullptr;
 }
 
+const std::vector<ReplaceableEntry*> &
+BaseTags::getVictimCandidates(const CacheBlk::KeyType &key,
+                              const uint64_t partition_id)
+{
+    const std::vector<ReplaceableEntry*> &entries =
+        indexingPolicy->getPossibleEntries(key, victimBuffer);
+    if (!partitionManager)
+        return entries;
+
+    // Filter entries based on PartitionID, in a copy of them if they
+    // are the indexing policy's own
+    if (&entries != &victimBuffer)
+        victimBuffer.assign(entries.begin(), entries.end());
+    partitionManager->filterByPartition(victimBuffer, partition_id);
+    return victimBuffer;
+}
+
 void
 BaseTags::insertBlock(const PacketPtr pkt, CacheBlk *blk)
 {
@@ -50,6 +50,7 @@
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "base/callback.hh"
 #include "base/logging.hh"
@@ -91,6 +92,14 @@ class BaseTags : public ClockedObject
     /** Partitioning manager */
     partitioning_policy::PartitionManager *partitionManager;
 
+    /**
+     * Buffers for the possible entries of block lookups and of victim
+     * searches, so that neither allocates memory once they have grown
+     * to the associativity.
+     */
+    mutable std::vector<ReplaceableEntry*> lookupBuffer;
+    std::vector<ReplaceableEntry*> victimBuffer;
+
     /**
      * The number of tags that need to be touched to meet the warmup
      * percentage.
@@ -160,6 +169,19 @@ class BaseTags : public ClockedObject
         statistics::Scalar dataAccesses;
     } stats;
 
+  protected:
+    /**
+     * Find the entries that may be replaced to make room for the block of
+     * the given key, filtered by the partitioning policy if there is one.
+     *
+     * @param key The key of the new block.
+     * @param partition_id Partition ID of the new block.
+     * @return The replacement candidates, valid until the next call.
+     */
+    const std::vector<ReplaceableEntry*> &
+    getVictimCandidates(const CacheBlk::KeyType &key,
+                        const uint64_t partition_id);
+
   public:
     PARAMS(BaseTags);
     BaseTags(const Params &p);
@@ -194,6 +194,25 @@ class IndexingPolicyTemplate : public SimObject
     virtual std::vector<ReplaceableEntry*> getPossibleEntries(const KeyType &key)
                                                                     const = 0;
 
+    /**
+     * Find all possible entries for insertion and replacement of an address,
+     * like getPossibleEntries(), but without allocating memory on every
+     * lookup. Policies either return the entries directly, e.g., a whole
+     * set, or store them in the given buffer, whose storage is reused.
+     *
+     * @param key The key to find possible entries for.
+     * @param buffer Vector where the entries may be stored.
+     * @return The possible entries, only valid until the next call with
+     *         the same buffer.
+     */
+    virtual const std::vector<ReplaceableEntry*> &
+    getPossibleEntries(const KeyType &key,
+                       std::vector<ReplaceableEntry*> &buffer) const
+    {
+        buffer = getPossibleEntries(key);
+        return buffer;
+    }
+
     /**
      * Regenerate an entry's address from its tag and assigned indexing bits.
      *
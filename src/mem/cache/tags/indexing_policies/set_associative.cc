@@ -75,4 +75,11 @@ SetAssociative::getPossibleEntries(const Addr &addr) const
     return sets[extractSet(addr)];
 }
 
+const std::vector<ReplaceableEntry*> &
+SetAssociative::getPossibleEntries(const Addr &addr,
+    std::vector<ReplaceableEntry*> &buffer) const
+{
+    return sets[extractSet(addr)];
+}
+
 } // namespace gem5
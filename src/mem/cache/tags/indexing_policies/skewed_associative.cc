@@ -211,14 +211,23 @@ std::vector<ReplaceableEntry*>
 SkewedAssociative::getPossibleEntries(const Addr &addr) const
 {
     std::vector<ReplaceableEntry*> entries;
+    getPossibleEntries(addr, entries);
+    return entries;
+}
+
+const std::vector<ReplaceableEntry*> &
+SkewedAssociative::getPossibleEntries(const Addr &addr,
+    std::vector<ReplaceableEntry*> &buffer) const
+{
+    buffer.clear();
 
     // Parse all ways
     for (uint32_t way = 0; way < assoc; ++way) {
         // Apply hash to get set, and get way entry in it
-        entries.push_back(sets[extractSet(addr, way)][way]);
+        buffer.push_back(sets[extractSet(addr, way)][way]);
     }
 
-    return entries;
+    return buffer;
 }
 
 } // namespace gem5
@@ -163,6 +163,19 @@ class SkewedAssociative : public BaseIndexingPolicy
     std::vector<ReplaceableEntry*> getPossibleEntries(const Addr &addr) const
                                                                    override;
 
+    /**
+     * Find all possible entries for insertion and replacement of an address,
+     * storing them in the given buffer without allocating once it has grown
+     * to the associativity.
+     *
+     * @param addr The addr to a find possible entries for.
+     * @param buffer Vector where the entries are stored.
+     * @return The possible entries, i.e., the buffer.
+     */
+    const std::vector<ReplaceableEntry*> &
+    getPossibleEntries(const Addr &addr,
+                       std::vector<ReplaceableEntry*> &buffer) const override;
+
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
      * Uses the inverse of the skewing function.
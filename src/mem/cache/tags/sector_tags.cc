@@ -269,8 +269,8 @@ SectorTags::findBlock(const CacheBlk::KeyType &key) const
     const Addr offset = extractSectorOffset(key.address);
 
     // Find all possible sector entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
-        indexingPolicy->getPossibleEntries(key);
+    const std::vector<ReplaceableEntry*> &entries =
+        indexingPolicy->getPossibleEntries(key, lookupBuffer);
 
     // Search for block
     for (const auto& sector : entries) {
@@ -290,13 +290,9 @@ SectorTags::findVictim(const CacheBlk::KeyType &key,
                        std::vector<CacheBlk*>& evict_blks,
                        const uint64_t partition_id)
 {
-    // Get possible entries to be victimized
-    std::vector<ReplaceableEntry*> sector_entries =
-        indexingPolicy->getPossibleEntries(key);
-
-    // Filter entries based on PartitionID
-    if (partitionManager)
-        partitionManager->filterByPartition(sector_entries, partition_id);
+    // Get possible entries to be victimized, filtered by PartitionID
+    const std::vector<ReplaceableEntry*> &sector_entries =
+        getVictimCandidates(key, partition_id);
 
     // Check if the sector this address belongs to has been allocated
     SectorBlk* victim_sector = nullptr;
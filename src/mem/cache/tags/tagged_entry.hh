@@ -94,6 +94,13 @@ class TaggedSetAssociative : public TaggedIndexingPolicy
         return sets[extractSet(key)];
     }
 
+    const std::vector<ReplaceableEntry*> &
+    getPossibleEntries(const KeyType &key,
+                       std::vector<ReplaceableEntry*> &buffer) const override
+    {
+        return sets[extractSet(key)];
+    }
+
     Addr
     regenerateAddr(const KeyType &key,
                    const ReplaceableEntry *entry) const override
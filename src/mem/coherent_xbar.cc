@@ -45,6 +45,8 @@
 
 #include "mem/coherent_xbar.hh"
 
+#include <algorithm>
+
 #include "base/compiler.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
@@ -125,6 +127,12 @@ CoherentXBar::init()
 {
     BaseXBar::init();
 
+    // neighbours on other event queues talk to the crossbar at the
+    // quantum boundaries, and as snoops are issued synchronously, local
+    // requests that snoop objects on other queues are also retried there
+    spliceCrossQueuePorts();
+    findCrossQueueSnoops();
+
     // iterate over our CPU-side ports and determine which of our
     // neighbouring memory-side ports are snooping and add them as snoopers
     for (const auto& p: cpuSidePorts) {
@@ -161,6 +169,23 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     // determine the destination based on the destination address range
     PortID mem_side_port_id = findPort(pkt);
 
+    const bool snoop_caches = !system->bypassCaches() &&
+        pkt->cmd != MemCmd::WriteClean;
+
+    // objects on other event queues can only be snooped at a quantum
+    // boundary, so hold off the request until then
+    if (!is_express_snoop && snoop_caches && crossQueueSnoops &&
+        !CrossQueuePort::synchronized() &&
+        snoopsOtherQueues(pkt, *src_port)) {
+        DPRINTF(CoherentXBar, "%s: src %s packet %s QUANTUM\n", __func__,
+                src_port->name(), pkt->print());
+        if (std::find(quantumWaiters.begin(), quantumWaiters.end(),
+                      src_port) == quantumWaiters.end()) {
+            quantumWaiters.push_back(src_port);
+        }
+        return false;
+    }
+
     // test if the crossbar should be considered occupied for the current
     // port, and exclude express snoops from the check
     if (!is_express_snoop &&
@@ -196,8 +221,6 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     // the request
     const bool is_destination = isDestination(pkt);
 
-    const bool snoop_caches = !system->bypassCaches() &&
-        pkt->cmd != MemCmd::WriteClean;
     if (snoop_caches) {
         assert(pkt->snoopDelay == 0);
 
@@ -724,6 +747,118 @@ CoherentXBar::forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id,
     snoopFanout.sample(fanout);
 }
 
+void
+CoherentXBar::findCrossQueueSnoops()
+{
+    crossQueueSnoopers.assign(cpuSidePorts.size(), false);
+    if (numMainEventQueues < 2)
+        return;
+
+    bool cross_queue_snoopers = false;
+    for (const auto *p : cpuSidePorts) {
+        if (!p->isSnooping())
+            continue;
+
+        std::set<EventQueue *> eqs;
+        p->getPeerSnoopEventQueues(eqs);
+        eqs.erase(eventQueue());
+        crossQueueSnoopers[p->getId()] = !eqs.empty();
+        cross_queue_snoopers |= !eqs.empty();
+    }
+
+    std::set<EventQueue *> eqs;
+    for (const auto *p : memSidePorts)
+        p->getPeerExpressSnoopEventQueues(eqs);
+    eqs.erase(eventQueue());
+    crossQueueExpressSnoops = !eqs.empty();
+
+    // the snoops we receive from the memory side can't be held back,
+    // so they must not reach other event queues, unless they are all
+    // caused by requests that the crossbars below hold back
+    fatal_if(cross_queue_snoopers && memSideOriginatesSnoops(),
+             "%s: Snoops from the memory side, e.g., from a cache checking "
+             "if the blocks it evicts are cached above, would reach objects "
+             "on other event queues during a quantum. Put the objects that "
+             "snoop through the crossbar on its event queue, or do not put "
+             "a cache below it.", name());
+
+    crossQueueSnoops = cross_queue_snoopers || crossQueueExpressSnoops;
+    if (crossQueueSnoops) {
+        DPRINTF(CoherentXBar, "%s: Holding back requests that snoop other "
+                "event queues until quantum boundaries\n", __func__);
+        CrossQueuePort::addQuantumHook(eventQueue(),
+                                       [this]() { retryQuantumWaiters(); });
+    }
+}
+
+bool
+CoherentXBar::snoopsOtherQueues(const PacketPtr pkt,
+                                const ResponsePort &src_port) const
+{
+    bool snoops = false;
+    if (snoopFilter) {
+        // block-evicting packets are not snooped up
+        if (pkt->isEviction())
+            return false;
+
+        for (const auto *p : snoopFilter->peekRequest(pkt, src_port)) {
+            if (crossQueueSnoopers[p->getId()])
+                return true;
+            snoops = true;
+        }
+    } else {
+        for (const auto *p : snoopPorts) {
+            if (p->getId() == src_port.getId())
+                continue;
+            if (crossQueueSnoopers[p->getId()])
+                return true;
+            snoops = true;
+        }
+    }
+
+    // a snooper committing to respond turns the request into an
+    // express snoop on its way to memory
+    return snoops && crossQueueExpressSnoops;
+}
+
+void
+CoherentXBar::getSnoopEventQueues(std::set<EventQueue *> &eqs) const
+{
+    eqs.insert(eventQueue());
+    for (const auto *p : cpuSidePorts) {
+        if (p->isSnooping())
+            p->getPeerSnoopEventQueues(eqs);
+    }
+}
+
+void
+CoherentXBar::getExpressSnoopEventQueues(std::set<EventQueue *> &eqs) const
+{
+    getSnoopEventQueues(eqs);
+    for (const auto *p : memSidePorts)
+        p->getPeerExpressSnoopEventQueues(eqs);
+}
+
+bool
+CoherentXBar::memSideOriginatesSnoops() const
+{
+    for (const auto *p : memSidePorts) {
+        if (p->peerOriginatesSnoops())
+            return true;
+    }
+    return false;
+}
+
+void
+CoherentXBar::retryQuantumWaiters()
+{
+    // the retried ports call back into the crossbar right away
+    std::vector<ResponsePort*> waiters;
+    waiters.swap(quantumWaiters);
+    for (auto *port : waiters)
+        port->sendRetryReq();
+}
+
 void
 CoherentXBar::recvReqRetry(PortID mem_side_port_id)
 {
@@ -149,6 +149,19 @@ class CoherentXBar : public BaseXBar
             return xbar.getAddrRanges();
         }
 
+        void
+        getExpressSnoopEventQueues(
+            std::set<EventQueue *> &eqs) const override
+        {
+            xbar.getExpressSnoopEventQueues(eqs);
+        }
+
+        bool
+        originatesSnoops() const override
+        {
+            return xbar.memSideOriginatesSnoops();
+        }
+
     };
 
     /**
@@ -179,6 +192,12 @@ class CoherentXBar : public BaseXBar
          */
         bool isSnooping() const override { return true; }
 
+        void
+        getSnoopEventQueues(std::set<EventQueue *> &eqs) const override
+        {
+            xbar.getSnoopEventQueues(eqs);
+        }
+
         bool
         recvTimingResp(PacketPtr pkt) override
         {
@@ -267,6 +286,61 @@ class CoherentXBar : public BaseXBar
      */
     std::unordered_set<RequestPtr> outstandingSnoop;
 
+    /**
+     * CPU-side ports whose request was refused as it would have
+     * snooped an object on another event queue during a quantum. They
+     * are sent a retry at the next quantum boundary.
+     */
+    std::vector<ResponsePort*> quantumWaiters;
+
+    /**
+     * For each CPU-side port, whether the snoops sent through it may
+     * reach objects on other event queues.
+     */
+    std::vector<bool> crossQueueSnoopers;
+
+    /**
+     * Whether the express snoops we forward to the memory side may
+     * reach objects on other event queues.
+     */
+    bool crossQueueExpressSnoops = false;
+
+    /** Whether any snoops may reach objects on other event queues. */
+    bool crossQueueSnoops = false;
+
+    /**
+     * Find the snoops that may reach objects on other event queues, and
+     * check that all of them can be held back until a quantum boundary.
+     * This must be called from init().
+     */
+    void findCrossQueueSnoops();
+
+    /**
+     * Check if a request would snoop objects on another event queue,
+     * directly or through the express snoop sent to the memory side
+     * when a snooper commits to responding.
+     *
+     * @param pkt The request
+     * @param src_port The CPU-side port the request came from
+     */
+    bool snoopsOtherQueues(const PacketPtr pkt,
+                           const ResponsePort &src_port) const;
+
+    /**
+     * Collect the event queues that snoops and express snoops sent to
+     * the crossbar may reach, see
+     * RequestPort::getSnoopEventQueues() and
+     * ResponsePort::getExpressSnoopEventQueues().
+     */
+    void getSnoopEventQueues(std::set<EventQueue *> &eqs) const;
+    void getExpressSnoopEventQueues(std::set<EventQueue *> &eqs) const;
+
+    /** Check if any memory-side peer may originate timing snoops. */
+    bool memSideOriginatesSnoops() const;
+
+    /** Retry the ports that waited for a quantum boundary. */
+    void retryQuantumWaiters();
+
     /**
      * Store the outstanding cache maintenance that we are expecting
      * snoop responses from so we can determine when we received all
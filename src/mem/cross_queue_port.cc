@@ -0,0 +1,538 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definition of a port pair that lets a crossbar talk to peers
+ * running on other event queues.
+ */
+
+#include "mem/cross_queue_port.hh"
+
+#include <algorithm>
+#include <tuple>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/CrossQueuePort.hh"
+#include "sim/global_event.hh"
+
+namespace gem5
+{
+
+std::vector<CrossQueuePort *> CrossQueuePort::allPorts;
+std::vector<std::pair<EventQueue *, std::function<void()>>>
+    CrossQueuePort::quantumHooks;
+bool CrossQueuePort::serialPhase = false;
+
+namespace
+{
+
+/**
+ * Act on behalf of another event queue while all other threads are
+ * stopped at a quantum boundary.
+ */
+class ScopedEventQueue
+{
+  public:
+    ScopedEventQueue(EventQueue *eq)
+        : oldEq(curEventQueue())
+    {
+        curEventQueue(eq);
+    }
+
+    ~ScopedEventQueue()
+    {
+        curEventQueue(oldEq);
+    }
+
+  private:
+    EventQueue *oldEq;
+};
+
+/** Find the request or the response side of a connection. */
+template <typename PortType>
+PortType &
+connectionSide(Port &port)
+{
+    fatal_if(!port.isConnected(), "Can't splice unconnected port %s.",
+             port.name());
+
+    auto *side = dynamic_cast<PortType *>(&port);
+    if (!side)
+        side = dynamic_cast<PortType *>(&port.getPeer());
+    panic_if(!side, "Can't splice port %s, unknown port types.",
+             port.name());
+    return *side;
+}
+
+} // anonymous namespace
+
+CrossQueuePort::CrossQueuePort(Port &xbar_port, EventQueue *xbar_eq,
+                               EventQueue *peer_eq, unsigned capacity)
+    : _name(xbar_port.name() + ".cross_queue"),
+      // The port facing each side takes the name of the port it
+      // replaces so that statistics, which are named after the peer of
+      // each crossbar port, remain the same.
+      responsePort(connectionSide<ResponsePort>(xbar_port).name(), *this),
+      requestPort(connectionSide<RequestPort>(xbar_port).name(), *this),
+      xbarDownstream(dynamic_cast<ResponsePort *>(&xbar_port) != nullptr),
+      capacity(capacity)
+{
+    fatal_if(capacity == 0, "%s: Can't put aside any packets.", name());
+
+    upstreamEq = xbarDownstream ? peer_eq : xbar_eq;
+    downstreamEq = xbarDownstream ? xbar_eq : peer_eq;
+
+    // Insert ourselves in the middle of the connection.
+    auto &request_port = connectionSide<RequestPort>(xbar_port);
+    auto &response_port = connectionSide<ResponsePort>(xbar_port);
+    request_port.unbind();
+    request_port.bind(responsePort);
+    requestPort.bind(response_port);
+
+    registerQuantumCallback();
+    allPorts.push_back(this);
+
+    DPRINTF(CrossQueuePort, "Spliced %s (eventq %s) -> %s (eventq %s)\n",
+            request_port.name(), upstreamEq->name(),
+            response_port.name(), downstreamEq->name());
+}
+
+CrossQueuePort::~CrossQueuePort()
+{
+    allPorts.erase(std::remove(allPorts.begin(), allPorts.end(), this),
+                   allPorts.end());
+}
+
+void
+CrossQueuePort::registerQuantumCallback()
+{
+    static bool registered = false;
+    if (!registered) {
+        GlobalSyncEvent::quantumCallbacks().push_back(processAll);
+        registered = true;
+    }
+}
+
+void
+CrossQueuePort::addQuantumHook(EventQueue *eq, std::function<void()> hook)
+{
+    registerQuantumCallback();
+    quantumHooks.emplace_back(eq, std::move(hook));
+}
+
+bool
+CrossQueuePort::mayCall(bool downstream) const
+{
+    if (synchronized())
+        return true;
+
+    return (downstream ? downstreamEq : upstreamEq) == curEventQueue();
+}
+
+bool
+CrossQueuePort::isLocal() const
+{
+    return synchronized() || upstreamEq == downstreamEq;
+}
+
+template <typename F>
+auto
+CrossQueuePort::callOn(bool downstream, F &&f)
+{
+    EventQueue *eq = downstream ? downstreamEq : upstreamEq;
+
+    if (!inParallelMode) {
+        return f();
+    } else if (serialPhase) {
+        ScopedEventQueue switch_eq(eq);
+        return f();
+    } else {
+        EventQueue::ScopedMigration migrate(eq);
+        return f();
+    }
+}
+
+bool
+CrossQueuePort::forward(LaneId id, PacketPtr pkt)
+{
+    return callOn(isDownstream(id), [this, id, pkt]()
+    {
+        switch (id) {
+          case ReqLane:
+            return requestPort.sendTimingReq(pkt);
+          case SnoopRespLane:
+            return requestPort.sendTimingSnoopResp(pkt);
+          case RespLane:
+            return responsePort.sendTimingResp(pkt);
+          default:
+            panic("%s: Unknown lane %d.", name(), id);
+        }
+    });
+}
+
+bool
+CrossQueuePort::recvTiming(LaneId id, PacketPtr pkt)
+{
+    const bool downstream = isDownstream(id);
+    Lane &lane = lanes[id];
+
+    // Express snoops can neither be refused nor delayed. Coherent
+    // crossbars hold back the requests that may cause them until a
+    // quantum boundary, see CoherentXBar::snoopsOtherQueues().
+    if (id == ReqLane && pkt->isExpressSnoop()) {
+        panic_if(!mayCall(downstream), "%s: Express snoop %s can't cross "
+                 "event queues during a quantum.", name(), pkt->print());
+        [[maybe_unused]] bool success = forward(id, pkt);
+        assert(success);
+        return true;
+    }
+
+    if (mayCall(downstream)) {
+        if (lane.pkts.empty() && !lane.blocked) {
+            if (forward(id, pkt))
+                return true;
+            lane.blocked = true;
+        }
+        lane.callerWaiting = true;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (lane.pkts.size() >= capacity) {
+        DPRINTF(CrossQueuePort, "%s: Lane %d full, refusing %s\n", name(),
+                id, pkt->print());
+        // The retry is sent once the lane has been delivered at the
+        // next quantum boundary.
+        lane.callerWaiting = true;
+        return false;
+    }
+
+    DPRINTF(CrossQueuePort, "%s: Deferring %s on lane %d\n", name(),
+            pkt->print(), id);
+    lane.pkts.emplace_back(curTick(), pkt);
+    return true;
+}
+
+void
+CrossQueuePort::recvRetry(LaneId id)
+{
+    Lane &lane = lanes[id];
+
+    if (isLocal() && mayCall(isDownstream(id))) {
+        lane.blocked = false;
+        deliver(id);
+    } else {
+        // The packets are handed over at the next quantum boundary.
+        std::lock_guard<std::mutex> lock(mutex);
+        lane.blocked = false;
+    }
+}
+
+void
+CrossQueuePort::sendRetry(LaneId id)
+{
+    const bool downstream = isDownstream(id);
+    Lane &lane = lanes[id];
+
+    lane.callerWaiting = false;
+    if (!mayCall(!downstream)) {
+        lane.forwardRetry = true;
+        return;
+    }
+
+    lane.forwardRetry = false;
+    callOn(!downstream, [this, id]()
+    {
+        switch (id) {
+          case ReqLane:
+            responsePort.sendRetryReq();
+            break;
+          case SnoopRespLane:
+            responsePort.sendRetrySnoopResp();
+            break;
+          case RespLane:
+            requestPort.sendRetryResp();
+            break;
+          default:
+            panic("%s: Unknown lane %d.", name(), id);
+        }
+    });
+}
+
+void
+CrossQueuePort::deliver(LaneId id)
+{
+    Lane &lane = lanes[id];
+
+    // The callee may call back into us while we deliver a packet.
+    if (lane.delivering)
+        return;
+
+    lane.delivering = true;
+    while (!lane.pkts.empty() && !lane.blocked) {
+        PacketPtr pkt = lane.pkts.front().second;
+        if (!forward(id, pkt)) {
+            lane.blocked = true;
+            break;
+        }
+        lane.pkts.pop_front();
+    }
+    lane.delivering = false;
+
+    if (lane.callerWaiting && lane.pkts.empty() && !lane.blocked)
+        sendRetry(id);
+}
+
+bool
+CrossQueuePort::isEmpty() const
+{
+    for (const auto &lane : lanes) {
+        if (!lane.pkts.empty() || lane.callerWaiting || lane.forwardRetry)
+            return false;
+    }
+    return true;
+}
+
+DrainState
+CrossQueuePort::drain()
+{
+    return isEmpty() ? DrainState::Drained : DrainState::Draining;
+}
+
+void
+CrossQueuePort::processAll()
+{
+    serialPhase = true;
+
+    // Deliver the lanes in the order their oldest packet was received
+    // in, breaking ties by port creation order and lane, so the result
+    // does not depend on the thread scheduling.
+    std::vector<std::tuple<Tick, size_t, LaneId>> pending;
+    for (size_t i = 0; i < allPorts.size(); ++i) {
+        for (int id = 0; id < NumLanes; ++id) {
+            const Lane &lane = allPorts[i]->lanes[id];
+            if (!lane.pkts.empty() && !lane.blocked)
+                pending.emplace_back(lane.pkts.front().first, i,
+                                     static_cast<LaneId>(id));
+        }
+    }
+    std::sort(pending.begin(), pending.end());
+
+    for (const auto &[tick, i, id] : pending)
+        allPorts[i]->deliver(id);
+
+    for (auto &[eq, hook] : quantumHooks) {
+        ScopedEventQueue switch_eq(eq);
+        hook();
+    }
+
+    for (auto *port : allPorts) {
+        for (int id = 0; id < NumLanes; ++id) {
+            if (port->lanes[id].forwardRetry)
+                port->sendRetry(static_cast<LaneId>(id));
+        }
+    }
+
+    for (auto *port : allPorts) {
+        if (port->drainState() == DrainState::Draining && port->isEmpty())
+            port->signalDrainDone();
+    }
+
+    serialPhase = false;
+}
+
+bool
+CrossQueuePort::CrossQueueResponsePort::recvTimingReq(PacketPtr pkt)
+{
+    return parent.recvTiming(ReqLane, pkt);
+}
+
+bool
+CrossQueuePort::CrossQueueResponsePort::recvTimingSnoopResp(PacketPtr pkt)
+{
+    return parent.recvTiming(SnoopRespLane, pkt);
+}
+
+bool
+CrossQueuePort::CrossQueueResponsePort::tryTiming(PacketPtr pkt)
+{
+    const Lane &lane = parent.lanes[ReqLane];
+
+    // Deferred packets are accepted as long as there is room for them.
+    if (!parent.mayCall(true)) {
+        std::lock_guard<std::mutex> lock(parent.mutex);
+        return lane.pkts.size() < parent.capacity;
+    }
+
+    if (!lane.pkts.empty() || lane.blocked)
+        return false;
+
+    return parent.callOn(true, [this, pkt]()
+    {
+        return parent.requestPort.tryTiming(pkt);
+    });
+}
+
+void
+CrossQueuePort::CrossQueueResponsePort::recvRespRetry()
+{
+    parent.recvRetry(RespLane);
+}
+
+Tick
+CrossQueuePort::CrossQueueResponsePort::recvAtomic(PacketPtr pkt)
+{
+    return parent.callOn(true, [this, pkt]()
+    {
+        return parent.requestPort.sendAtomic(pkt);
+    });
+}
+
+Tick
+CrossQueuePort::CrossQueueResponsePort::recvAtomicBackdoor(
+        PacketPtr pkt, MemBackdoorPtr &backdoor)
+{
+    return parent.callOn(true, [this, pkt, &backdoor]()
+    {
+        return parent.requestPort.sendAtomicBackdoor(pkt, backdoor);
+    });
+}
+
+void
+CrossQueuePort::CrossQueueResponsePort::recvFunctional(PacketPtr pkt)
+{
+    parent.callOn(true, [this, pkt]()
+    {
+        parent.requestPort.sendFunctional(pkt);
+    });
+}
+
+void
+CrossQueuePort::CrossQueueResponsePort::recvMemBackdoorReq(
+        const MemBackdoorReq &req, MemBackdoorPtr &backdoor)
+{
+    parent.callOn(true, [this, &req, &backdoor]()
+    {
+        parent.requestPort.sendMemBackdoorReq(req, backdoor);
+    });
+}
+
+AddrRangeList
+CrossQueuePort::CrossQueueResponsePort::getAddrRanges() const
+{
+    return parent.requestPort.getAddrRanges();
+}
+
+void
+CrossQueuePort::CrossQueueResponsePort::getExpressSnoopEventQueues(
+        std::set<EventQueue *> &eqs) const
+{
+    parent.requestPort.getPeerExpressSnoopEventQueues(eqs);
+}
+
+bool
+CrossQueuePort::CrossQueueResponsePort::originatesSnoops() const
+{
+    return parent.requestPort.peerOriginatesSnoops();
+}
+
+bool
+CrossQueuePort::CrossQueueRequestPort::recvTimingResp(PacketPtr pkt)
+{
+    return parent.recvTiming(RespLane, pkt);
+}
+
+void
+CrossQueuePort::CrossQueueRequestPort::recvTimingSnoopReq(PacketPtr pkt)
+{
+    // Snoops have to be handled right away, so they can only cross
+    // event queues while all other threads are stopped. Coherent
+    // crossbars hold back the requests that cause them until a quantum
+    // boundary, and refuse configurations where other snoops could
+    // cross, see CoherentXBar::findCrossQueueSnoops().
+    panic_if(!parent.mayCall(false), "%s: Snoop %s can't cross event "
+             "queues during a quantum.", parent.name(), pkt->print());
+
+    parent.callOn(false, [this, pkt]()
+    {
+        parent.responsePort.sendTimingSnoopReq(pkt);
+    });
+}
+
+void
+CrossQueuePort::CrossQueueRequestPort::recvReqRetry()
+{
+    parent.recvRetry(ReqLane);
+}
+
+void
+CrossQueuePort::CrossQueueRequestPort::recvRetrySnoopResp()
+{
+    parent.recvRetry(SnoopRespLane);
+}
+
+Tick
+CrossQueuePort::CrossQueueRequestPort::recvAtomicSnoop(PacketPtr pkt)
+{
+    return parent.callOn(false, [this, pkt]()
+    {
+        return parent.responsePort.sendAtomicSnoop(pkt);
+    });
+}
+
+void
+CrossQueuePort::CrossQueueRequestPort::recvFunctionalSnoop(PacketPtr pkt)
+{
+    parent.callOn(false, [this, pkt]()
+    {
+        parent.responsePort.sendFunctionalSnoop(pkt);
+    });
+}
+
+void
+CrossQueuePort::CrossQueueRequestPort::recvRangeChange()
+{
+    parent.responsePort.sendRangeChange();
+}
+
+bool
+CrossQueuePort::CrossQueueRequestPort::isSnooping() const
+{
+    return parent.responsePort.isSnooping();
+}
+
+void
+CrossQueuePort::CrossQueueRequestPort::getSnoopEventQueues(
+        std::set<EventQueue *> &eqs) const
+{
+    parent.responsePort.getPeerSnoopEventQueues(eqs);
+}
+
+} // namespace gem5
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a port pair that lets a crossbar talk to peers
+ * running on other event queues.
+ */
+
+#ifndef __MEM_CROSS_QUEUE_PORT_HH__
+#define __MEM_CROSS_QUEUE_PORT_HH__
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mem/port.hh"
+#include "sim/drain.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+/**
+ * A CrossQueuePort is spliced between a crossbar port and its peer
+ * when the peer runs on a different event queue than the crossbar. It
+ * acts as a zero-latency wire whenever the caller and the callee may
+ * safely interact, that is, when the simulation is not running in
+ * parallel, or at a quantum boundary while all other threads are
+ * stopped.
+ *
+ * Any other timing request, response and snoop response is accepted
+ * and put aside until the next quantum boundary, at which point the
+ * pending packets of all cross-queue ports are delivered in (tick,
+ * port, packet type) order on a single thread. Since packets crossing
+ * a queue boundary therefore see up to one quantum of extra latency,
+ * the result only depends on the partitioning and the quantum, not on
+ * the host thread scheduling. Each packet type can only have a limited
+ * number of packets put aside. Once that limit is reached, further
+ * packets are refused and the caller is sent a retry when the packets
+ * have been delivered.
+ *
+ * Snoop requests must be handled synchronously and are only allowed
+ * to cross a queue boundary at a quantum boundary. A coherent
+ * crossbar therefore refuses requests from its local peers that would
+ * snoop a remote peer during a quantum, and retries them at the next
+ * quantum boundary, see addQuantumHook().
+ *
+ * Atomic and functional accesses are forwarded immediately by
+ * temporarily migrating to the callee's event queue, as done by the
+ * ThreadBridge.
+ */
+class CrossQueuePort : public Drainable
+{
+  public:
+    /**
+     * Splice a new cross-queue port between a crossbar port and its
+     * peer. The crossbar port and its peer keep their names and
+     * ports, so statistics and traces are not affected.
+     *
+     * @param xbar_port Crossbar port to splice
+     * @param xbar_eq Event queue of the crossbar
+     * @param peer_eq Event queue of the peer of xbar_port
+     * @param capacity Packets of each type that can be put aside
+     */
+    CrossQueuePort(Port &xbar_port, EventQueue *xbar_eq,
+                   EventQueue *peer_eq, unsigned capacity);
+
+    ~CrossQueuePort();
+
+    const std::string &name() const { return _name; }
+
+    DrainState drain() override;
+
+    /**
+     * Check if objects on different event queues may interact
+     * synchronously right now, that is, if the simulation is not
+     * running in parallel or all threads are stopped at a quantum
+     * boundary.
+     */
+    static bool
+    synchronized()
+    {
+        return !inParallelMode || serialPhase;
+    }
+
+    /**
+     * Register a function to call at every quantum boundary, once the
+     * pending packets have been delivered. The function runs while
+     * all other threads are stopped, on behalf of the given event
+     * queue. Hooks must be added during initialization and are called
+     * in the order they were added.
+     *
+     * @param eq Event queue to act on behalf of
+     * @param hook Function to call
+     */
+    static void addQuantumHook(EventQueue *eq, std::function<void()> hook);
+
+  private:
+    /** Packet types that can be put aside until a quantum boundary. */
+    enum LaneId
+    {
+        ReqLane,
+        SnoopRespLane,
+        RespLane,
+        NumLanes
+    };
+
+    struct Lane
+    {
+        //! Packets put aside, and the tick they were received at
+        std::deque<std::pair<Tick, PacketPtr>> pkts;
+        //! The callee refused the packet at the head of the lane
+        bool blocked = false;
+        //! We refused a packet and owe the caller a retry
+        bool callerWaiting = false;
+        //! A retry for the caller that has to wait for a quantum boundary
+        bool forwardRetry = false;
+        //! The lane is currently being delivered
+        bool delivering = false;
+    };
+
+    class CrossQueueResponsePort : public ResponsePort
+    {
+      public:
+        CrossQueueResponsePort(const std::string &_name,
+                               CrossQueuePort &_parent)
+            : ResponsePort(_name), parent(_parent)
+        { }
+
+      protected:
+        bool recvTimingReq(PacketPtr pkt) override;
+        bool recvTimingSnoopResp(PacketPtr pkt) override;
+        bool tryTiming(PacketPtr pkt) override;
+        void recvRespRetry() override;
+        Tick recvAtomic(PacketPtr pkt) override;
+        Tick recvAtomicBackdoor(PacketPtr pkt,
+                                MemBackdoorPtr &backdoor) override;
+        void recvFunctional(PacketPtr pkt) override;
+        void recvMemBackdoorReq(const MemBackdoorReq &req,
+                                MemBackdoorPtr &backdoor) override;
+        AddrRangeList getAddrRanges() const override;
+        void getExpressSnoopEventQueues(
+            std::set<EventQueue *> &eqs) const override;
+        bool originatesSnoops() const override;
+
+      private:
+        CrossQueuePort &parent;
+    };
+
+    class CrossQueueRequestPort : public RequestPort
+    {
+      public:
+        CrossQueueRequestPort(const std::string &_name,
+                              CrossQueuePort &_parent)
+            : RequestPort(_name), parent(_parent)
+        { }
+
+      protected:
+        bool recvTimingResp(PacketPtr pkt) override;
+        void recvTimingSnoopReq(PacketPtr pkt) override;
+        void recvReqRetry() override;
+        void recvRetrySnoopResp() override;
+        Tick recvAtomicSnoop(PacketPtr pkt) override;
+        void recvFunctionalSnoop(PacketPtr pkt) override;
+        void recvRangeChange() override;
+        bool isSnooping() const override;
+        void getSnoopEventQueues(
+            std::set<EventQueue *> &eqs) const override;
+
+      private:
+        CrossQueuePort &parent;
+    };
+
+    static bool
+    isDownstream(LaneId id)
+    {
+        return id != RespLane;
+    }
+
+    /**
+     * Check if the calling thread may call into the upstream or
+     * downstream side right now.
+     */
+    bool mayCall(bool downstream) const;
+
+    /**
+     * Check if the lanes can only be accessed by the calling thread,
+     * so that pending packets may be delivered right away.
+     */
+    bool isLocal() const;
+
+    /**
+     * Call a function on behalf of the upstream or downstream side,
+     * switching or migrating to its event queue if needed.
+     */
+    template <typename F>
+    auto callOn(bool downstream, F &&f);
+
+    bool recvTiming(LaneId id, PacketPtr pkt);
+    bool forward(LaneId id, PacketPtr pkt);
+    void recvRetry(LaneId id);
+    void sendRetry(LaneId id);
+
+    /** Deliver as many packets of a lane as the callee accepts. */
+    void deliver(LaneId id);
+
+    bool isEmpty() const;
+
+    /**
+     * Deliver the pending packets and retries of all cross-queue
+     * ports, and call the quantum hooks. This is registered as a
+     * quantum callback of the GlobalSyncEvent.
+     */
+    static void processAll();
+
+    /** Register processAll() with the GlobalSyncEvent, once. */
+    static void registerQuantumCallback();
+
+    const std::string _name;
+
+    CrossQueueResponsePort responsePort;
+    CrossQueueRequestPort requestPort;
+
+    //! Event queues of the upstream and downstream objects
+    EventQueue *upstreamEq;
+    EventQueue *downstreamEq;
+
+    //! Is the crossbar the downstream or the upstream object?
+    const bool xbarDownstream;
+
+    //! Packets of each type that can be put aside
+    const unsigned capacity;
+
+    Lane lanes[NumLanes];
+
+    //! Protects the lanes while both sides run in parallel
+    std::mutex mutex;
+
+    //! All cross-queue ports, in creation order
+    static std::vector<CrossQueuePort *> allPorts;
+    //! Functions to call at every quantum boundary, in order
+    static std::vector<std::pair<EventQueue *, std::function<void()>>>
+        quantumHooks;
+    //! True while the pending packets are delivered at a quantum boundary
+    static bool serialPhase;
+};
+
+} // namespace gem5
+
+#endif //__MEM_CROSS_QUEUE_PORT_HH__
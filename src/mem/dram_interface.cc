@@ -59,116 +59,24 @@ namespace memory
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
 {
-    std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
-
-    // Has minBankPrep been called to populate earliest_banks?
-    bool filled_earliest_banks = false;
-    // can the PRE/ACT sequence be done without impacting utlization?
-    bool hidden_bank_prep = false;
-
-    // search for seamless row hits first, if no seamless row hit is
-    // found then determine if there are other packets that can be issued
-    // without incurring additional bus delay due to bank timing
-    // Will select closed rows first to enable more open row possibilies
-    // in future selections
-    bool found_hidden_bank = false;
-
-    // remember if we found a row hit, not seamless, but bank prepped
-    // and ready
-    bool found_prepped_pkt = false;
-
-    // if we have no row hit, prepped or not, and no seamless packet,
-    // just go for the earliest possible
-    bool found_earliest_pkt = false;
-
-    Tick selected_col_at = MaxTick;
-    auto selected_pkt_it = queue.end();
-
-    for (auto i = queue.begin(); i != queue.end() ; ++i) {
-        MemPacket* pkt = *i;
-
-        // select optimal DRAM packet in Q
-        if (pkt->isDram() && (pkt->pseudoChannel == pseudoChannel)) {
-            const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
-            const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
-                                                        bank.wrAllowedAt;
-
-            DPRINTF(DRAM, "%s checking DRAM packet in bank %d, row %d\n",
-                    __func__, pkt->bank, pkt->row);
-
-            // check if rank is not doing a refresh and thus is available,
-            // if not, jump to the next packet
-            if (burstReady(pkt)) {
-
-                DPRINTF(DRAM,
-                        "%s bank %d - Rank %d available\n", __func__,
-                        pkt->bank, pkt->rank);
-
-                // check if it is a row hit
-                if (bank.openRow == pkt->row) {
-                    // no additional rank-to-rank or same bank-group
-                    // delays, or we switched read/write and might as well
-                    // go for the row hit
-                    if (col_allowed_at <= min_col_at) {
-                        // FCFS within the hits, giving priority to
-                        // commands that can issue seamlessly, without
-                        // additional delay, such as same rank accesses
-                        // and/or different bank-group accesses
-                        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        // no need to look through the remaining queue entries
-                        break;
-                    } else if (!found_hidden_bank && !found_prepped_pkt) {
-                        // if we did not find a packet to a closed row that can
-                        // issue the bank commands without incurring delay, and
-                        // did not yet find a packet to a prepped row, remember
-                        // the current one
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        found_prepped_pkt = true;
-                        DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
-                    }
-                } else if (!found_earliest_pkt) {
-                    // if we have not initialised the bank status, do it
-                    // now, and only once per scheduling decisions
-                    if (!filled_earliest_banks) {
-                        // determine entries with earliest bank delay
-                        std::tie(earliest_banks, hidden_bank_prep) =
-                            minBankPrep(queue, min_col_at);
-                        filled_earliest_banks = true;
-                    }
-
-                    // bank is amongst first available banks
-                    // minBankPrep will give priority to packets that can
-                    // issue seamlessly
-                    if (bits(earliest_banks[pkt->rank],
-                             pkt->bank, pkt->bank)) {
-                        found_earliest_pkt = true;
-                        found_hidden_bank = hidden_bank_prep;
-
-                        // give priority to packets that can issue
-                        // bank commands 'behind the scenes'
-                        // any additional delay if any will be due to
-                        // col-to-col command requirements
-                        if (hidden_bank_prep || !found_prepped_pkt) {
-                            selected_pkt_it = i;
-                            selected_col_at = col_allowed_at;
-                        }
-                    }
-                }
-            } else {
-                DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
-                        pkt->bank, pkt->rank);
-            }
-        }
-    }
-
-    if (selected_pkt_it == queue.end()) {
+    auto selected = queue.chooseNextFRFCFS(pseudoChannel, ranksPerChannel,
+        banksPerRank, min_col_at,
+        [this](int rank) { return ranks[rank]->inRefIdleState(); },
+        [this](int rank, int bank) -> const Bank& {
+            return ranks[rank]->banks[bank];
+        },
+        [this, &queue, min_col_at]() {
+            return minBankPrep(queue, min_col_at);
+        });
+
+    if (selected.first == queue.end()) {
         DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+    } else {
+        DPRINTF(DRAM, "%s selected bank %d, row %d, column at %d\n",
+                __func__, (*selected.first)->bank, (*selected.first)->row,
+                selected.second);
     }
-
-    return std::make_pair(selected_pkt_it, selected_col_at);
+    return selected;
 }
 
 void
@@ -658,6 +566,7 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
       timeStampOffset(0), activeRank(0),
       enableDRAMPowerdown(_p.enable_dram_powerdown),
       lastStatsResetTick(0),
+      enableCoalesceRefresh(_p.coalesce_refresh), refreshCoalesced(false),
       stats(*this)
 {
     DPRINTF(DRAM, "Setting up DRAM Interface\n");
@@ -1019,11 +928,81 @@ DRAMInterface::allRanksDrained() const
 void
 DRAMInterface::suspend()
 {
+    catchUpRefresh(true);
+
     for (auto r : ranks) {
         r->suspend();
     }
 }
 
+void
+DRAMInterface::coalesceRefresh()
+{
+    if (refreshCoalesced || enableDRAMPowerdown || !enableCoalesceRefresh)
+        return;
+
+    for (auto r : ranks) {
+        if (!r->canCoalesceRefresh())
+            return;
+    }
+
+    DPRINTF(DRAMState, "Coalescing the refresh events of all ranks\n");
+
+    for (auto r : ranks) {
+        r->coalesceRefresh();
+    }
+    refreshCoalesced = true;
+}
+
+void
+DRAMInterface::catchUpRefresh(bool wake_up)
+{
+    if (!refreshCoalesced)
+        return;
+
+    // Replay the transitions of all ranks in order, including those at
+    // the current tick, which happen before a request is taken
+    unsigned restarts = 0;
+    Tick last_restart = MaxTick;
+    while (true) {
+        Rank *next = nullptr;
+        for (auto r : ranks) {
+            if (r->coalescedRefreshAt <= curTick() &&
+                (!next || r->coalescedRefreshAt < next->coalescedRefreshAt))
+                next = r;
+        }
+        if (!next)
+            break;
+
+        const Tick tick = next->coalescedRefreshAt;
+        if (!next->replayRefresh() || tick == last_restart)
+            continue;
+
+        // The first rank to complete a refresh restarts the scheduler,
+        // which finds nothing to do but recording that the bus stays in
+        // its state. Ranks completing at the same tick find it already
+        // scheduled.
+        last_restart = tick;
+        if (wake_up && tick == curTick()) {
+            // the scheduler will take the request at this tick
+            if (!ctrl->requestEventScheduled(pseudoChannel))
+                ctrl->restartScheduler(tick, pseudoChannel);
+        } else {
+            ++restarts;
+        }
+    }
+    ctrl->recordIdleRestarts(this, restarts);
+
+    if (wake_up) {
+        DPRINTF(DRAMState, "Resuming the refresh events of all ranks\n");
+
+        for (auto r : ranks) {
+            r->resumeRefresh();
+        }
+        refreshCoalesced = false;
+    }
+}
+
 std::pair<std::vector<uint32_t>, bool>
 DRAMInterface::minBankPrep(const MemPacketQueue& queue,
                       Tick min_col_at) const
@@ -1038,27 +1017,17 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
     // delay on the data bus
     bool hidden_bank_prep = false;
 
-    // determine if we have queued transactions targetting the
-    // bank in question
-    std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->pseudoChannel != pseudoChannel)
-            continue;
-        if (p->isDram() && ranks[p->rank]->inRefIdleState())
-            got_waiting[p->bankId] = true;
-    }
-
     // Find command with optimal bank timing
     // Will prioritize commands that can issue seamlessly.
     for (int i = 0; i < ranksPerChannel; i++) {
         for (int j = 0; j < banksPerRank; j++) {
             uint16_t bank_id = i * banksPerRank + j;
 
-            // if we have waiting requests for the bank, and it is
-            // amongst the first available, update the mask
-            if (got_waiting[bank_id]) {
-                // make sure this rank is not currently refreshing.
-                assert(ranks[i]->inRefIdleState());
+            // if we have waiting requests for the bank, in a rank that
+            // is not currently refreshing, and it is amongst the first
+            // available, update the mask
+            if (ranks[i]->inRefIdleState() &&
+                !queue.bankQueue(pseudoChannel, bank_id).empty()) {
                 // simplistic approximation of when the bank can issue
                 // an activate, ignoring any rank-to-rank switching
                 // cost in this calculation
@@ -1124,6 +1093,7 @@ DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
       readEntries(0), writeEntries(0), outstandingEvents(0),
       wakeUpAllowedAt(0), power(_p, false), banks(_p.banks_per_rank),
       numBanksActive(0), actTicks(_p.activation_limit, 0), lastBurstTick(0),
+      coalescedRefreshAt(MaxTick),
       writeDoneEvent([this]{ processWriteDoneEvent(); }, name()),
       activateEvent([this]{ processActivateEvent(); }, name()),
       prechargeEvent([this]{ processPrechargeEvent(); }, name()),
@@ -1171,12 +1141,88 @@ DRAMInterface::Rank::suspend()
     deschedule(refreshEvent);
 
     // Update the stats
-    updatePowerStats();
+    updatePowerStats(curTick());
 
     // don't automatically transition back to LP state after next REF
     pwrStatePostRefresh = PWR_IDLE;
 }
 
+bool
+DRAMInterface::Rank::canCoalesceRefresh() const
+{
+    return pwrState == PWR_IDLE && refreshState == REF_IDLE &&
+        pwrStatePostRefresh == PWR_IDLE && !inLowPowerState &&
+        numBanksActive == 0 && outstandingEvents == 0 &&
+        readEntries == 0 && writeEntries == 0 && refreshEvent.scheduled() &&
+        !powerEvent.scheduled() && !activateEvent.scheduled() &&
+        !prechargeEvent.scheduled() && !wakeUpEvent.scheduled() &&
+        !writeDoneEvent.scheduled();
+}
+
+void
+DRAMInterface::Rank::coalesceRefresh()
+{
+    coalescedRefreshAt = refreshEvent.when();
+    deschedule(refreshEvent);
+}
+
+bool
+DRAMInterface::Rank::replayRefresh()
+{
+    const Tick tick = coalescedRefreshAt;
+
+    if (refreshState == REF_IDLE) {
+        // the banks are closed and the rank is idle, so the refresh
+        // starts as soon as it is due, as in processRefreshEvent
+        refreshDueAt = tick;
+        ++outstandingEvents;
+
+        stats.pwrStateTime[pwrState] += tick - pwrStateTick;
+        pwrState = PWR_REF;
+        pwrStateTick = tick;
+
+        Tick ref_done_at = tick + dram.tRFC;
+
+        for (auto &b : banks) {
+            b.actAllowedAt = ref_done_at;
+        }
+
+        cmdList.push_back(Command(MemCommand::REF, 0, tick));
+
+        // Update the stats
+        updatePowerStats(tick);
+
+        DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(tick, dram.tCK) -
+                dram.timeStampOffset, rank);
+
+        refreshDueAt += dram.tREFI;
+        refreshState = REF_RUN;
+        coalescedRefreshAt = ref_done_at;
+        return false;
+    }
+
+    // the refresh is done, go back to the idle power state and
+    // compensate for the delay of the refresh, as in processPowerEvent
+    assert(refreshState == REF_RUN && pwrState == PWR_REF);
+    assert(outstandingEvents == 1);
+
+    stats.pwrStateTime[pwrState] += tick - pwrStateTick;
+    pwrState = PWR_IDLE;
+    pwrStateTick = tick;
+
+    --outstandingEvents;
+    refreshState = REF_IDLE;
+    coalescedRefreshAt = refreshDueAt - dram.tRP;
+    return true;
+}
+
+void
+DRAMInterface::Rank::resumeRefresh()
+{
+    schedule(refreshEvent, coalescedRefreshAt);
+    coalescedRefreshAt = MaxTick;
+}
+
 bool
 DRAMInterface::Rank::isQueueEmpty() const
 {
@@ -1204,7 +1250,7 @@ DRAMInterface::Rank::checkDrainDone()
 }
 
 void
-DRAMInterface::Rank::flushCmdList()
+DRAMInterface::Rank::flushCmdList(Tick tick)
 {
     // at the moment sort the list of commands and update the counters
     // for DRAMPower libray when doing a refresh
@@ -1214,19 +1260,19 @@ DRAMInterface::Rank::flushCmdList()
     // push to commands to DRAMPower
     for ( ; next_iter != cmdList.end() ; ++next_iter) {
          Command cmd = *next_iter;
-         if (cmd.timeStamp <= curTick()) {
-             // Move all commands at or before curTick to DRAMPower
+         if (cmd.timeStamp <= tick) {
+             // Move all commands at or before tick to DRAMPower
              power.powerlib.doCommand(cmd.type, cmd.bank,
                                       divCeil(cmd.timeStamp, dram.tCK) -
                                       dram.timeStampOffset);
          } else {
-             // done - found all commands at or before curTick()
-             // next_iter references the 1st command after curTick
+             // done - found all commands at or before tick
+             // next_iter references the 1st command after tick
              break;
          }
     }
-    // reset cmdList to only contain commands after curTick
-    // if there are no commands after curTick, updated cmdList will be empty
+    // reset cmdList to only contain commands after tick
+    // if there are no commands after tick, updated cmdList will be empty
     // in this case, next_iter is cmdList.end()
     cmdList.assign(next_iter, cmdList.end());
 }
@@ -1414,7 +1460,7 @@ DRAMInterface::Rank::processRefreshEvent()
         cmdList.push_back(Command(MemCommand::REF, 0, curTick()));
 
         // Update the stats
-        updatePowerStats();
+        updatePowerStats(curTick());
 
         DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(curTick(), dram.tCK) -
                 dram.timeStampOffset, rank);
@@ -1764,17 +1810,17 @@ DRAMInterface::Rank::processPowerEvent()
 }
 
 void
-DRAMInterface::Rank::updatePowerStats()
+DRAMInterface::Rank::updatePowerStats(Tick tick)
 {
     // All commands up to refresh have completed
     // flush cmdList to DRAMPower
-    flushCmdList();
+    flushCmdList(tick);
 
     // Call the function that calculates window energy at intermediate update
     // events like at refresh, stats dump as well as at simulation exit.
     // Window starts at the last time the calcWindowEnergy function was called
-    // and is upto current time.
-    power.powerlib.calcWindowEnergy(divCeil(curTick(), dram.tCK) -
+    // and is upto the given time.
+    power.powerlib.calcWindowEnergy(divCeil(tick, dram.tCK) -
                                     dram.timeStampOffset);
 
     // Get the energy from DRAMPower
@@ -1802,7 +1848,7 @@ DRAMInterface::Rank::updatePowerStats()
     // power (mW) = ----------- * ----------
     //              time (tick)   tick_frequency
     stats.averagePower = (stats.totalEnergy.value() /
-                    (curTick() - dram.lastStatsResetTick)) *
+                    (tick - dram.lastStatsResetTick)) *
                     (sim_clock::Frequency / 1000000000.0);
 }
 
@@ -1812,7 +1858,7 @@ DRAMInterface::Rank::computeStats()
     DPRINTF(DRAM,"Computing stats due to a dump callback\n");
 
     // Update the stats
-    updatePowerStats();
+    updatePowerStats(curTick());
 
     // final update of power state times
     stats.pwrStateTime[pwrState] += (curTick() - pwrStateTick);
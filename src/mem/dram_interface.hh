@@ -258,8 +258,10 @@ class DRAMInterface : public MemInterface
 
         /**
          * Function to update Power Stats
+         *
+         * @param tick Tick up to which the energy is computed
          */
-        void updatePowerStats();
+        void updatePowerStats(Tick tick);
 
         /**
          * Schedule a power state transition in the future, and
@@ -347,6 +349,13 @@ class DRAMInterface : public MemInterface
          */
         Tick lastBurstTick;
 
+        /**
+         * Tick of the next refresh transition of the rank, i.e., the
+         * start or the end of a refresh, while its refresh events are
+         * coalesced
+         */
+        Tick coalescedRefreshAt;
+
         Rank(const DRAMInterfaceParams &_p, int _rank,
              DRAMInterface& _dram);
 
@@ -369,6 +378,34 @@ class DRAMInterface : public MemInterface
          */
         void suspend();
 
+        /**
+         * Check if the rank only has its periodic refresh left to do,
+         * with all banks closed and no command or transition pending.
+         *
+         * @return true if the refresh events can be coalesced
+         */
+        bool canCoalesceRefresh() const;
+
+        /**
+         * Stop the refresh events, which are then replayed without
+         * events up to the tick the rank is next used at.
+         */
+        void coalesceRefresh();
+
+        /**
+         * Perform the next coalesced refresh transition, exactly as the
+         * refresh and power events would do it when the rank is idle.
+         *
+         * @return true if the transition completed a refresh
+         */
+        bool replayRefresh();
+
+        /**
+         * Schedule the refresh events again from the next coalesced
+         * refresh transition.
+         */
+        void resumeRefresh();
+
         /**
          * Check if there is no refresh and no preparation of refresh ongoing
          * i.e. the refresh state machine is in idle
@@ -425,11 +462,13 @@ class DRAMInterface : public MemInterface
 
         /**
          * Push command out of cmdList queue that are scheduled at
-         * or before curTick() to DRAMPower library
+         * or before the given tick to DRAMPower library
          * All commands before curTick are guaranteed to be complete
          * and can safely be flushed.
+         *
+         * @param tick Tick up to which the commands are flushed
          */
-        void flushCmdList();
+        void flushCmdList(Tick tick);
 
         /**
          * Computes stats just prior to dump event
@@ -551,6 +590,15 @@ class DRAMInterface : public MemInterface
     /** The time when stats were last reset used to calculate average power */
     Tick lastStatsResetTick;
 
+    /** Enable or disable coalescing the refresh events of idle ranks. */
+    bool enableCoalesceRefresh;
+
+    /**
+     * Are the refresh events of the ranks coalesced, as the controller
+     * is idle and the ranks only refresh periodically
+     */
+    bool refreshCoalesced;
+
     /**
      * Keep track of when row activations happen, in order to enforce
      * the maximum number of activations in the activation window. The
@@ -706,6 +754,22 @@ class DRAMInterface : public MemInterface
      */
     void suspend() override;
 
+    /**
+     * Coalesce the refresh events of the ranks if they are all idle,
+     * which is only done when power-down is disabled, as ranks
+     * otherwise sleep in self-refresh without any event
+     */
+    void coalesceRefresh() override;
+
+    /**
+     * Replay the coalesced refreshes of all ranks up to and including
+     * the current tick, and let the controller account for the
+     * scheduler restarts at the end of the refreshes
+     *
+     * @param wake_up Also schedule the refresh events again
+     */
+    void catchUpRefresh(bool wake_up) override;
+
     /*
      * @return time to offset next command
      */
@@ -216,6 +216,10 @@ HBMCtrl::recvTimingReq(PacketPtr pkt)
     panic_if(!(pkt->isRead() || pkt->isWrite()),
                 "Should only see read and writes at memory controller\n");
 
+    // bring the refresh state of the ranks of both pseudo channels
+    // up to date
+    catchUpRefresh(true);
+
     // Calc avg gap between requests
     if (prevArrival != 0) {
         stats.totGap += curTick() - prevArrival;
@@ -460,6 +464,13 @@ HBMCtrl::verifyMultiCmd(Tick cmd_tick, Tick max_cmds_per_burst,
     return cmd_at;
 }
 
+void
+HBMCtrl::catchUpRefresh(bool wake_up)
+{
+    MemCtrl::catchUpRefresh(wake_up);
+    pc1Int->catchUpRefresh(wake_up);
+}
+
 void
 HBMCtrl::drainResume()
 {
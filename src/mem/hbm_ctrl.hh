@@ -71,6 +71,8 @@ class HBMCtrl : public MemCtrl
         return (respQueue.empty() && respQueuePC1.empty());
     }
 
+    void catchUpRefresh(bool wake_up) override;
+
   private:
 
     /**
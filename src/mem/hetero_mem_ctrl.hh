@@ -94,7 +94,7 @@ class HeteroMemCtrl : public MemCtrl
     pktSizeCheck(MemPacket* mem_pkt, MemInterface* mem_intr) const override;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req) override;
 
@@ -121,6 +121,15 @@ class HeteroMemCtrl : public MemCtrl
      */
     virtual bool nvmWriteBlock(MemInterface* mem_intr) override;
 
+    /**
+     * The refresh events are never coalesced, as both interfaces share
+     * the same scheduler
+     */
+    bool canCoalesceRefresh(MemInterface* mem_intr) override
+    {
+        return false;
+    }
+
   public:
 
     HeteroMemCtrl(const HeteroMemCtrlParams &p);
@@ -57,6 +57,26 @@ namespace gem5
 namespace memory
 {
 
+#if USE_MEM_POOLS
+FreeListPool &
+MemPacket::pool()
+{
+    // Never destroyed, since packets may still be freed during exit
+    static FreeListPool *the_pool =
+        new FreeListPool("mem_packet", sizeof(MemPacket));
+    return *the_pool;
+}
+
+namespace
+{
+
+// Create the pool during static initialization, so that it is
+// registered before the pool statistics are set up.
+[[maybe_unused]] FreeListPool &memPacketPool = MemPacket::pool();
+
+} // anonymous namespace
+#endif
+
 MemCtrl::MemCtrl(const MemCtrlParams &p) :
     qos::MemCtrl(p),
     port(name() + ".port", *this), isTimingMode(false),
@@ -416,6 +436,9 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
     panic_if(!(pkt->isRead() || pkt->isWrite()),
              "Should only see read and writes at memory controller\n");
 
+    // bring the refresh state of the ranks up to date
+    catchUpRefresh(true);
+
     // Calc avg gap between requests
     if (prevArrival != 0) {
         stats.totGap += curTick() - prevArrival;
@@ -486,7 +509,7 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
 
 void
 MemCtrl::processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req)
 {
@@ -879,7 +902,7 @@ MemCtrl::nonDetermReads(MemInterface* mem_intr) {
 
 void
 MemCtrl::processNextReqEvent(MemInterface* mem_intr,
-                        MemPacketQueue& resp_queue,
+                        std::deque<MemPacket*>& resp_queue,
                         EventFunctionWrapper& resp_event,
                         EventFunctionWrapper& next_req_event,
                         bool& retry_wr_req) {
@@ -960,7 +983,11 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
                 }
 
                 // nothing to do, not even any point in scheduling an
-                // event for the next request
+                // event for the next request, and until the next one
+                // arrives the ranks only have to refresh
+                if (canCoalesceRefresh(mem_intr)) {
+                    mem_intr->coalesceRefresh();
+                }
                 return;
             }
         } else {
@@ -1425,6 +1452,8 @@ MemCtrl::allIntfDrained() const
 DrainState
 MemCtrl::drain()
 {
+    catchUpRefresh(true);
+
     // if there is anything in any of our internal queues, keep track
     // of that as well
     if (totalWriteQueueSize || totalReadQueueSize || !respQEmpty() ||
@@ -1466,6 +1495,48 @@ MemCtrl::drainResume()
     isTimingMode = system()->isTimingMode();
 }
 
+bool
+MemCtrl::canCoalesceRefresh(MemInterface* mem_intr)
+{
+    // the scheduler must find nothing to do when it is restarted at
+    // the end of a refresh, and must not have any response to send
+    return !turnPolicy && drainState() == DrainState::Running &&
+        mem_intr->busState == READ && mem_intr->busStateNext == READ &&
+        !respondEventScheduled(mem_intr->pseudoChannel) && respQEmpty();
+}
+
+void
+MemCtrl::catchUpRefresh(bool wake_up)
+{
+    dram->catchUpRefresh(wake_up);
+}
+
+void
+MemCtrl::recordIdleRestarts(MemInterface* mem_intr, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i) {
+        recordTurnaroundStats(mem_intr->busState, mem_intr->busStateNext);
+    }
+}
+
+void
+MemCtrl::resetStats()
+{
+    // the coalesced refreshes before the reset must not be accounted
+    // for after it
+    catchUpRefresh(false);
+
+    qos::MemCtrl::resetStats();
+}
+
+void
+MemCtrl::preDumpStats()
+{
+    catchUpRefresh(false);
+
+    qos::MemCtrl::preDumpStats();
+}
+
 AddrRangeList
 MemCtrl::getAddrRanges()
 {
@@ -46,14 +46,18 @@
 #ifndef __MEM_CTRL_HH__
 #define __MEM_CTRL_HH__
 
+#include <algorithm>
 #include <deque>
 #include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "base/callback.hh"
+#include "base/free_list_pool.hh"
 #include "base/statistics.hh"
+#include "config/use_mem_pools.hh"
 #include "enums/MemSched.hh"
 #include "mem/qos/mem_ctrl.hh"
 #include "mem/qport.hh"
@@ -156,6 +160,12 @@ class MemPacket
      */
     uint8_t _qosValue;
 
+    /**
+     * Arrival order of the packet in the MemPacketQueue holding it, set
+     * when the packet is added to the queue
+     */
+    uint64_t queueSeq;
+
     /**
      * Set the packet QoS value
      * (interface compatibility with Packet)
@@ -210,14 +220,224 @@ class MemPacket
           _requestorId(pkt->requestorId()),
           read(is_read), dram(is_dram), pseudoChannel(_channel), rank(_rank),
           bank(_bank), row(_row), bankId(bank_id), addr(_addr), size(_size),
-          burstHelper(NULL), _qosValue(_pkt->qosValue())
+          burstHelper(NULL), _qosValue(_pkt->qosValue()), queueSeq(0)
     { }
 
+#if USE_MEM_POOLS
+    /** Pool the memory packets are allocated from. */
+    static FreeListPool &pool();
+
+    static void *
+    operator new(size_t size)
+    {
+        return pool().allocate(size);
+    }
+
+    static void
+    operator delete(void *ptr, size_t size)
+    {
+        pool().deallocate(ptr, size);
+    }
+#endif
 };
 
-// The memory packets are store in a multiple dequeue structure,
-// based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
+/**
+ * A queue of memory packets, in arrival order. The memory packets are
+ * stored in a multiple dequeue structure, based on their QoS priority.
+ *
+ * Each queue also keeps the DRAM packets it holds in per-bank queues,
+ * indexed by pseudo channel and bank id, that preserve their arrival
+ * order. This lets the FR-FCFS scheduler find the row hits and the
+ * packets to the earliest available banks by looking at each bank,
+ * rather than at each queued packet, while still picking the same
+ * packet as a scan of the whole queue would.
+ */
+class MemPacketQueue
+{
+  public:
+    typedef std::deque<MemPacket*> BankQueue;
+    typedef std::deque<MemPacket*>::iterator iterator;
+    typedef std::deque<MemPacket*>::const_iterator const_iterator;
+
+    iterator begin() { return packets.begin(); }
+    iterator end() { return packets.end(); }
+    const_iterator begin() const { return packets.begin(); }
+    const_iterator end() const { return packets.end(); }
+
+    bool empty() const { return packets.empty(); }
+    size_t size() const { return packets.size(); }
+    MemPacket* front() const { return packets.front(); }
+
+    /** Add a packet at the end of the queue. */
+    void push_back(MemPacket* pkt);
+
+    /**
+     * Remove a packet from the queue.
+     *
+     * @param it Iterator to the packet to remove
+     * @return Iterator to the following packet
+     */
+    iterator erase(iterator it);
+
+    /**
+     * Find a packet of the queue in logarithmic time, using its
+     * arrival order.
+     *
+     * @param pkt The packet to find
+     * @return Iterator to the packet, end() if not in the queue
+     */
+    iterator find(const MemPacket* pkt);
+
+    /**
+     * Get the DRAM packets of the queue to a given bank, in arrival
+     * order.
+     *
+     * @param pseudo_channel Pseudo channel of the bank
+     * @param bank_id Bank id, considering the banks in all the ranks
+     */
+    const BankQueue& bankQueue(uint8_t pseudo_channel,
+                               uint16_t bank_id) const;
+
+    /**
+     * For FR-FCFS policy, find the first DRAM packet of a pseudo
+     * channel that can issue. The packets of a queue are either all
+     * reads or all writes, so all the row hits (or misses) to a bank
+     * have the same bank timing. Only the first row hit and the first
+     * row miss of each bank are thus considered, and the same packet is
+     * picked as by a scan of the whole queue in arrival order.
+     *
+     * @param pseudo_channel Pseudo channel of the banks
+     * @param ranks Number of ranks in the channel
+     * @param banks_per_rank Number of banks per rank
+     * @param min_col_at Minimum tick for 'seamless' issue
+     * @param rank_ready Tells if a rank, given its index, is available
+     * @param bank_state Gives the state of a bank, given its rank and
+     *        bank indices, with its open row and column command timing
+     * @param earliest_banks Gives the per-rank masks of the banks with
+     *        the earliest bank preparation, and whether it can be hidden
+     * @return an iterator to the selected packet, else end()
+     * @return the tick when the packet selected will issue
+     */
+    template <class RankReady, class BankState, class EarliestBanks>
+    std::pair<iterator, Tick>
+    chooseNextFRFCFS(uint8_t pseudo_channel, int ranks, int banks_per_rank,
+                     Tick min_col_at, RankReady rank_ready,
+                     BankState bank_state, EarliestBanks earliest_banks);
+
+  private:
+    /** All the packets, in arrival order */
+    std::deque<MemPacket*> packets;
+
+    /** DRAM packets per pseudo channel and bank id */
+    std::vector<std::vector<BankQueue>> bankQueues;
+
+    /** Arrival order of the next packet */
+    uint64_t nextSeq = 0;
+};
+
+template <class RankReady, class BankState, class EarliestBanks>
+std::pair<MemPacketQueue::iterator, Tick>
+MemPacketQueue::chooseNextFRFCFS(uint8_t pseudo_channel, int ranks,
+                                 int banks_per_rank, Tick min_col_at,
+                                 RankReady rank_ready, BankState bank_state,
+                                 EarliestBanks earliest_banks)
+{
+    // Amongst the first row hit and the first row miss of each bank,
+    // and as a scan of the whole queue would, pick in order of
+    // preference:
+    // 1) the oldest seamless row hit, that can issue without additional
+    //    rank-to-rank or same bank-group delays
+    // 2) the oldest packet to one of the earliest banks to prepare, if
+    //    the PRE/ACT sequence can be hidden without impacting the data
+    //    bus utilisation
+    // 3) the oldest row hit, its bank being prepped and ready
+    // 4) the oldest packet to one of the earliest banks to prepare
+    const MemPacket* seamless_pkt = nullptr;
+    Tick seamless_col_at = MaxTick;
+    const MemPacket* prepped_pkt = nullptr;
+    Tick prepped_col_at = MaxTick;
+
+    for (int i = 0; i < ranks; i++) {
+        // skip ranks doing a refresh, as they are not available
+        if (!rank_ready(i))
+            continue;
+
+        for (int j = 0; j < banks_per_rank; j++) {
+            const auto& bank_queue =
+                bankQueue(pseudo_channel, i * banks_per_rank + j);
+            const auto& bank = bank_state(i, j);
+
+            auto hit = std::find_if(bank_queue.begin(), bank_queue.end(),
+                [&bank](const MemPacket* pkt) {
+                    return pkt->row == bank.openRow;
+                });
+            if (hit == bank_queue.end())
+                continue;
+
+            const MemPacket* pkt = *hit;
+            const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
+                                                        bank.wrAllowedAt;
+            if (col_allowed_at <= min_col_at) {
+                if (!seamless_pkt || pkt->queueSeq < seamless_pkt->queueSeq) {
+                    seamless_pkt = pkt;
+                    seamless_col_at = col_allowed_at;
+                }
+            } else if (!prepped_pkt ||
+                       pkt->queueSeq < prepped_pkt->queueSeq) {
+                prepped_pkt = pkt;
+                prepped_col_at = col_allowed_at;
+            }
+        }
+    }
+
+    if (seamless_pkt)
+        return std::make_pair(find(seamless_pkt), seamless_col_at);
+
+    // determine the banks with the earliest bank delay, and the oldest
+    // row miss to any of them
+    std::vector<uint32_t> earliest_mask;
+    bool hidden_bank_prep;
+    std::tie(earliest_mask, hidden_bank_prep) = earliest_banks();
+
+    const MemPacket* earliest_pkt = nullptr;
+    Tick earliest_col_at = MaxTick;
+
+    for (int i = 0; i < ranks; i++) {
+        for (int j = 0; j < banks_per_rank; j++) {
+            if (!bits(earliest_mask[i], j, j))
+                continue;
+
+            const auto& bank_queue =
+                bankQueue(pseudo_channel, i * banks_per_rank + j);
+            const auto& bank = bank_state(i, j);
+
+            auto miss = std::find_if(bank_queue.begin(), bank_queue.end(),
+                [&bank](const MemPacket* pkt) {
+                    return pkt->row != bank.openRow;
+                });
+            if (miss == bank_queue.end())
+                continue;
+
+            const MemPacket* pkt = *miss;
+            if (!earliest_pkt || pkt->queueSeq < earliest_pkt->queueSeq) {
+                earliest_pkt = pkt;
+                earliest_col_at = pkt->isRead() ? bank.rdAllowedAt :
+                                                  bank.wrAllowedAt;
+            }
+        }
+    }
+
+    // give priority to packets that can issue bank commands 'behind
+    // the scenes', any additional delay if any will be due to
+    // col-to-col command requirements
+    if (earliest_pkt && (hidden_bank_prep || !prepped_pkt))
+        return std::make_pair(find(earliest_pkt), earliest_col_at);
+
+    if (prepped_pkt)
+        return std::make_pair(find(prepped_pkt), prepped_col_at);
+
+    return std::make_pair(end(), MaxTick);
+}
 
 
 /**
@@ -300,14 +520,14 @@ class MemCtrl : public qos::MemCtrl
      * in these methods
      */
     virtual void processNextReqEvent(MemInterface* mem_intr,
-                          MemPacketQueue& resp_queue,
+                          std::deque<MemPacket*>& resp_queue,
                           EventFunctionWrapper& resp_event,
                           EventFunctionWrapper& next_req_event,
                           bool& retry_wr_req);
     EventFunctionWrapper nextReqEvent;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req);
     EventFunctionWrapper respondEvent;
@@ -673,6 +893,24 @@ class MemCtrl : public qos::MemCtrl
      */
     virtual void pruneBurstTick();
 
+    /**
+     * Check if the refresh events of an interface can be coalesced once
+     * the scheduler finds nothing to do, i.e., if nothing but the
+     * refresh itself can happen until the next request arrives
+     *
+     * @param mem_intr memory interface to check
+     * @return true if the refresh events can be coalesced
+     */
+    virtual bool canCoalesceRefresh(MemInterface* mem_intr);
+
+    /**
+     * Account for the coalesced refresh events of all interfaces up
+     * to the current tick
+     *
+     * @param wake_up Also restart the events, as a request is handled
+     */
+    virtual void catchUpRefresh(bool wake_up);
+
   public:
 
     MemCtrl(const MemCtrlParams &p);
@@ -779,6 +1017,20 @@ class MemCtrl : public qos::MemCtrl
     virtual void startup() override;
     virtual void drainResume() override;
 
+    void resetStats() override;
+    void preDumpStats() override;
+
+    /**
+     * Record the scheduler restarts at the end of the refreshes of an
+     * interface whose refresh events are coalesced. The controller is
+     * idle, so each of them only records that the bus stays in its
+     * current state.
+     *
+     * @param mem_intr memory interface that completed the refreshes
+     * @param count number of scheduler restarts
+     */
+    void recordIdleRestarts(MemInterface* mem_intr, unsigned count);
+
   protected:
 
     virtual Tick recvAtomic(PacketPtr pkt);
@@ -385,6 +385,21 @@ class MemInterface : public AbstractMemory
         "not be executed from here.\n");
     }
 
+    /**
+     * Stop the periodic maintenance events of an idle interface, and
+     * account for them when the interface is next used instead. This
+     * function is DRAM specific, other interfaces have nothing to do.
+     */
+    virtual void coalesceRefresh() {}
+
+    /**
+     * Account for the coalesced maintenance events up to the current
+     * tick, e.g., before the stats are dumped or reset.
+     *
+     * @param wake_up Also restart the events, as the interface is used
+     */
+    virtual void catchUpRefresh(bool wake_up) {}
+
     /**
      * This function is NVM specific.
      */
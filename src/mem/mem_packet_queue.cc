@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cassert>
+
+#include "mem/mem_ctrl.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+void
+MemPacketQueue::push_back(MemPacket* pkt)
+{
+    pkt->queueSeq = nextSeq++;
+    packets.push_back(pkt);
+
+    if (pkt->isDram()) {
+        if (bankQueues.size() <= pkt->pseudoChannel)
+            bankQueues.resize(pkt->pseudoChannel + 1);
+        auto &channel = bankQueues[pkt->pseudoChannel];
+        if (channel.size() <= pkt->bankId)
+            channel.resize(pkt->bankId + 1);
+        channel[pkt->bankId].push_back(pkt);
+    }
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::erase(iterator it)
+{
+    MemPacket* pkt = *it;
+    if (pkt->isDram()) {
+        // The scheduler mostly picks packets at the head of their bank
+        auto &bank_queue = bankQueues[pkt->pseudoChannel][pkt->bankId];
+        auto bank_it = std::find(bank_queue.begin(), bank_queue.end(), pkt);
+        assert(bank_it != bank_queue.end());
+        bank_queue.erase(bank_it);
+    }
+    return packets.erase(it);
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::find(const MemPacket* pkt)
+{
+    auto it = std::lower_bound(packets.begin(), packets.end(), pkt,
+        [](const MemPacket* a, const MemPacket* b) {
+            return a->queueSeq < b->queueSeq;
+        });
+    return it != packets.end() && *it == pkt ? it : packets.end();
+}
+
+const MemPacketQueue::BankQueue&
+MemPacketQueue::bankQueue(uint8_t pseudo_channel, uint16_t bank_id) const
+{
+    static const BankQueue noPackets;
+    if (pseudo_channel >= bankQueues.size() ||
+        bank_id >= bankQueues[pseudo_channel].size()) {
+        return noPackets;
+    }
+    return bankQueues[pseudo_channel][bank_id];
+}
+
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/types.hh"
+#include "mem/mem_ctrl.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+GTestTickHandler tickHandler;
+
+/** The bank state the FR-FCFS selection depends on. */
+struct TestBank
+{
+    uint32_t openRow;
+    Tick rdAllowedAt;
+    Tick wrAllowedAt;
+};
+
+/**
+ * A channel with random bank and rank states, and random packets,
+ * including packets to another pseudo channel and non-DRAM packets.
+ * As in the read and write queues of a controller, the packets are
+ * either all reads or all writes.
+ */
+class Channel
+{
+  public:
+    Channel(unsigned seed, int num_ranks, int num_banks, bool is_read)
+        : rng(seed), isRead(is_read), ranks(num_ranks),
+          banksPerRank(num_banks), rankReady(num_ranks),
+          banks(num_ranks * num_banks), earliestMask(num_ranks),
+          req(std::make_shared<Request>(0, 64, 0, 0)),
+          pkt(req, is_read ? MemCmd::ReadReq : MemCmd::WriteReq)
+    {}
+
+    unsigned random(unsigned n) { return rng() % n; }
+
+    /** Draw new rank and bank states, and new earliest banks. */
+    void
+    randomizeState()
+    {
+        // Few distinct rows and timings, so that several banks often
+        // tie and the arrival order decides
+        for (int i = 0; i < ranks; i++) {
+            rankReady[i] = random(4) != 0;
+            earliestMask[i] = 0;
+            for (int j = 0; j < banksPerRank; j++) {
+                TestBank &bank = banks[i * banksPerRank + j];
+                bank.openRow = random(5) == 0 ? uint32_t(-1) : random(3);
+                bank.rdAllowedAt = random(4) * 10;
+                bank.wrAllowedAt = random(4) * 10;
+                // minBankPrep only reports banks in available ranks
+                if (rankReady[i] && random(3) == 0)
+                    earliestMask[i] |= 1 << j;
+            }
+        }
+        hiddenBankPrep = random(2);
+        minColAt = random(4) * 10;
+    }
+
+    MemPacket*
+    newPacket()
+    {
+        const uint8_t rank = random(ranks);
+        const uint8_t bank = random(banksPerRank);
+        packets.emplace_back(&pkt, isRead, random(8) != 0,
+            random(4) == 0, rank, bank, random(3),
+            rank * banksPerRank + bank, 0, 64);
+        return &packets.back();
+    }
+
+    std::pair<MemPacketQueue::iterator, Tick>
+    choose(MemPacketQueue &queue)
+    {
+        return queue.chooseNextFRFCFS(0, ranks, banksPerRank, minColAt,
+            [this](int rank) { return bool(rankReady[rank]); },
+            [this](int rank, int bank) -> const TestBank& {
+                return banks[rank * banksPerRank + bank];
+            },
+            [this]() { return std::make_pair(earliestMask, hiddenBankPrep); });
+    }
+
+    /**
+     * The FR-FCFS selection as a scan of the whole queue in arrival
+     * order, as done before the queues were indexed by bank.
+     */
+    std::pair<MemPacketQueue::iterator, Tick>
+    scan(MemPacketQueue &queue)
+    {
+        bool found_hidden_bank = false;
+        bool found_prepped_pkt = false;
+        bool found_earliest_pkt = false;
+        Tick selected_col_at = MaxTick;
+        auto selected_pkt_it = queue.end();
+
+        for (auto i = queue.begin(); i != queue.end(); ++i) {
+            const MemPacket* pkt = *i;
+            if (!pkt->isDram() || pkt->pseudoChannel != 0 ||
+                !rankReady[pkt->rank]) {
+                continue;
+            }
+
+            const TestBank &bank = banks[pkt->bankId];
+            const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
+                                                        bank.wrAllowedAt;
+            if (bank.openRow == pkt->row) {
+                if (col_allowed_at <= minColAt) {
+                    selected_pkt_it = i;
+                    selected_col_at = col_allowed_at;
+                    break;
+                } else if (!found_hidden_bank && !found_prepped_pkt) {
+                    selected_pkt_it = i;
+                    selected_col_at = col_allowed_at;
+                    found_prepped_pkt = true;
+                }
+            } else if (!found_earliest_pkt &&
+                       bits(earliestMask[pkt->rank], pkt->bank, pkt->bank)) {
+                found_earliest_pkt = true;
+                found_hidden_bank = hiddenBankPrep;
+                if (hiddenBankPrep || !found_prepped_pkt) {
+                    selected_pkt_it = i;
+                    selected_col_at = col_allowed_at;
+                }
+            }
+        }
+        return std::make_pair(selected_pkt_it, selected_col_at);
+    }
+
+  private:
+    std::mt19937 rng;
+    const bool isRead;
+    const int ranks;
+    const int banksPerRank;
+    std::vector<char> rankReady;
+    std::vector<TestBank> banks;
+    std::vector<uint32_t> earliestMask;
+    bool hiddenBankPrep = false;
+    Tick minColAt = 0;
+
+    RequestPtr req;
+    Packet pkt;
+    std::deque<MemPacket> packets;
+};
+
+/**
+ * Fill and drain a queue at random, removing the selected packet as
+ * the controller does most of the time, and check that the per-bank
+ * selection picks the same packet, at the same tick, as the scan.
+ */
+void
+checkRandomSchedule(unsigned seed, int num_ranks, int num_banks,
+                    size_t max_size)
+{
+    Channel channel(seed, num_ranks, num_banks, seed % 2);
+    MemPacketQueue queue;
+
+    for (int step = 0; step < 3000; ++step) {
+        if (queue.size() < max_size && channel.random(2) == 0) {
+            queue.push_back(channel.newPacket());
+            ASSERT_EQ(queue.find(*(queue.end() - 1)), queue.end() - 1);
+        }
+
+        channel.randomizeState();
+        const auto selected = channel.choose(queue);
+        const auto expected = channel.scan(queue);
+        ASSERT_EQ(selected.first, expected.first) << "step " << step;
+        ASSERT_EQ(selected.second, expected.second) << "step " << step;
+
+        if (!queue.empty() && channel.random(2) == 0) {
+            auto it = selected.first != queue.end() && channel.random(4) ?
+                selected.first : queue.begin() + channel.random(queue.size());
+            const MemPacket* pkt = *it;
+            ASSERT_EQ(queue.find(pkt), it);
+            queue.erase(it);
+            ASSERT_EQ(queue.find(pkt), queue.end());
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(MemPacketQueueTest, BankQueuesKeepArrivalOrder)
+{
+    Channel channel(0, 2, 4, true);
+    MemPacketQueue queue;
+    for (int i = 0; i < 64; ++i)
+        queue.push_back(channel.newPacket());
+    for (int i = 0; i < 16; ++i)
+        queue.erase(queue.begin() + channel.random(queue.size()));
+
+    // Each bank queue holds the DRAM packets of the queue to the bank,
+    // in the order of the queue
+    size_t num_dram = 0;
+    for (uint8_t pc = 0; pc < 2; ++pc) {
+        for (uint16_t bank_id = 0; bank_id < 8; ++bank_id) {
+            const auto &bank_queue = queue.bankQueue(pc, bank_id);
+            auto it = queue.begin();
+            for (const MemPacket* pkt : bank_queue) {
+                EXPECT_TRUE(pkt->isDram());
+                EXPECT_EQ(pkt->pseudoChannel, pc);
+                EXPECT_EQ(pkt->bankId, bank_id);
+                it = std::find(it, queue.end(), pkt);
+                ASSERT_NE(it, queue.end());
+            }
+            num_dram += bank_queue.size();
+        }
+    }
+    EXPECT_EQ(num_dram, std::count_if(queue.begin(), queue.end(),
+        [](const MemPacket* pkt) { return pkt->isDram(); }));
+    EXPECT_TRUE(queue.bankQueue(7, 0).empty());
+}
+
+TEST(MemPacketQueueTest, FRFCFSMatchesScan)
+{
+    for (unsigned seed = 0; seed < 4; ++seed)
+        checkRandomSchedule(seed, 2, 8, 32);
+}
+
+TEST(MemPacketQueueTest, FRFCFSMatchesScanDeepQueue)
+{
+    for (unsigned seed = 0; seed < 2; ++seed)
+        checkRandomSchedule(seed, 4, 16, 256);
+}
+
+TEST(MemPacketQueueTest, FRFCFSMatchesScanSingleBank)
+{
+    for (unsigned seed = 0; seed < 4; ++seed)
+        checkRandomSchedule(seed, 1, 1, 16);
+}
@@ -0,0 +1,806 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/memory_store.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <vector>
+
+#include "base/atomicio.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "config/have_zstd.hh"
+
+#if HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+/**
+ * On Linux, MAP_NORESERVE allow us to simulate a very large memory
+ * without committing to actually providing the swap space on the
+ * host. On FreeBSD or OSX the MAP_NORESERVE flag does not exist,
+ * so simply make it 0.
+ */
+#if defined(__APPLE__) || defined(__FreeBSD__)
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
+#endif
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace
+{
+
+/**
+ * A chunked store starts with this header, followed by the length of
+ * each chunk in the file and the chunks themselves. A chunk starts with
+ * a bitmap of its pages holding data, followed by the data of these
+ * pages, which is compressed unless that does not make it smaller. A
+ * chunk of length zero only holds zeros and is not stored. All fields
+ * are in host byte order.
+ */
+struct ChunkedStoreHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t codec;
+    uint64_t size;
+    uint64_t chunkSize;
+    uint64_t numChunks;
+    uint64_t pageSize;
+};
+
+const char chunkedStoreMagic[8] = "gem5pmc";
+const uint32_t chunkedStoreVersion = 2;
+const uint64_t chunkedStoreChunkSize = 1 << 20;
+
+enum ChunkedStoreCodec : uint32_t
+{
+    CodecZlib = 1,
+    CodecZstd = 2
+};
+
+#if HAVE_ZSTD
+const uint32_t chunkedStoreCodec = CodecZstd;
+#else
+const uint32_t chunkedStoreCodec = CodecZlib;
+#endif
+
+/**
+ * A delta store starts with this header, followed by the path of the
+ * parent store file relative to the directory of the delta store, the
+ * format of the parent, the index of each changed page and the
+ * contents of the changed pages. All fields are in host byte order.
+ */
+struct DeltaStoreHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t pageSize;
+    uint64_t size;
+    uint64_t numPages;
+    uint32_t parentPathLen;
+    uint32_t parentFormatLen;
+};
+
+const char deltaStoreMagic[8] = "gem5pmd";
+const uint32_t deltaStoreVersion = 1;
+
+// The soft-dirty bit of the entries of /proc/self/pagemap
+const uint64_t pagemapSoftDirty = 1ULL << 55;
+
+/**
+ * Compress a chunk, returning false if it does not fit in the
+ * destination buffer.
+ */
+bool
+compressChunk(uint32_t codec, const uint8_t *src, uint64_t src_len,
+              std::vector<uint8_t> &dst)
+{
+#if HAVE_ZSTD
+    if (codec == CodecZstd) {
+        dst.resize(ZSTD_compressBound(src_len));
+        size_t len = ZSTD_compress(dst.data(), dst.size(), src, src_len, 1);
+        if (ZSTD_isError(len))
+            return false;
+        dst.resize(len);
+        return true;
+    }
+#endif
+    assert(codec == CodecZlib);
+    uLongf len = compressBound(src_len);
+    dst.resize(len);
+    if (compress2(dst.data(), &len, src, src_len, Z_BEST_SPEED) != Z_OK)
+        return false;
+    dst.resize(len);
+    return true;
+}
+
+/**
+ * Decompress a chunk, returning false unless it decompresses to
+ * exactly dst_len bytes.
+ */
+bool
+decompressChunk(uint32_t codec, const uint8_t *src, uint64_t src_len,
+                uint8_t *dst, uint64_t dst_len)
+{
+#if HAVE_ZSTD
+    if (codec == CodecZstd) {
+        size_t len = ZSTD_decompress(dst, dst_len, src, src_len);
+        return !ZSTD_isError(len) && len == dst_len;
+    }
+#endif
+    assert(codec == CodecZlib);
+    uLongf len = dst_len;
+    return uncompress(dst, &len, src, src_len) == Z_OK && len == dst_len;
+}
+
+} // anonymous namespace
+
+bool
+isZero(const uint8_t *data, Addr size)
+{
+    // If the first byte is zero and every byte equals the next one, all
+    // bytes are zero. This lets memcmp do the heavy lifting.
+    return size == 0 || (data[0] == 0 && !memcmp(data, data + 1, size - 1));
+}
+
+void
+writeGzipStore(const std::string &filepath, const uint8_t *pmem, Addr size)
+{
+    gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filepath);
+
+    uint64_t pass_size = 0;
+
+    // gzwrite fails if (int)len < 0 (gzwrite returns int)
+    for (uint64_t written = 0; written < size; written += pass_size) {
+        pass_size = (uint64_t)INT_MAX < (size - written) ?
+            (uint64_t)INT_MAX : (size - written);
+
+        if (gzwrite(compressed_mem, pmem + written,
+                    (unsigned int) pass_size) != (int) pass_size) {
+            fatal("Write failed on physical memory checkpoint file '%s'\n",
+                  filepath);
+        }
+    }
+
+    // close the compressed stream and check that the exit status
+    // is zero
+    if (gzclose(compressed_mem))
+        fatal("Close failed on physical memory checkpoint file '%s'\n",
+              filepath);
+}
+
+void
+readGzipStore(const std::string &filepath, uint8_t *pmem, Addr size)
+{
+    const uint32_t chunk_size = 16384;
+
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filepath);
+
+    uint64_t curr_size = 0;
+    uint32_t bytes_read;
+    while (curr_size < size) {
+        bytes_read = gzread(compressed_mem, pmem, chunk_size);
+        if (bytes_read == 0)
+            break;
+        curr_size += bytes_read;
+        pmem += bytes_read;
+    }
+
+    if (gzclose(compressed_mem))
+        fatal("Close failed on physical memory checkpoint file '%s'\n",
+              filepath);
+}
+
+void
+writeRawStore(const std::string &filepath, const uint8_t *pmem, Addr size,
+              Addr page_size)
+{
+    // Write to a temporary file that then replaces the store, since the
+    // store may currently be mapped if we were restored from it.
+    std::string tmppath = filepath + ".tmp";
+    int fd = open(tmppath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s': %s\n",
+              tmppath, strerror(errno));
+
+    // Write runs of pages holding data, and seek over the pages only
+    // holding zeros so that they become holes in the file.
+    Addr offset = 0;
+    while (offset < size) {
+        Addr len = std::min<Addr>(page_size, size - offset);
+        if (isZero(pmem + offset, len)) {
+            offset += len;
+            continue;
+        }
+
+        Addr end = offset + len;
+        while (end < size) {
+            len = std::min<Addr>(page_size, size - end);
+            if (isZero(pmem + end, len))
+                break;
+            end += len;
+        }
+
+        if (lseek(fd, offset, SEEK_SET) != (off_t)offset ||
+            atomic_write(fd, pmem + offset, end - offset) !=
+                (ssize_t)(end - offset)) {
+            fatal("Write failed on physical memory checkpoint file '%s': "
+                  "%s\n", tmppath, strerror(errno));
+        }
+        offset = end;
+    }
+
+    if (ftruncate(fd, size) || close(fd))
+        fatal("Close failed on physical memory checkpoint file '%s': %s\n",
+              tmppath, strerror(errno));
+
+    if (rename(tmppath.c_str(), filepath.c_str()))
+        fatal("Can't rename physical memory checkpoint file '%s': %s\n",
+              tmppath, strerror(errno));
+}
+
+void
+readRawStore(const std::string &filepath, uint8_t *pmem, Addr size,
+             bool map, bool no_reserve)
+{
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s': %s\n",
+              filepath, strerror(errno));
+
+    struct stat st;
+    if (fstat(fd, &st) || (Addr)st.st_size != size)
+        fatal("Physical memory checkpoint file '%s' does not match the "
+              "size of the memory\n", filepath);
+
+    if (map) {
+        // Replace the memory in place, so that its users keep pointing
+        // to it.
+        int map_flags = MAP_PRIVATE | MAP_FIXED;
+        if (no_reserve)
+            map_flags |= MAP_NORESERVE;
+
+        [[maybe_unused]] void *mapped = mmap(pmem, size,
+                PROT_READ | PROT_WRITE, map_flags, fd, 0);
+        if (mapped == MAP_FAILED)
+            fatal("Could not mmap physical memory checkpoint file '%s': "
+                  "%s\n", filepath, strerror(errno));
+        assert(mapped == pmem);
+    } else {
+        if (atomic_read(fd, pmem, size) != (ssize_t)size)
+            fatal("Read failed on physical memory checkpoint file '%s': "
+                  "%s\n", filepath, strerror(errno));
+    }
+
+    close(fd);
+}
+
+StoreWorkers::StoreWorkers(unsigned num_threads) : next(0)
+{
+    for (unsigned t = 1; t < num_threads; t++)
+        threads.emplace_back([this]() { work(); });
+}
+
+StoreWorkers::~StoreWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobStarted.notify_all();
+    for (auto &t : threads)
+        t.join();
+}
+
+void
+StoreWorkers::work()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t last_job = 0;
+    while (true) {
+        jobStarted.wait(lock, [&]() {
+            return stopping || jobId != last_job;
+        });
+        if (stopping)
+            return;
+
+        // Jobs that are already done are skipped
+        last_job = jobId;
+        if (!job)
+            continue;
+
+        const auto &f = *job;
+        const uint64_t end = jobEnd;
+        busy++;
+        lock.unlock();
+        for (uint64_t i = next++; i < end; i = next++)
+            f(i);
+        lock.lock();
+        if (--busy == 0)
+            jobDone.notify_all();
+    }
+}
+
+void
+StoreWorkers::parallelFor(uint64_t begin, uint64_t end,
+                          const std::function<void(uint64_t)> &f)
+{
+    if (threads.empty() || end - begin < 2) {
+        for (uint64_t i = begin; i < end; i++)
+            f(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &f;
+        jobEnd = end;
+        next = begin;
+        jobId++;
+    }
+    jobStarted.notify_all();
+
+    for (uint64_t i = next++; i < end; i = next++)
+        f(i);
+
+    // The threads that did not pick the job up yet skip it once it is
+    // cleared
+    std::unique_lock<std::mutex> lock(mutex);
+    jobDone.wait(lock, [&]() { return busy == 0; });
+    job = nullptr;
+}
+
+void
+writeChunkedStore(const std::string &filepath, const uint8_t *pmem,
+                  Addr size, Addr page_size, StoreWorkers &workers)
+{
+    ChunkedStoreHeader header;
+    memcpy(header.magic, chunkedStoreMagic, sizeof(header.magic));
+    header.version = chunkedStoreVersion;
+    header.codec = chunkedStoreCodec;
+    header.size = size;
+    header.chunkSize = roundUp(chunkedStoreChunkSize, page_size);
+    header.numChunks = divCeil(size, header.chunkSize);
+    header.pageSize = page_size;
+
+    const uint64_t bitmap_size =
+        divCeil(header.chunkSize / header.pageSize, 8);
+
+    // See writeRawStore for why a temporary file is used
+    std::string tmppath = filepath + ".tmp";
+    int fd = open(tmppath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s': %s\n",
+              tmppath, strerror(errno));
+
+    // The chunk lengths are only known once they are compressed, so
+    // leave room for them and write them last.
+    std::vector<uint64_t> lengths(header.numChunks, 0);
+    const off_t data_offset =
+        sizeof(header) + lengths.size() * sizeof(lengths[0]);
+    if (lseek(fd, data_offset, SEEK_SET) != data_offset)
+        fatal("Write failed on physical memory checkpoint file '%s': %s\n",
+              tmppath, strerror(errno));
+
+    // Compress a batch of chunks at a time to bound the memory used
+    // for the compressed data, and write them out in order.
+    const uint64_t batch_size = 4 * workers.size();
+    std::vector<std::vector<uint8_t>> batch(batch_size);
+    for (uint64_t first = 0; first < header.numChunks; first += batch_size) {
+        uint64_t last = std::min(first + batch_size, header.numChunks);
+
+        workers.parallelFor(first, last, [&](uint64_t i) {
+            const uint8_t *chunk = pmem + i * header.chunkSize;
+            const uint64_t len = std::min(header.chunkSize,
+                                          size - i * header.chunkSize);
+            auto &out = batch[i - first];
+
+            // Gather the pages holding data, unless they all do
+            out.assign(bitmap_size, 0);
+            std::vector<uint8_t> gathered;
+            bool sparse = false;
+            uint64_t data_len = 0;
+            for (uint64_t offset = 0; offset < len; offset += page_size) {
+                const uint64_t page_len = std::min(page_size, len - offset);
+                if (isZero(chunk + offset, page_len)) {
+                    if (!sparse)
+                        gathered.assign(chunk, chunk + offset);
+                    sparse = true;
+                    continue;
+                }
+                out[offset / page_size / 8] |= 1 << (offset / page_size % 8);
+                if (sparse) {
+                    gathered.insert(gathered.end(), chunk + offset,
+                                    chunk + offset + page_len);
+                }
+                data_len += page_len;
+            }
+
+            if (data_len == 0) {
+                out.clear();
+            } else {
+                const uint8_t *data = sparse ? gathered.data() : chunk;
+                std::vector<uint8_t> compressed;
+                if (compressChunk(header.codec, data, data_len, compressed) &&
+                    compressed.size() < data_len) {
+                    out.insert(out.end(), compressed.begin(),
+                               compressed.end());
+                } else {
+                    // store pages that do not compress as they are
+                    out.insert(out.end(), data, data + data_len);
+                }
+            }
+            lengths[i] = out.size();
+        });
+
+        for (uint64_t i = first; i < last; i++) {
+            auto &out = batch[i - first];
+            if (atomic_write(fd, out.data(), out.size()) !=
+                    (ssize_t)out.size()) {
+                fatal("Write failed on physical memory checkpoint file "
+                      "'%s': %s\n", tmppath, strerror(errno));
+            }
+        }
+    }
+
+    if (lseek(fd, 0, SEEK_SET) != 0 ||
+        atomic_write(fd, &header, sizeof(header)) != sizeof(header) ||
+        atomic_write(fd, lengths.data(), lengths.size() * sizeof(lengths[0]))
+            != (ssize_t)(lengths.size() * sizeof(lengths[0]))) {
+        fatal("Write failed on physical memory checkpoint file '%s': %s\n",
+              tmppath, strerror(errno));
+    }
+
+    if (close(fd))
+        fatal("Close failed on physical memory checkpoint file '%s': %s\n",
+              tmppath, strerror(errno));
+
+    if (rename(tmppath.c_str(), filepath.c_str()))
+        fatal("Can't rename physical memory checkpoint file '%s': %s\n",
+              tmppath, strerror(errno));
+}
+
+void
+readChunkedStore(const std::string &filepath, uint8_t *pmem, Addr size,
+                 StoreWorkers &workers)
+{
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s': %s\n",
+              filepath, strerror(errno));
+
+    ChunkedStoreHeader header;
+    if (atomic_read(fd, &header, sizeof(header)) != sizeof(header) ||
+        memcmp(header.magic, chunkedStoreMagic, sizeof(header.magic))) {
+        fatal("Physical memory checkpoint file '%s' is not a chunked "
+              "store\n", filepath);
+    }
+    fatal_if(header.version != chunkedStoreVersion,
+             "Physical memory checkpoint file '%s' has unsupported version "
+             "%d\n", filepath, header.version);
+    fatal_if(header.size != size || header.pageSize == 0 ||
+             header.chunkSize == 0 || header.chunkSize % header.pageSize ||
+             header.numChunks != divCeil(size, header.chunkSize),
+             "Physical memory checkpoint file '%s' does not match the size "
+             "of the memory\n", filepath);
+#if !HAVE_ZSTD
+    fatal_if(header.codec == CodecZstd,
+             "Physical memory checkpoint file '%s' is compressed using "
+             "zstd, which this build does not support\n", filepath);
+#endif
+    fatal_if(header.codec != CodecZlib && header.codec != CodecZstd,
+             "Physical memory checkpoint file '%s' uses unknown codec %d\n",
+             filepath, header.codec);
+
+    const uint64_t page_size = header.pageSize;
+    const uint64_t bitmap_size = divCeil(header.chunkSize / page_size, 8);
+
+    std::vector<uint64_t> lengths(header.numChunks);
+    std::vector<off_t> offsets(header.numChunks);
+    const ssize_t index_size = lengths.size() * sizeof(lengths[0]);
+    if (atomic_read(fd, lengths.data(), index_size) != index_size)
+        fatal("Read failed on physical memory checkpoint file '%s': %s\n",
+              filepath, strerror(errno));
+
+    off_t offset = sizeof(header) + index_size;
+    for (uint64_t i = 0; i < header.numChunks; i++) {
+        offsets[i] = offset;
+        offset += lengths[i];
+    }
+
+    std::atomic<bool> failed(false);
+    workers.parallelFor(0, header.numChunks, [&](uint64_t i) {
+        uint8_t *chunk = pmem + i * header.chunkSize;
+        const uint64_t len = std::min(header.chunkSize,
+                                      size - i * header.chunkSize);
+
+        std::vector<uint8_t> in;
+        if (lengths[i] != 0) {
+            in.resize(lengths[i]);
+            if (in.size() < bitmap_size ||
+                pread(fd, in.data(), in.size(), offsets[i]) !=
+                    (ssize_t)in.size()) {
+                failed = true;
+                return;
+            }
+        }
+
+        auto has_data = [&](uint64_t page) {
+            return !in.empty() && (in[page / 8] >> (page % 8) & 1);
+        };
+
+        uint64_t data_len = 0;
+        for (uint64_t offset = 0; offset < len; offset += page_size) {
+            if (has_data(offset / page_size))
+                data_len += std::min(page_size, len - offset);
+        }
+
+        // Unpack the pages in place if they all hold data
+        std::vector<uint8_t> gathered;
+        uint8_t *data = chunk;
+        if (data_len != len) {
+            gathered.resize(data_len);
+            data = gathered.data();
+        }
+
+        if (!in.empty()) {
+            const uint8_t *packed = in.data() + bitmap_size;
+            const uint64_t packed_len = in.size() - bitmap_size;
+            if (packed_len == data_len) {
+                memcpy(data, packed, data_len);
+            } else if (!decompressChunk(header.codec, packed, packed_len,
+                                        data, data_len)) {
+                failed = true;
+                return;
+            }
+        }
+
+        if (data_len == len)
+            return;
+
+        uint64_t data_offset = 0;
+        for (uint64_t offset = 0; offset < len; offset += page_size) {
+            const uint64_t page_len = std::min(page_size, len - offset);
+            if (has_data(offset / page_size)) {
+                memcpy(chunk + offset, data + data_offset, page_len);
+                data_offset += page_len;
+            } else if (!isZero(chunk + offset, page_len)) {
+                // Avoid touching pages that are still untouched and
+                // therefore zero already.
+                memset(chunk + offset, 0, page_len);
+            }
+        }
+    });
+
+    fatal_if(failed, "Read failed on physical memory checkpoint file '%s'\n",
+             filepath);
+
+    close(fd);
+}
+
+void
+clearSoftDirty()
+{
+    int fd = open("/proc/self/clear_refs", O_WRONLY);
+    bool ok = fd >= 0 && atomic_write(fd, "4", 1) == 1;
+    if (fd >= 0)
+        close(fd);
+    fatal_if(!ok, "Can't clear the soft-dirty bits of the process: %s\n",
+             strerror(errno));
+}
+
+bool
+readSoftDirty(const uint8_t *pmem, Addr size, Addr page_size,
+              std::vector<bool> &dirty)
+{
+    int fd = open("/proc/self/pagemap", O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    const uint64_t first = (uintptr_t)pmem / page_size;
+    const uint64_t num_pages = divCeil(size, page_size);
+    std::vector<uint64_t> entries(4096);
+    bool ok = true;
+    for (uint64_t i = 0; ok && i < num_pages; i += entries.size()) {
+        const uint64_t n = std::min<uint64_t>(entries.size(), num_pages - i);
+        const ssize_t len = n * sizeof(entries[0]);
+        ok = pread(fd, entries.data(), len,
+                   (first + i) * sizeof(entries[0])) == len;
+        for (uint64_t j = 0; ok && j < n; j++) {
+            if (entries[j] & pagemapSoftDirty)
+                dirty[i + j] = true;
+        }
+    }
+    close(fd);
+    return ok;
+}
+
+bool
+softDirtySupported()
+{
+    static const bool supported = []() {
+        const long page_size = sysconf(_SC_PAGE_SIZE);
+        void *page = mmap(NULL, page_size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (page == MAP_FAILED)
+            return false;
+
+        int fd = open("/proc/self/clear_refs", O_WRONLY);
+        bool ok = fd >= 0 && atomic_write(fd, "4", 1) == 1;
+        if (fd >= 0)
+            close(fd);
+
+        std::vector<bool> dirty(1);
+        if (ok) {
+            *(volatile uint8_t *)page = 1;
+            ok = readSoftDirty((uint8_t *)page, page_size, page_size, dirty);
+        }
+        munmap(page, page_size);
+        return ok && dirty[0];
+    }();
+    return supported;
+}
+
+void
+writeDeltaStore(const std::string &filepath, const uint8_t *pmem,
+                Addr size, Addr page_size, const std::vector<bool> &dirty,
+                const std::string &parent_path,
+                const std::string &parent_format)
+{
+    assert(dirty.size() == divCeil(size, page_size));
+
+    std::vector<uint64_t> pages;
+    for (uint64_t i = 0; i < dirty.size(); i++) {
+        if (dirty[i])
+            pages.push_back(i);
+    }
+
+    DeltaStoreHeader header;
+    memcpy(header.magic, deltaStoreMagic, sizeof(header.magic));
+    header.version = deltaStoreVersion;
+    header.pageSize = page_size;
+    header.size = size;
+    header.numPages = pages.size();
+    header.parentPathLen = parent_path.size();
+    header.parentFormatLen = parent_format.size();
+
+    // See writeRawStore for why a temporary file is used
+    std::string tmppath = filepath + ".tmp";
+    int fd = open(tmppath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s': %s\n",
+              tmppath, strerror(errno));
+
+    const ssize_t index_size = pages.size() * sizeof(pages[0]);
+    bool ok =
+        atomic_write(fd, &header, sizeof(header)) == sizeof(header) &&
+        atomic_write(fd, parent_path.data(), parent_path.size()) ==
+            (ssize_t)parent_path.size() &&
+        atomic_write(fd, parent_format.data(), parent_format.size()) ==
+            (ssize_t)parent_format.size() &&
+        atomic_write(fd, pages.data(), index_size) == index_size;
+
+    for (auto it = pages.begin(); ok && it != pages.end(); ++it) {
+        Addr offset = *it * page_size;
+        Addr len = std::min<Addr>(page_size, size - offset);
+        ok = atomic_write(fd, pmem + offset, len) == (ssize_t)len;
+    }
+
+    if (!ok)
+        fatal("Write failed on physical memory checkpoint file '%s': %s\n",
+              tmppath, strerror(errno));
+
+    if (close(fd))
+        fatal("Close failed on physical memory checkpoint file '%s': %s\n",
+              tmppath, strerror(errno));
+
+    if (rename(tmppath.c_str(), filepath.c_str()))
+        fatal("Can't rename physical memory checkpoint file '%s': %s\n",
+              tmppath, strerror(errno));
+}
+
+void
+readDeltaStore(const std::string &filepath, uint8_t *pmem, Addr size,
+               const ReadParentStore &read_parent)
+{
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s': %s\n",
+              filepath, strerror(errno));
+
+    DeltaStoreHeader header;
+    if (atomic_read(fd, &header, sizeof(header)) != sizeof(header) ||
+        memcmp(header.magic, deltaStoreMagic, sizeof(header.magic))) {
+        fatal("Physical memory checkpoint file '%s' is not a delta store\n",
+              filepath);
+    }
+    fatal_if(header.version != deltaStoreVersion,
+             "Physical memory checkpoint file '%s' has unsupported version "
+             "%d\n", filepath, header.version);
+    fatal_if(header.size != size || header.pageSize == 0,
+             "Physical memory checkpoint file '%s' does not match the size "
+             "of the memory\n", filepath);
+
+    std::string parent_path(header.parentPathLen, '\0');
+    std::string parent_format(header.parentFormatLen, '\0');
+    std::vector<uint64_t> pages(header.numPages);
+    const ssize_t index_size = pages.size() * sizeof(pages[0]);
+    if (atomic_read(fd, parent_path.data(), parent_path.size()) !=
+            (ssize_t)parent_path.size() ||
+        atomic_read(fd, parent_format.data(), parent_format.size()) !=
+            (ssize_t)parent_format.size() ||
+        atomic_read(fd, pages.data(), index_size) != index_size) {
+        fatal("Read failed on physical memory checkpoint file '%s': %s\n",
+              filepath, strerror(errno));
+    }
+
+    // Restore the parent first, resolving its path relative to ours
+    if (!parent_path.empty() && parent_path[0] != '/') {
+        auto slash = filepath.rfind('/');
+        if (slash != std::string::npos)
+            parent_path = filepath.substr(0, slash + 1) + parent_path;
+    }
+    read_parent(parent_path, parent_format);
+
+    for (auto page : pages) {
+        Addr offset = page * header.pageSize;
+        fatal_if(offset >= size, "Physical memory checkpoint file '%s' "
+                 "holds a page outside of the memory\n", filepath);
+        Addr len = std::min<Addr>(header.pageSize, size - offset);
+        if (atomic_read(fd, pmem + offset, len) != (ssize_t)len)
+            fatal("Read failed on physical memory checkpoint file '%s': "
+                  "%s\n", filepath, strerror(errno));
+    }
+
+    close(fd);
+}
+
+} // namespace memory
+} // namespace gem5
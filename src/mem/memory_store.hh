@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_MEMORY_STORE_HH__
+#define __MEM_MEMORY_STORE_HH__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * @file
+ * The file formats the backing stores of the physical memory are
+ * checkpointed in. They only deal with memory images, so that they can
+ * be used and tested independently of the memories.
+ */
+
+/**
+ * Check if a block of memory only holds zeros.
+ */
+bool isZero(const uint8_t *data, Addr size);
+
+/**
+ * Write a memory image as a gzip compressed file.
+ */
+void writeGzipStore(const std::string &filepath, const uint8_t *pmem,
+                    Addr size);
+
+/**
+ * Read a memory image from a gzip compressed file.
+ */
+void readGzipStore(const std::string &filepath, uint8_t *pmem, Addr size);
+
+/**
+ * Write a memory image as a raw file, skipping the pages that only
+ * contain zeros so that they become holes in the file. The file is
+ * written to a temporary file first, which then replaces it, as it may
+ * currently be mapped.
+ *
+ * @param page_size The granularity zeros are skipped at
+ */
+void writeRawStore(const std::string &filepath, const uint8_t *pmem,
+                   Addr size, Addr page_size);
+
+/**
+ * Read a memory image from a raw file.
+ *
+ * @param map Replace the memory, which has to be a private mapping, by
+ *        a copy-on-write mapping of the file, so that pages are only
+ *        read when they are touched. Otherwise the file is read in.
+ * @param no_reserve Don't reserve swap space for the mapping
+ */
+void readRawStore(const std::string &filepath, uint8_t *pmem, Addr size,
+                  bool map, bool no_reserve);
+
+/**
+ * A pool of threads working on the chunks of memory stores. The
+ * threads are kept between stores, rather than created for every
+ * batch of chunks.
+ */
+class StoreWorkers
+{
+  public:
+    /**
+     * @param num_threads The number of threads working on a job,
+     *        including the thread waiting for it
+     */
+    explicit StoreWorkers(unsigned num_threads);
+    ~StoreWorkers();
+
+    StoreWorkers(const StoreWorkers &) = delete;
+    StoreWorkers &operator=(const StoreWorkers &) = delete;
+
+    /** The number of threads working on a job. */
+    unsigned size() const { return threads.size() + 1; }
+
+    /**
+     * Call f(i) for every i in [begin, end) on all threads, and wait
+     * for all calls to return.
+     */
+    void parallelFor(uint64_t begin, uint64_t end,
+                     const std::function<void(uint64_t)> &f);
+
+  private:
+    void work();
+
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable jobStarted;
+    std::condition_variable jobDone;
+
+    // The current job, if any, and the index of its next call
+    const std::function<void(uint64_t)> *job = nullptr;
+    uint64_t jobEnd = 0;
+    std::atomic<uint64_t> next;
+    // Incremented for each job, for the threads to notice new jobs
+    uint64_t jobId = 0;
+    // The number of threads working on the current job
+    unsigned busy = 0;
+    bool stopping = false;
+};
+
+/**
+ * Write a memory image as a sequence of chunks that are compressed in
+ * parallel. The pages that only hold zeros are left out of the chunks,
+ * and chunks only holding zeros are not written at all.
+ *
+ * @param page_size The granularity zeros are skipped at
+ */
+void writeChunkedStore(const std::string &filepath, const uint8_t *pmem,
+                       Addr size, Addr page_size, StoreWorkers &workers);
+
+/**
+ * Read a memory image from chunks, decompressing them in parallel. The
+ * pages that only hold zeros are not touched unless they need to be
+ * cleared.
+ */
+void readChunkedStore(const std::string &filepath, uint8_t *pmem,
+                      Addr size, StoreWorkers &workers);
+
+/**
+ * Check if the kernel tracks the pages written by the process in their
+ * soft-dirty bits, which it only does if it is built with
+ * CONFIG_MEM_SOFT_DIRTY.
+ */
+bool softDirtySupported();
+
+/**
+ * Clear the soft-dirty bits of all the pages of the process, after
+ * which the kernel sets the bit of a page again on its first write,
+ * whether it is done by the simulator, a system call or KVM.
+ */
+void clearSoftDirty();
+
+/**
+ * Read the soft-dirty bits of a range of pages, marking the pages
+ * written since the bits were last cleared. Pages that are already
+ * marked stay marked.
+ *
+ * @return False if the bits can't be read.
+ */
+bool readSoftDirty(const uint8_t *pmem, Addr size, Addr page_size,
+                   std::vector<bool> &dirty);
+
+/**
+ * Write the pages of a memory image that changed since a parent store
+ * file, along with a reference to the parent.
+ *
+ * @param dirty The pages that changed, one per page of the image
+ * @param parent_path The path of the parent, relative to the directory
+ *        of the delta store unless it is absolute
+ * @param parent_format The format of the parent
+ */
+void writeDeltaStore(const std::string &filepath, const uint8_t *pmem,
+                     Addr size, Addr page_size,
+                     const std::vector<bool> &dirty,
+                     const std::string &parent_path,
+                     const std::string &parent_format);
+
+/**
+ * Restore the parent of a delta store from the given path and format.
+ */
+using ReadParentStore = std::function<void(const std::string &filepath,
+                                           const std::string &format)>;
+
+/**
+ * Read a memory image from a delta store, after first restoring its
+ * parent, which may be a delta store itself.
+ */
+void readDeltaStore(const std::string &filepath, uint8_t *pmem, Addr size,
+                    const ReadParentStore &read_parent);
+
+} // namespace memory
+} // namespace gem5
+
+#endif //__MEM_MEMORY_STORE_HH__
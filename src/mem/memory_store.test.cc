@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mem/memory_store.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+/** Anonymous memory that can be replaced by mappings of raw stores. */
+class MappedImage
+{
+  public:
+    MappedImage(Addr size, uint8_t fill) : size(size)
+    {
+        pmem = (uint8_t *)mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        assert(pmem != MAP_FAILED);
+        memset(pmem, fill, size);
+    }
+
+    ~MappedImage() { munmap(pmem, size); }
+
+    uint8_t *pmem;
+    const Addr size;
+};
+
+class MemoryStoreTest : public testing::Test
+{
+  protected:
+    const Addr pageSize = sysconf(_SC_PAGE_SIZE);
+    std::string dir;
+    std::vector<std::string> files;
+
+    void
+    SetUp() override
+    {
+        char tmpl[] = "/tmp/gem5-memory-store-XXXXXX";
+        ASSERT_NE(mkdtemp(tmpl), nullptr);
+        dir = tmpl;
+    }
+
+    void
+    TearDown() override
+    {
+        for (const auto &file : files)
+            unlink(file.c_str());
+        rmdir(dir.c_str());
+    }
+
+    std::string
+    path(const std::string &name)
+    {
+        files.push_back(dir + "/" + name);
+        return files.back();
+    }
+
+    /**
+     * Fill an image with random data, except for the pages only holding
+     * zeros, and pages holding a single non-zero byte at either end.
+     */
+    void
+    fillSparse(uint8_t *pmem, Addr size)
+    {
+        std::mt19937 rng(size);
+        for (Addr page = 0; page * pageSize < size; page++) {
+            uint8_t *data = pmem + page * pageSize;
+            const Addr len = std::min(pageSize, size - page * pageSize);
+            memset(data, 0, len);
+            switch (page % 5) {
+              case 0:
+              case 3:
+                break;
+              case 1:
+                data[0] = 1;
+                break;
+              case 2:
+                data[len - 1] = 0xff;
+                break;
+              default:
+                for (Addr i = 0; i < len; i++)
+                    data[i] = rng();
+            }
+        }
+    }
+};
+
+} // anonymous namespace
+
+/** A raw store restores the same bytes as the legacy gzip store. */
+TEST_F(MemoryStoreTest, RawMatchesGzip)
+{
+    const Addr size = 64 * pageSize;
+    MappedImage image(size, 0);
+    fillSparse(image.pmem, size);
+
+    const std::string gzip = path("gzip.pmem");
+    const std::string raw = path("raw.pmem");
+    writeGzipStore(gzip, image.pmem, size);
+    writeRawStore(raw, image.pmem, size, pageSize);
+
+    // Restore into garbage, so that missing zeros are noticed
+    std::vector<uint8_t> from_gzip(size, 0xa5);
+    readGzipStore(gzip, from_gzip.data(), size);
+    ASSERT_EQ(memcmp(from_gzip.data(), image.pmem, size), 0);
+
+    std::vector<uint8_t> read_in(size, 0xa5);
+    readRawStore(raw, read_in.data(), size, false, false);
+    EXPECT_EQ(memcmp(read_in.data(), from_gzip.data(), size), 0);
+
+    MappedImage mapped(size, 0xa5);
+    readRawStore(raw, mapped.pmem, size, true, false);
+    EXPECT_EQ(memcmp(mapped.pmem, from_gzip.data(), size), 0);
+}
+
+/** A mapped raw store is private to the memory restored from it. */
+TEST_F(MemoryStoreTest, RawMappingIsPrivate)
+{
+    const Addr size = 8 * pageSize;
+    MappedImage image(size, 0);
+    fillSparse(image.pmem, size);
+
+    const std::string raw = path("raw.pmem");
+    writeRawStore(raw, image.pmem, size, pageSize);
+
+    MappedImage mapped(size, 0);
+    readRawStore(raw, mapped.pmem, size, true, false);
+    memset(mapped.pmem, 0x5a, size);
+
+    // The store is unchanged, even when rewritten from its own mapping
+    std::vector<uint8_t> read_in(size);
+    readRawStore(raw, read_in.data(), size, false, false);
+    EXPECT_EQ(memcmp(read_in.data(), image.pmem, size), 0);
+
+    writeRawStore(raw, mapped.pmem, size, pageSize);
+    readRawStore(raw, read_in.data(), size, false, false);
+    EXPECT_EQ(memcmp(read_in.data(), mapped.pmem, size), 0);
+}
+
+/** Images that are all zeros or hold no zero page round-trip too. */
+TEST_F(MemoryStoreTest, RawExtremes)
+{
+    const Addr size = 4 * pageSize;
+    for (uint8_t fill : {0x00, 0x11}) {
+        MappedImage image(size, fill);
+        const std::string raw = path("raw.pmem");
+        writeRawStore(raw, image.pmem, size, pageSize);
+
+        MappedImage mapped(size, 0xa5);
+        readRawStore(raw, mapped.pmem, size, true, false);
+        EXPECT_EQ(memcmp(mapped.pmem, image.pmem, size), 0);
+    }
+}
+
+/** Every index of every job is handled once, by a pool kept across jobs. */
+TEST(StoreWorkersTest, ParallelFor)
+{
+    for (unsigned num_threads : {1, 2, 4}) {
+        StoreWorkers workers(num_threads);
+        EXPECT_EQ(workers.size(), num_threads);
+
+        for (uint64_t job = 0; job < 100; job++) {
+            const uint64_t begin = job % 3;
+            const uint64_t end = begin + job % 17;
+            std::vector<std::atomic<int>> calls(end);
+            workers.parallelFor(begin, end, [&](uint64_t i) { calls[i]++; });
+            for (uint64_t i = 0; i < end; i++)
+                ASSERT_EQ(calls[i], i >= begin ? 1 : 0);
+        }
+    }
+}
+
+/**
+ * Chunked stores restore the same bytes as gzip stores, with sparse
+ * chunks, all-zero chunks, incompressible chunks and a partial last
+ * chunk.
+ */
+TEST_F(MemoryStoreTest, ChunkedMatchesGzip)
+{
+    const Addr mib = 1 << 20;
+    const Addr size = 3 * mib + 5 * pageSize;
+    MappedImage image(size, 0);
+
+    // A sparse chunk, an all-zero chunk and an incompressible chunk
+    fillSparse(image.pmem, mib);
+    std::mt19937 rng(1);
+    for (Addr i = 2 * mib; i < 3 * mib; i++)
+        image.pmem[i] = rng();
+    // A partial chunk compressing well, ending with a zero page
+    for (Addr i = 3 * mib; i < size - pageSize; i++)
+        image.pmem[i] = i / 64;
+
+    const std::string gzip = path("gzip.pmem");
+    writeGzipStore(gzip, image.pmem, size);
+    std::vector<uint8_t> from_gzip(size, 0xa5);
+    readGzipStore(gzip, from_gzip.data(), size);
+    ASSERT_EQ(memcmp(from_gzip.data(), image.pmem, size), 0);
+
+    for (unsigned num_threads : {1, 3}) {
+        StoreWorkers workers(num_threads);
+        const std::string chunked = path("chunked.pmem");
+        writeChunkedStore(chunked, image.pmem, size, pageSize, workers);
+
+        // The pages of restored chunks are cleared as needed
+        MappedImage restored(size, 0xa5);
+        readChunkedStore(chunked, restored.pmem, size, workers);
+        EXPECT_EQ(memcmp(restored.pmem, from_gzip.data(), size), 0);
+
+        MappedImage clean(size, 0);
+        readChunkedStore(chunked, clean.pmem, size, workers);
+        EXPECT_EQ(memcmp(clean.pmem, from_gzip.data(), size), 0);
+    }
+}
+
+/** Images that are all zeros, or only hold data, round-trip too. */
+TEST_F(MemoryStoreTest, ChunkedExtremes)
+{
+    const Addr size = (1 << 20) + 3 * pageSize;
+    StoreWorkers workers(2);
+    for (uint8_t fill : {0x00, 0x11}) {
+        MappedImage image(size, fill);
+        const std::string chunked = path("chunked.pmem");
+        writeChunkedStore(chunked, image.pmem, size, pageSize, workers);
+
+        MappedImage restored(size, 0xa5);
+        readChunkedStore(chunked, restored.pmem, size, workers);
+        EXPECT_EQ(memcmp(restored.pmem, image.pmem, size), 0);
+    }
+}
+
+/** Zero pages are left out of the chunks, rather than compressed. */
+TEST_F(MemoryStoreTest, ChunkedSkipsZeroPages)
+{
+    const Addr size = 1 << 20;
+    const Addr num_pages = size / pageSize;
+    MappedImage image(size, 0);
+    std::mt19937 rng(2);
+    for (Addr i = 0; i < pageSize; i++)
+        image.pmem[i] = rng();
+
+    StoreWorkers workers(1);
+    const std::string chunked = path("chunked.pmem");
+    writeChunkedStore(chunked, image.pmem, size, pageSize, workers);
+
+    // Header, index, page bitmap and the uncompressible page
+    FILE *file = fopen(chunked.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    fseek(file, 0, SEEK_END);
+    const long file_size = ftell(file);
+    fclose(file);
+    EXPECT_LE(file_size, 64 + 8 + (long)num_pages / 8 + (long)pageSize);
+
+    MappedImage restored(size, 0xa5);
+    readChunkedStore(chunked, restored.pmem, size, workers);
+    EXPECT_EQ(memcmp(restored.pmem, image.pmem, size), 0);
+}
+
+/**
+ * Restore a store of any format, following the parents of delta stores.
+ */
+static void
+readAnyStore(const std::string &filepath, const std::string &format,
+             uint8_t *pmem, Addr size)
+{
+    if (format == "gzip") {
+        readGzipStore(filepath, pmem, size);
+    } else if (format == "raw") {
+        readRawStore(filepath, pmem, size, false, false);
+    } else {
+        ASSERT_EQ(format, "delta");
+        readDeltaStore(filepath, pmem, size,
+            [&](const std::string &parent, const std::string &fmt) {
+                readAnyStore(parent, fmt, pmem, size);
+            });
+    }
+}
+
+/**
+ * Delta stores restore the same bytes as full stores of the same
+ * image, through a chain of parents.
+ */
+TEST_F(MemoryStoreTest, DeltaMatchesFullStore)
+{
+    const Addr num_pages = 37;
+    const Addr size = num_pages * pageSize - 100;
+    MappedImage image(size, 0);
+    fillSparse(image.pmem, size);
+
+    const std::string base = path("base.pmem");
+    writeRawStore(base, image.pmem, size, pageSize);
+
+    // Dirty some pages, including clearing a page and the partial last
+    // page, and take a delta of the base
+    std::vector<bool> dirty(num_pages, false);
+    for (Addr page : {0, 4, 5, 17, 36}) {
+        const Addr len = std::min(pageSize, size - page * pageSize);
+        memset(image.pmem + page * pageSize, page == 4 ? 0 : page, len);
+        dirty[page] = true;
+    }
+    const std::string delta1 = path("delta1.pmem");
+    writeDeltaStore(delta1, image.pmem, size, pageSize, dirty,
+                    "base.pmem", "raw");
+
+    // Take a delta of the delta, with an absolute parent path
+    std::vector<bool> dirty2(num_pages, false);
+    const uint8_t before = image.pmem[9 * pageSize + 3];
+    image.pmem[9 * pageSize + 3] = before ^ 0x5a;
+    dirty2[9] = true;
+    const std::string delta2 = path("delta2.pmem");
+    writeDeltaStore(delta2, image.pmem, size, pageSize, dirty2,
+                    delta1, "delta");
+
+    // A delta without dirty pages is its parent
+    const std::string delta3 = path("delta3.pmem");
+    writeDeltaStore(delta3, image.pmem, size, pageSize,
+                    std::vector<bool>(num_pages, false),
+                    "delta2.pmem", "delta");
+
+    // The fallback when deltas are not written
+    const std::string full = path("full.pmem");
+    writeGzipStore(full, image.pmem, size);
+    std::vector<uint8_t> from_full(size, 0xa5);
+    readGzipStore(full, from_full.data(), size);
+    ASSERT_EQ(memcmp(from_full.data(), image.pmem, size), 0);
+
+    for (const auto &delta : {delta2, delta3}) {
+        std::vector<uint8_t> restored(size, 0xa5);
+        readAnyStore(delta, "delta", restored.data(), size);
+        EXPECT_EQ(restored, from_full) << delta;
+    }
+
+    // The delta only holds the pages that changed
+    std::vector<uint8_t> at_delta1(size, 0xa5);
+    readAnyStore(delta1, "delta", at_delta1.data(), size);
+    EXPECT_EQ(at_delta1[9 * pageSize + 3], before);
+    at_delta1[9 * pageSize + 3] ^= 0x5a;
+    EXPECT_EQ(at_delta1, from_full);
+}
+
+/**
+ * The pages written after clearing the soft-dirty bits are found
+ * again, and a delta of them restores the same bytes as a full store.
+ * This needs a kernel built with CONFIG_MEM_SOFT_DIRTY.
+ */
+TEST_F(MemoryStoreTest, DeltaOfSoftDirtyPages)
+{
+    if (!softDirtySupported())
+        GTEST_SKIP() << "The kernel doesn't track soft-dirty pages";
+
+    const Addr num_pages = 64;
+    const Addr size = num_pages * pageSize;
+    MappedImage image(size, 0);
+    fillSparse(image.pmem, size);
+
+    const std::string base = path("base.pmem");
+    writeGzipStore(base, image.pmem, size);
+    clearSoftDirty();
+
+    const std::vector<Addr> written = {1, 2, 30, 63};
+    for (Addr page : written)
+        image.pmem[page * pageSize + 7] ^= 0xff;
+
+    std::vector<bool> dirty(num_pages, false);
+    ASSERT_TRUE(readSoftDirty(image.pmem, size, pageSize, dirty));
+    for (Addr page : written)
+        EXPECT_TRUE(dirty[page]) << page;
+
+    const std::string delta = path("delta.pmem");
+    writeDeltaStore(delta, image.pmem, size, pageSize, dirty,
+                    "base.pmem", "gzip");
+
+    const std::string full = path("full.pmem");
+    writeGzipStore(full, image.pmem, size);
+    std::vector<uint8_t> from_full(size, 0xa5);
+    readGzipStore(full, from_full.data(), size);
+
+    std::vector<uint8_t> restored(size, 0xa5);
+    readAnyStore(delta, "delta", restored.data(), size);
+    EXPECT_EQ(restored, from_full);
+    EXPECT_EQ(memcmp(restored.data(), image.pmem, size), 0);
+}
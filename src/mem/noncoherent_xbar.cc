@@ -98,6 +98,16 @@ NoncoherentXBar::~NoncoherentXBar()
         delete l;
 }
 
+void
+NoncoherentXBar::init()
+{
+    BaseXBar::init();
+
+    // neighbours on other event queues talk to the crossbar at the
+    // quantum boundaries
+    spliceCrossQueuePorts();
+}
+
 bool
 NoncoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
 {
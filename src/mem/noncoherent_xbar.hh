@@ -194,6 +194,8 @@ class NoncoherentXBar : public BaseXBar
     NoncoherentXBar(const NoncoherentXBarParams &p);
 
     virtual ~NoncoherentXBar();
+
+    void init() override;
 };
 
 } // namespace gem5
@@ -239,6 +239,27 @@ MemCmd::commandInfo[] =
     { {IsRequest}, InvalidCmd, "TlbiExtSync" },
 };
 
+#if USE_MEM_POOLS
+FreeListPool &
+Packet::pool()
+{
+    // Never destroyed, since packets may still be freed during exit
+    static FreeListPool *the_pool =
+        new FreeListPool("packet", sizeof(Packet));
+    return *the_pool;
+}
+
+namespace
+{
+
+// Create the pools during static initialization, so that they are
+// registered before the pool statistics are set up.
+[[maybe_unused]] FreeListPool &packetPool = Packet::pool();
+[[maybe_unused]] FreeListPool &requestPool = Request::pool();
+
+} // anonymous namespace
+#endif
+
 AddrRange
 Packet::getAddrRange() const
 {
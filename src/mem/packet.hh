@@ -57,9 +57,11 @@
 #include "base/compiler.hh"
 #include "base/extensible.hh"
 #include "base/flags.hh"
+#include "base/free_list_pool.hh"
 #include "base/logging.hh"
 #include "base/printable.hh"
 #include "base/types.hh"
+#include "config/use_mem_pools.hh"
 #include "mem/htm.hh"
 #include "mem/request.hh"
 #include "sim/byteswap.hh"
@@ -353,6 +355,9 @@ class Packet : public Printable, public Extensible<Packet>
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// The dynamic data is stored in the packet itself and must
+        /// not be freed
+        INLINE_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -386,6 +391,14 @@ class Packet : public Printable, public Extensible<Packet>
     */
     PacketDataPtr data;
 
+#if USE_MEM_POOLS
+    /// Payloads up to this size are stored in the packet itself.
+    static constexpr unsigned inlineDataSize = 64;
+
+    /// Storage for small dynamic payloads.
+    uint8_t inlineData[inlineDataSize];
+#endif
+
     /// The address of the request.  This address could be virtual or
     /// physical, depending on the system configuration.
     Addr addr;
@@ -1054,6 +1067,23 @@ class Packet : public Printable, public Extensible<Packet>
         deleteData();
     }
 
+#if USE_MEM_POOLS
+    /** Pool the packets are allocated from. */
+    static FreeListPool &pool();
+
+    static void *
+    operator new(size_t size)
+    {
+        return pool().allocate(size);
+    }
+
+    static void
+    operator delete(void *ptr, size_t size)
+    {
+        pool().deallocate(ptr, size);
+    }
+#endif
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1355,10 +1385,10 @@ class Packet : public Printable, public Extensible<Packet>
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(DYNAMIC_DATA) && !flags.isSet(INLINE_DATA))
             delete [] data;
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|INLINE_DATA);
         data = NULL;
     }
 
@@ -1371,6 +1401,13 @@ class Packet : public Printable, public Extensible<Packet>
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
             flags.set(DYNAMIC_DATA);
+#if USE_MEM_POOLS
+            if (getSize() <= inlineDataSize) {
+                flags.set(INLINE_DATA);
+                data = inlineData;
+                return;
+            }
+#endif
             data = new uint8_t[getSize()];
         }
     }
@@ -39,17 +39,23 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/user.h>
 #include <unistd.h>
-#include <zlib.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <thread>
 
+#include "base/atomicio.hh"
 #include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
@@ -76,15 +82,81 @@ namespace gem5
 namespace memory
 {
 
+namespace
+{
+
+/**
+ * The canonical path of a file that may not exist yet, in a directory
+ * that does.
+ */
+std::string
+canonicalPath(const std::string &path)
+{
+    auto slash = path.rfind('/');
+    std::string dir = slash == std::string::npos ? "." : path.substr(0, slash);
+    char *real_dir = realpath(dir.c_str(), nullptr);
+    fatal_if(!real_dir, "Can't resolve checkpoint directory '%s': %s\n",
+             dir, strerror(errno));
+    std::string canonical = std::string(real_dir) + "/" +
+        path.substr(slash == std::string::npos ? 0 : slash + 1);
+    free(real_dir);
+    return canonical;
+}
+
+/**
+ * The path of a file relative to a directory, both being canonical,
+ * so that checkpoints can be moved together.
+ */
+std::string
+relativePath(const std::string &file, const std::string &dir)
+{
+    auto split = [](const std::string &path) {
+        std::vector<std::string> parts;
+        std::istringstream ss(path);
+        for (std::string part; std::getline(ss, part, '/');) {
+            if (!part.empty())
+                parts.push_back(part);
+        }
+        return parts;
+    };
+
+    auto file_parts = split(file);
+    auto dir_parts = split(dir);
+    size_t common = 0;
+    while (common < dir_parts.size() && common + 1 < file_parts.size() &&
+           dir_parts[common] == file_parts[common]) {
+        common++;
+    }
+
+    std::string rel;
+    for (size_t i = common; i < dir_parts.size(); i++)
+        rel += "../";
+    for (size_t i = common; i < file_parts.size(); i++)
+        rel += file_parts[i] + (i + 1 < file_parts.size() ? "/" : "");
+    return rel;
+}
+
+} // anonymous namespace
+
+std::vector<PhysicalMemory *> PhysicalMemory::deltaMemories;
+
 PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               MemoryStoreFormat store_format,
+                               unsigned store_threads, bool store_delta) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
-    pageSize(sysconf(_SC_PAGE_SIZE))
+    pageSize(sysconf(_SC_PAGE_SIZE)), storeFormat(store_format),
+    storeThreads(store_threads ? store_threads :
+                 std::max(1u, std::thread::hardware_concurrency())),
+    storeDelta(store_delta && softDirtySupported())
 {
+    warn_if(store_delta && !storeDelta, "The kernel doesn't track "
+            "soft-dirty pages. Writing full memory stores.\n");
+
     // Register cleanup callback if requested.
     if (auto_unlink_shared_backstore && !sharedBackstore.empty()) {
         registerExitCallback([=]() { shm_unlink(shared_backstore.c_str()); });
@@ -264,11 +336,68 @@ PhysicalMemory::createBackingStore(
 
 PhysicalMemory::~PhysicalMemory()
 {
+    deltaMemories.erase(std::remove(deltaMemories.begin(),
+                                    deltaMemories.end(), this),
+                        deltaMemories.end());
+
     // unmap the backing store
     for (auto& s : backingStore)
         munmap((char*)s.pmem, s.range.size());
 }
 
+void
+PhysicalMemory::countWrites()
+{
+    if (!writeCounts.empty())
+        return;
+
+    for (const auto &s : backingStore) {
+        writeCounts.emplace_back(new std::atomic<uint32_t>[
+            divCeil(s.range.size(), AbstractMemory::WriteCountPageSize)]());
+    }
+
+    // The memories sharing an interleaved backing store share its
+    // counters, since they are indexed from the start of the range
+    for (auto *m : memories) {
+        for (size_t i = 0; i < backingStore.size(); i++) {
+            if (m->toHostAddr(m->getAddrRange().start()) ==
+                backingStore[i].pmem) {
+                m->setWriteCounts(writeCounts[i].get());
+            }
+        }
+    }
+}
+
+const std::atomic<uint32_t> *
+PhysicalMemory::writeCount(Addr addr) const
+{
+    for (size_t i = 0; i < writeCounts.size(); i++) {
+        const BackingStoreEntry &s = backingStore[i];
+        if (s.inAddrMap && s.range.contains(addr)) {
+            return &writeCounts[i][(addr - s.range.start()) /
+                                   AbstractMemory::WriteCountPageSize];
+        }
+    }
+    return nullptr;
+}
+
+void
+PhysicalMemory::recordCountedWrite(Addr addr, Addr size)
+{
+    for (size_t i = 0; i < writeCounts.size(); i++) {
+        const BackingStoreEntry &s = backingStore[i];
+        if (s.inAddrMap && s.range.contains(addr)) {
+            const Addr page_size = AbstractMemory::WriteCountPageSize;
+            const Addr last = std::min(addr + size - 1, s.range.end() - 1);
+            for (Addr page = (addr - s.range.start()) / page_size;
+                 page <= (last - s.range.start()) / page_size; page++) {
+                writeCounts[i][page].fetch_add(1, std::memory_order_release);
+            }
+            return;
+        }
+    }
+}
+
 bool
 PhysicalMemory::isMemAddr(Addr addr) const
 {
@@ -363,10 +492,7 @@ void
 PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
                                AddrRange range, uint8_t* pmem) const
 {
-    // we cannot use the address range for the name as the
-    // memories that are not part of the address map can overlap
-    std::string filename =
-        name() + ".store" + std::to_string(store_id) + ".pmem";
+    std::string filename = storeFilename(store_id);
     Addr range_size = range.size();
 
     DPRINTF(Checkpoint, "Serializing physical memory %s with size %d\n",
@@ -378,32 +504,56 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
 
     // write memory file
     std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
-    gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'\n",
-              filename);
-
-    uint64_t pass_size = 0;
-
-    // gzwrite fails if (int)len < 0 (gzwrite returns int)
-    for (uint64_t written = 0; written < range.size();
-         written += pass_size) {
-        pass_size = (uint64_t)INT_MAX < (range.size() - written) ?
-            (uint64_t)INT_MAX : (range.size() - written);
-
-        if (gzwrite(compressed_mem, pmem + written,
-                    (unsigned int) pass_size) != (int) pass_size) {
-            fatal("Write failed on physical memory checkpoint file '%s'\n",
-                  filename);
-        }
+
+    if (writesDelta(store_id, filepath)) {
+        std::string store_format = "delta";
+        SERIALIZE_SCALAR(store_format);
+        writeDeltaStore(filepath, store_id, pmem, range_size);
+        return;
     }
 
-    // close the compressed stream and check that the exit status
-    // is zero
-    if (gzclose(compressed_mem))
-        fatal("Close failed on physical memory checkpoint file '%s'\n",
-              filename);
+    std::string store_format =
+        MemoryStoreFormatStrings[static_cast<int>(storeFormat)];
+    SERIALIZE_SCALAR(store_format);
 
+    if (storeFormat == MemoryStoreFormat::raw) {
+        writeRawStore(filepath, pmem, range_size, pageSize);
+    } else if (storeFormat == MemoryStoreFormat::chunked) {
+        writeChunkedStore(filepath, pmem, range_size, pageSize,
+                          workers());
+    } else {
+        writeGzipStore(filepath, pmem, range_size);
+    }
+}
+
+std::string
+PhysicalMemory::storeFilename(unsigned int store_id) const
+{
+    // we cannot use the address range for the name as the
+    // memories that are not part of the address map can overlap
+    return name() + ".store" + std::to_string(store_id) + ".pmem";
+}
+
+bool
+PhysicalMemory::writesDelta(unsigned int store_id,
+                            const std::string &filepath) const
+{
+    return storeDelta && store_id < storeParents.size() &&
+        !storeParents[store_id].filepath.empty() &&
+        storeParents[store_id].filepath != canonicalPath(filepath);
+}
+
+void
+PhysicalMemory::checkpointTaken()
+{
+    if (!storeDelta)
+        return;
+
+    for (unsigned int i = 0; i < backingStore.size(); i++) {
+        std::string filepath = CheckpointIn::dir() + "/" + storeFilename(i);
+        setParent(i, filepath, writesDelta(i, filepath) ? "delta" :
+                  MemoryStoreFormatStrings[static_cast<int>(storeFormat)]);
+    }
 }
 
 void
@@ -434,8 +584,6 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
 void
 PhysicalMemory::unserializeStore(CheckpointIn &cp)
 {
-    const uint32_t chunk_size = 16384;
-
     unsigned int store_id;
     UNSERIALIZE_SCALAR(store_id);
 
@@ -443,13 +591,7 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
-
     // we've already got the actual backing store mapped
-    uint8_t* pmem = backingStore[store_id].pmem;
     AddrRange range = backingStore[store_id].range;
 
     Addr range_size;
@@ -462,19 +604,123 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
-    uint64_t curr_size = 0;
-    uint32_t bytes_read;
-    while (curr_size < range.size()) {
-        bytes_read = gzread(compressed_mem, pmem, chunk_size);
-        if (bytes_read == 0)
-            break;
-        curr_size += bytes_read;
-        pmem += bytes_read;
+    // checkpoints that predate the store formats are upgraded to gzip
+    std::string store_format;
+    UNSERIALIZE_SCALAR(store_format);
+
+    readStore(filepath, store_format, backingStore[store_id]);
+
+    if (storeDelta)
+        setParent(store_id, filepath, store_format);
+}
+
+StoreWorkers &
+PhysicalMemory::workers() const
+{
+    if (!storeWorkers)
+        storeWorkers = std::make_unique<StoreWorkers>(storeThreads);
+    return *storeWorkers;
+}
+
+void
+PhysicalMemory::readStore(const std::string &filepath,
+                          const std::string &format,
+                          const BackingStoreEntry &store) const
+{
+    if (format == "gzip") {
+        readGzipStore(filepath, store.pmem, store.range.size());
+    } else if (format == "raw") {
+        // A shared backing store must be kept, so it is read in
+        readRawStore(filepath, store.pmem, store.range.size(),
+                     store.shmFd == -1, mmapUsingNoReserve);
+    } else if (format == "chunked") {
+        readChunkedStore(filepath, store.pmem, store.range.size(),
+                         workers());
+    } else if (format == "delta") {
+        readDeltaStore(filepath, store);
+    } else {
+        fatal("Unknown physical memory store format '%s'\n", format);
+    }
+}
+
+std::vector<bool>
+PhysicalMemory::dirtyPages(unsigned int store_id) const
+{
+    const BackingStoreEntry &store = backingStore[store_id];
+    std::vector<bool> dirty = storeParents[store_id].dirty;
+    fatal_if(!readSoftDirty(store.pmem, store.range.size(), pageSize, dirty),
+             "Can't read the soft-dirty bits of the process: %s\n",
+             strerror(errno));
+    return dirty;
+}
+
+void
+PhysicalMemory::setParent(unsigned int store_id,
+                          const std::string &filepath,
+                          const std::string &format)
+{
+    if (storeParents.size() < backingStore.size())
+        storeParents.resize(backingStore.size());
+
+    StoreParent &parent = storeParents[store_id];
+    parent.filepath = canonicalPath(filepath);
+    parent.format = format;
+
+    // Clearing the soft-dirty bits affects every memory writing delta
+    // stores, so first record the pages the others wrote since their
+    // parent.
+    if (std::find(deltaMemories.begin(), deltaMemories.end(), this) ==
+            deltaMemories.end()) {
+        deltaMemories.push_back(this);
+    }
+    for (auto *memory : deltaMemories) {
+        for (unsigned int i = 0; i < memory->storeParents.size(); i++) {
+            if (memory == this && i == store_id)
+                continue;
+            StoreParent &other = memory->storeParents[i];
+            if (other.filepath.empty())
+                continue;
+            other.dirty = memory->dirtyPages(i);
+        }
     }
+    clearSoftDirty();
 
-    if (gzclose(compressed_mem))
-        fatal("Close failed on physical memory checkpoint file '%s'\n",
-              filename);
+    parent.dirty.assign(
+        divCeil(backingStore[store_id].range.size(), (Addr)pageSize), false);
+}
+
+void
+PhysicalMemory::writeDeltaStore(const std::string &filepath,
+                                unsigned int store_id, const uint8_t *pmem,
+                                Addr size) const
+{
+    const StoreParent &parent = storeParents[store_id];
+    const std::vector<bool> dirty = dirtyPages(store_id);
+    assert(dirty.size() == divCeil(size, (Addr)pageSize));
+
+    const std::string canonical = canonicalPath(filepath);
+    const std::string parent_path = relativePath(
+        parent.filepath, canonical.substr(0, canonical.rfind('/')));
+
+    DPRINTF(Checkpoint, "Writing %d of %d pages to delta store %s, "
+            "parent %s\n", std::count(dirty.begin(), dirty.end(), true),
+            dirty.size(), filepath, parent.filepath);
+
+    memory::writeDeltaStore(filepath, pmem, size, pageSize, dirty,
+                            parent_path, parent.format);
+}
+
+void
+PhysicalMemory::readDeltaStore(const std::string &filepath,
+                               const BackingStoreEntry &store) const
+{
+    memory::readDeltaStore(filepath, store.pmem, store.range.size(),
+        [&](const std::string &parent_path,
+            const std::string &parent_format) {
+            DPRINTF(Checkpoint, "Restoring parent %s of delta store %s\n",
+                    parent_path, filepath);
+            readStore(parent_path, parent_format, store);
+        });
 }
 
 } // namespace memory
@@ -38,12 +38,16 @@
 #ifndef __MEM_PHYSICAL_HH__
 #define __MEM_PHYSICAL_HH__
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
+#include "enums/MemoryStoreFormat.hh"
+#include "mem/memory_store.hh"
 #include "mem/packet.hh"
 #include "sim/serialize.hh"
 
@@ -158,10 +162,48 @@ class PhysicalMemory : public Serializable
 
     long pageSize;
 
+    // The format the backing store is checkpointed in
+    const MemoryStoreFormat storeFormat;
+
+    // The number of threads used for chunked stores
+    const unsigned storeThreads;
+
+    // The threads working on chunked stores, see workers()
+    mutable std::unique_ptr<StoreWorkers> storeWorkers;
+
+    // Write delta stores once a store has a parent
+    const bool storeDelta;
+
+    /**
+     * The store file a backing store was last written to or restored
+     * from, which is the parent of its next delta store.
+     */
+    struct StoreParent
+    {
+        // Canonical path of the store file
+        std::string filepath;
+        // The format of the store file
+        std::string format;
+        // The pages written before the soft-dirty bits of the process
+        // were last cleared, since the store file was written
+        std::vector<bool> dirty;
+    };
+
+    // The parents of the backing stores, indexed by store id
+    std::vector<StoreParent> storeParents;
+
+    // All the physical memories writing delta stores, which share the
+    // soft-dirty bits of the process
+    static std::vector<PhysicalMemory *> deltaMemories;
+
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
 
+    // The number of writes to each page of the backing stores, indexed
+    // by store id, if the writes are counted
+    std::vector<std::unique_ptr<std::atomic<uint32_t>[]>> writeCounts;
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -182,6 +224,62 @@ class PhysicalMemory : public Serializable
                             bool conf_table_reported,
                             bool in_addr_map, bool kvm_map);
 
+    /**
+     * The threads working on chunked stores, which are only started
+     * once they are needed.
+     */
+    StoreWorkers &workers() const;
+
+    /**
+     * Restore a backing store from a file of the given format,
+     * resolving the parents of delta stores.
+     */
+    void readStore(const std::string &filepath, const std::string &format,
+                   const BackingStoreEntry &store) const;
+
+    /** Count a write once writes are counted, see recordWrite(). */
+    void recordCountedWrite(Addr addr, Addr size);
+
+    /**
+     * The file a backing store is checkpointed to in the current
+     * checkpoint directory.
+     */
+    std::string storeFilename(unsigned int store_id) const;
+
+    /**
+     * Check if a backing store is written as a delta store, which it
+     * is once it has a parent other than the file it is written to.
+     */
+    bool writesDelta(unsigned int store_id,
+                     const std::string &filepath) const;
+
+    /**
+     * Get the pages of a backing store written since its parent.
+     */
+    std::vector<bool> dirtyPages(unsigned int store_id) const;
+
+    /**
+     * Record the file a backing store was just written to or restored
+     * from as the parent of its next delta store, and start tracking
+     * the pages written from now on.
+     */
+    void setParent(unsigned int store_id, const std::string &filepath,
+                   const std::string &format);
+
+    /**
+     * Write the pages of a backing store written since its parent,
+     * along with a reference to the store file of the parent.
+     */
+    void writeDeltaStore(const std::string &filepath, unsigned int store_id,
+                         const uint8_t *pmem, Addr size) const;
+
+    /**
+     * Restore a backing store from a delta store, after first
+     * restoring its parent.
+     */
+    void readDeltaStore(const std::string &filepath,
+                        const BackingStoreEntry &store) const;
+
   public:
 
     /**
@@ -191,7 +289,9 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   MemoryStoreFormat store_format=MemoryStoreFormat::gzip,
+                   unsigned store_threads=0, bool store_delta=false);
 
     /**
      * Unmap all the backing store we have used.
@@ -245,6 +345,38 @@ class PhysicalMemory : public Serializable
     std::vector<BackingStoreEntry> getBackingStore() const
     { return backingStore; }
 
+    /**
+     * Count the writes to each page of the memories in the global
+     * address map, for the CPUs caching the contents of memory, e.g.,
+     * instructions, to notice the writes of any other requestor.
+     */
+    void countWrites();
+
+    /**
+     * Get the number of writes to the page holding an address, which
+     * changes on every write to the page once countWrites() is called.
+     *
+     * @param addr A physical address
+     * @return The counter of the page, or nullptr if the address is not
+     *         in a memory or writes are not counted
+     */
+    const std::atomic<uint32_t> *writeCount(Addr addr) const;
+
+    /**
+     * Count a write to memory which may not reach the memory itself,
+     * e.g., as it is held by a cache, or which bypasses the memory
+     * system. The count should change once the data is written.
+     *
+     * @param addr The physical address of the write
+     * @param size The size of the write
+     */
+    void
+    recordWrite(Addr addr, Addr size)
+    {
+        if (!writeCounts.empty())
+            recordCountedWrite(addr, size);
+    }
+
     /**
      * Perform an untimed memory access and update all the state
      * (e.g. locked addresses) and statistics accordingly. The packet
@@ -284,6 +416,14 @@ class PhysicalMemory : public Serializable
     void serializeStore(CheckpointOut &cp, unsigned int store_id,
                         AddrRange range, uint8_t* pmem) const;
 
+    /**
+     * Make the store files of the checkpoint just written the parents
+     * of the next delta stores. Called once all the objects are
+     * serialized, as serialize() doesn't change the state of the
+     * memory.
+     */
+    void checkpointTaken();
+
     /**
      * Unserialize the memories in the system. As with the
      * serialization, this action is independent of how the address
@@ -174,10 +174,30 @@ RequestPort::getAddrRanges() const
     return _responsePort->getAddrRanges();
 }
 
+void
+RequestPort::getSnoopEventQueues(std::set<EventQueue *> &eqs) const
+{
+    if (isSnooping() && ownerObject())
+        eqs.insert(ownerObject()->eventQueue());
+}
+
+void
+RequestPort::getPeerExpressSnoopEventQueues(
+        std::set<EventQueue *> &eqs) const
+{
+    _responsePort->getExpressSnoopEventQueues(eqs);
+}
+
+bool
+RequestPort::peerOriginatesSnoops() const
+{
+    return _responsePort->originatesSnoops();
+}
+
 void
 RequestPort::printAddr(Addr a)
 {
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
         a, 1, 0, Request::funcRequestorId);
 
     Packet pkt(req, MemCmd::PrintReq);
@@ -244,6 +264,13 @@ ResponsePort::~ResponsePort()
 {
 }
 
+void
+ResponsePort::getExpressSnoopEventQueues(std::set<EventQueue *> &eqs) const
+{
+    if (ownerObject())
+        eqs.insert(ownerObject()->eventQueue());
+}
+
 void
 ResponsePort::responderUnbind()
 {
@@ -47,6 +47,7 @@
 #define __MEM_PORT_HH__
 
 #include <memory>
+#include <set>
 #include <sstream>
 #include <stack>
 #include <string>
@@ -61,6 +62,7 @@
 namespace gem5
 {
 
+class EventQueue;
 class SimObject;
 
 /** Forward declaration */
@@ -174,6 +176,30 @@ class RequestPort: public Port, public AtomicRequestProtocol,
      */
     virtual bool isSnooping() const { return false; }
 
+    /**
+     * Collect the event queues of the objects that timing snoops sent
+     * to this port may reach. The default implementation adds the event
+     * queue of the owner of a snooping port, so ports that forward
+     * snoops further upstream have to override this function. This is
+     * used to find the snoops that would cross event queues.
+     *
+     * @param eqs Set to add the event queues to
+     */
+    virtual void getSnoopEventQueues(std::set<EventQueue *> &eqs) const;
+
+    /**
+     * Collect the event queues of the objects that express snoops sent
+     * through this port may reach, see
+     * ResponsePort::getExpressSnoopEventQueues().
+     */
+    void getPeerExpressSnoopEventQueues(std::set<EventQueue *> &eqs) const;
+
+    /**
+     * Check if the peer may send timing snoops that it did not receive
+     * itself, see ResponsePort::originatesSnoops().
+     */
+    bool peerOriginatesSnoops() const;
+
     /**
      * Get the address ranges of the connected responder port.
      */
@@ -374,6 +400,39 @@ class ResponsePort : public Port, public AtomicResponseProtocol,
      */
     bool isSnooping() const { return _requestPort->isSnooping(); }
 
+    /**
+     * Collect the event queues of the objects that timing snoops sent
+     * through this port may reach.
+     *
+     * @param eqs Set to add the event queues to
+     */
+    void
+    getPeerSnoopEventQueues(std::set<EventQueue *> &eqs) const
+    {
+        _requestPort->getSnoopEventQueues(eqs);
+    }
+
+    /**
+     * Collect the event queues of the objects that express snoops sent
+     * to this port may reach, that is, the objects on the path to memory
+     * and all the objects snooped along the way. The default
+     * implementation adds the event queue of the owner of the port, so
+     * ports that forward requests further downstream have to override
+     * this function.
+     *
+     * @param eqs Set to add the event queues to
+     */
+    virtual void getExpressSnoopEventQueues(
+        std::set<EventQueue *> &eqs) const;
+
+    /**
+     * Check if the owner may send timing snoops through this port that
+     * it did not receive itself, like a cache checking if the blocks it
+     * evicts are cached above it. The default implementation assumes it
+     * does not.
+     */
+    virtual bool originatesSnoops() const { return false; }
+
     /**
      * Called by the owner to send a range change
      */
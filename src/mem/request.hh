@@ -60,7 +60,9 @@
 #include "base/compiler.hh"
 #include "base/extensible.hh"
 #include "base/flags.hh"
+#include "base/free_list_pool.hh"
 #include "base/types.hh"
+#include "config/use_mem_pools.hh"
 #include "cpu/inst_seq.hh"
 #include "mem/htm.hh"
 #include "sim/cur_tick.hh"
@@ -530,6 +532,37 @@ class Request : public Extensible<Request>
 
     ~Request() {}
 
+    /**
+     * Pool the requests are allocated from. Its blocks also hold the
+     * control block of the shared pointer.
+     */
+    static FreeListPool &
+    pool()
+    {
+        // Never destroyed, since requests may still be freed during exit
+        static FreeListPool *the_pool =
+            new FreeListPool("request", sizeof(Request) + 4 * sizeof(void *));
+        return *the_pool;
+    }
+
+    /**
+     * Create a new request. This should be used instead of
+     * std::make_shared, so that requests are allocated from the
+     * request pool when pools are enabled.
+     */
+    template <typename... Args>
+    static RequestPtr
+    create(Args&&... args)
+    {
+#if USE_MEM_POOLS
+        return std::allocate_shared<Request>(
+                FreeListPoolAllocator<Request>(pool()),
+                std::forward<Args>(args)...);
+#else
+        return std::make_shared<Request>(std::forward<Args>(args)...);
+#endif
+    }
+
     /**
      * Factory method for creating memory management requests, with
      * unspecified addr and size.
@@ -537,7 +570,7 @@ class Request : public Extensible<Request>
     static RequestPtr
     createMemManagement(Flags flags, RequestorID id)
     {
-        auto mgmt_req = std::make_shared<Request>();
+        auto mgmt_req = create();
         mgmt_req->_flags.set(flags);
         mgmt_req->_requestorId = id;
         mgmt_req->_time = curTick();
@@ -619,8 +652,8 @@ class Request : public Extensible<Request>
         assert(hasVaddr());
         assert(!hasPaddr());
         assert(split_addr > _vaddr && split_addr < _vaddr + _size);
-        req1 = std::make_shared<Request>(*this);
-        req2 = std::make_shared<Request>(*this);
+        req1 = Request::create(*this);
+        req2 = Request::create(*this);
         req1->_size = split_addr - _vaddr;
         req2->_vaddr = split_addr;
         req2->_size = _size - req1->_size;
@@ -40,6 +40,11 @@
 
 #include "mem/ruby/common/Consumer.hh"
 
+#include <algorithm>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+
 namespace gem5
 {
 
@@ -47,7 +52,8 @@ namespace ruby
 {
 
 Consumer::Consumer(ClockedObject *_em, Event::Priority ev_prio)
-    : m_wakeup_event([this]{ processCurrentEvent(); },
+    : m_wakeup_base(0), m_wakeup_period(1), m_wakeup_bits(0),
+      m_wakeup_event([this]{ processCurrentEvent(); },
                     "Consumer Event", false, ev_prio),
       em(_em)
 { }
@@ -55,25 +61,87 @@ Consumer::Consumer(ClockedObject *_em, Event::Priority ev_prio)
 void
 Consumer::scheduleEvent(Cycles timeDelta)
 {
-    m_wakeup_ticks.insert(em->clockEdge(timeDelta));
+    insertWakeup(em->clockEdge(timeDelta));
     scheduleNextWakeup();
 }
 
 void
 Consumer::scheduleEventAbsolute(Tick evt_time)
 {
-    m_wakeup_ticks.insert(
-        divCeil(evt_time, em->clockPeriod()) * em->clockPeriod());
+    insertWakeup(divCeil(evt_time, em->clockPeriod()) * em->clockPeriod());
     scheduleNextWakeup();
 }
 
+void
+Consumer::insertWakeup(Tick time)
+{
+    if (!m_wakeup_bits)
+        rebaseWakeups(time);
+
+    int bit = wakeupBit(time);
+    if (bit >= 0)
+        m_wakeup_bits |= 1ULL << bit;
+    else
+        m_wakeup_overflow.insert(time);
+}
+
+Tick
+Consumer::nextWakeup(Tick time) const
+{
+    Tick next = MaxTick;
+
+    auto it = m_wakeup_overflow.lower_bound(time);
+    if (it != m_wakeup_overflow.end())
+        next = *it;
+
+    Tick first = time <= m_wakeup_base ? 0 :
+        divCeil(time - m_wakeup_base, m_wakeup_period);
+    if (first < NumWakeupBits) {
+        uint64_t bits = m_wakeup_bits >> first;
+        if (bits) {
+            next = std::min(next, m_wakeup_base +
+                            (first + findLsbSet(bits)) * m_wakeup_period);
+        }
+    }
+
+    return next;
+}
+
+void
+Consumer::rebaseWakeups(Tick time)
+{
+    if (!m_wakeup_bits) {
+        m_wakeup_base = time;
+        m_wakeup_period = em->clockPeriod();
+    } else {
+        // All the wakeups in the bitmap are at or after time
+        int bit = wakeupBit(time);
+        if (bit <= 0)
+            return;
+        m_wakeup_bits >>= bit;
+        m_wakeup_base = time;
+    }
+
+    // Move the overflow wakeups that now fit in the bitmap
+    Tick limit = m_wakeup_base + NumWakeupBits * m_wakeup_period;
+    auto it = m_wakeup_overflow.lower_bound(m_wakeup_base);
+    while (it != m_wakeup_overflow.end() && *it < limit) {
+        int bit = wakeupBit(*it);
+        if (bit >= 0) {
+            m_wakeup_bits |= 1ULL << bit;
+            it = m_wakeup_overflow.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void
 Consumer::scheduleNextWakeup()
 {
     // look for the next tick in the future to schedule
-    auto it = m_wakeup_ticks.lower_bound(em->clockEdge());
-    if (it != m_wakeup_ticks.end()) {
-        Tick when = *it;
+    Tick when = nextWakeup(em->clockEdge());
+    if (when != MaxTick) {
         assert(when >= em->clockEdge());
         if (m_wakeup_event.scheduled() && (when < m_wakeup_event.when()))
             em->reschedule(m_wakeup_event, when, true);
@@ -85,12 +153,18 @@ Consumer::scheduleNextWakeup()
 void
 Consumer::processCurrentEvent()
 {
-    auto curr = m_wakeup_ticks.begin();
-    assert(em->clockEdge() == *curr);
+    Tick curr = em->clockEdge();
+    assert(nextWakeup(0) == curr);
 
     // remove the current tick from the wakeup list, wake up, and then schedule
     // the next wakeup
-    m_wakeup_ticks.erase(curr);
+    int bit = wakeupBit(curr);
+    if (bit >= 0 && (m_wakeup_bits & (1ULL << bit)))
+        m_wakeup_bits &= ~(1ULL << bit);
+    else
+        m_wakeup_overflow.erase(curr);
+    rebaseWakeups(curr);
+
     wakeup();
     scheduleNextWakeup();
 }
@@ -47,6 +47,7 @@
 #ifndef __MEM_RUBY_COMMON_CONSUMER_HH__
 #define __MEM_RUBY_COMMON_CONSUMER_HH__
 
+#include <cstdint>
 #include <iostream>
 #include <set>
 
@@ -75,7 +76,10 @@ class Consumer
     bool
     alreadyScheduled(Tick time)
     {
-        return m_wakeup_ticks.find(time) != m_wakeup_ticks.end();
+        int bit = wakeupBit(time);
+        if (bit >= 0)
+            return m_wakeup_bits & (1ULL << bit);
+        return m_wakeup_overflow.find(time) != m_wakeup_overflow.end();
     }
 
     ClockedObject *
@@ -88,10 +92,43 @@ class Consumer
     void scheduleEvent(Cycles timeDelta);
 
   private:
-    std::set<Tick> m_wakeup_ticks;
+    static constexpr int NumWakeupBits = 64;
+
+    /**
+     * The pending wakeups. Bit i of m_wakeup_bits stands for a wakeup at
+     * m_wakeup_base + i * m_wakeup_period, which covers the next
+     * NumWakeupBits cycles in the common case. Wakeups that do not fit,
+     * e.g. further in the future or after a clock change, are kept in
+     * m_wakeup_overflow and move to the bitmap as time advances.
+     */
+    Tick m_wakeup_base;
+    Tick m_wakeup_period;
+    uint64_t m_wakeup_bits;
+    std::set<Tick> m_wakeup_overflow;
+
     EventFunctionWrapper m_wakeup_event;
     ClockedObject *em;
 
+    //! The bit standing for a tick, or -1 if it is not in the bitmap
+    int
+    wakeupBit(Tick time) const
+    {
+        if (time < m_wakeup_base)
+            return -1;
+        Tick offset = time - m_wakeup_base;
+        if (offset % m_wakeup_period ||
+            offset / m_wakeup_period >= NumWakeupBits) {
+            return -1;
+        }
+        return offset / m_wakeup_period;
+    }
+
+    void insertWakeup(Tick time);
+    //! The first pending wakeup at or after a tick, or MaxTick
+    Tick nextWakeup(Tick time) const;
+    //! Move the bitmap to start at a tick and refill it from the overflow
+    void rebaseWakeups(Tick time);
+
     void scheduleNextWakeup();
     void processCurrentEvent();
 };
@@ -57,9 +57,8 @@ DataBlock::DataBlock(const DataBlock &cp)
 
     uint8_t *block_update;
     m_block_size = cp.getBlockSize();
-    m_data = new uint8_t[m_block_size];
+    alloc();
     memcpy(m_data, cp.m_data, m_block_size);
-    m_alloc = true;
     // If this data block is involved in an atomic operation, the effect
     // of applying the atomic operations on the data block are recorded in
     // m_atomicLog. If so, we must copy over every entry in the change log
@@ -79,7 +78,10 @@ DataBlock::alloc()
         return;
     }
 
-    m_data = new uint8_t[m_block_size];
+    if (m_block_size <= InlineSize)
+        m_data = m_inline;
+    else
+        m_data = new uint8_t[m_block_size];
     m_alloc = true;
     clear();
 }
@@ -90,10 +92,7 @@ DataBlock::realloc(int blk_size)
     m_block_size = blk_size;
     assert(m_block_size > 0);
 
-    if (m_alloc) {
-        delete [] m_data;
-        m_alloc = false;
-    }
+    freeData();
     alloc();
 }
 
@@ -225,7 +224,7 @@ DataBlock::operator=(const DataBlock & obj)
 {
     // Reallocate if needed
     if (m_alloc && m_block_size != obj.getBlockSize()) {
-        delete [] m_data;
+        freeData();
         m_block_size = obj.getBlockSize();
         alloc();
     } else if (!m_alloc) {
@@ -76,8 +76,7 @@ class DataBlock
 
     ~DataBlock()
     {
-        if (m_alloc)
-            delete [] m_data;
+        freeData();
 
         // If data block involved in atomic
         // operations, free all meta data
@@ -114,10 +113,17 @@ class DataBlock
 
   private:
     void alloc();
+    void freeData();
     uint8_t *m_data = nullptr;
     bool m_alloc = false;
     int m_block_size = 0;
 
+    // Blocks of up to InlineSize bytes are stored in the DataBlock
+    // itself, so that messages and cache entries carry their data
+    // without a separate allocation.
+    static constexpr int InlineSize = 64;
+    uint8_t m_inline[InlineSize];
+
     // Tracks block changes when atomic ops are applied
     std::deque<uint8_t*> m_atomicLog;
 };
@@ -126,10 +132,15 @@ inline void
 DataBlock::assign(uint8_t *data)
 {
     assert(data != NULL);
-    if (m_alloc) {
-        delete [] m_data;
-    }
+    freeData();
     m_data = data;
+}
+
+inline void
+DataBlock::freeData()
+{
+    if (m_alloc && m_data != m_inline)
+        delete [] m_data;
     m_alloc = false;
 }
 
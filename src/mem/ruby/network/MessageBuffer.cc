@@ -40,6 +40,7 @@
 
 #include "mem/ruby/network/MessageBuffer.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "base/cprintf.hh"
@@ -47,6 +48,7 @@
 #include "base/random.hh"
 #include "base/stl_helpers.hh"
 #include "debug/RubyQueue.hh"
+#include "sim/global_event.hh"
 
 namespace gem5
 {
@@ -56,6 +58,10 @@ namespace ruby
 
 using stl_helpers::operator<<;
 
+uint64_t MessageBuffer::numBuffers = 0;
+std::mutex MessageBuffer::pendingRemoteMutex;
+std::vector<MessageBuffer *> MessageBuffer::pendingRemoteBuffers;
+
 MessageBuffer::MessageBuffer(const Params &p)
     : SimObject(p), m_stall_map_size(0), m_max_size(p.buffer_size),
     m_max_dequeue_rate(p.max_dequeue_rate), m_dequeues_this_cy(0),
@@ -66,6 +72,7 @@ MessageBuffer::MessageBuffer(const Params &p)
     m_randomization(p.randomization),
     m_allow_zero_latency(p.allow_zero_latency),
     m_routing_priority(p.routing_priority),
+    m_buffer_id(numBuffers++),
     ADD_STAT(m_not_avail_count, statistics::units::Count::get(),
              "Number of times this buffer did not have N slots available"),
     ADD_STAT(m_msg_count, statistics::units::Count::get(),
@@ -130,6 +137,13 @@ MessageBuffer::MessageBuffer(const Params &p)
     }
 
     m_avg_stall_time = m_stall_time / m_msg_count;
+
+    // Messages sent across event queues are handed over to their
+    // consumers at every quantum boundary
+    if (m_buffer_id == 0) {
+        GlobalSyncEvent::quantumCallbacks().push_back(
+            &MessageBuffer::deliverAllRemoteMessages);
+    }
 }
 
 unsigned int
@@ -137,7 +151,7 @@ MessageBuffer::getSize(Tick curTime)
 {
     if (m_time_last_time_size_checked != curTime) {
         m_time_last_time_size_checked = curTime;
-        m_size_last_time_size_checked = m_prio_heap.size();
+        m_size_last_time_size_checked = m_msg_wheel.size();
     }
 
     return m_size_last_time_size_checked;
@@ -160,8 +174,8 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
     unsigned int current_stall_size = 0;
 
     if (m_time_last_time_pop < current_time) {
-        // no pops this cycle - heap and stall queue size is correct
-        current_size = m_prio_heap.size();
+        // no pops this cycle - wheel and stall queue size is correct
+        current_size = m_msg_wheel.size();
         current_stall_size = m_stall_map_size;
     } else {
         if (m_time_last_time_enqueue < current_time) {
@@ -181,10 +195,10 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
     if (current_size + current_stall_size + n <= m_max_size) {
         return true;
     } else {
-        DPRINTF(RubyQueue, "n: %d, current_size: %d, heap size: %d, "
+        DPRINTF(RubyQueue, "n: %d, current_size: %d, wheel size: %d, "
                 "m_max_size: %d\n",
                 n, current_size + current_stall_size,
-                m_prio_heap.size(), m_max_size);
+                m_msg_wheel.size(), m_max_size);
         m_not_avail_count++;
         return false;
     }
@@ -194,7 +208,7 @@ const Message*
 MessageBuffer::peek() const
 {
     DPRINTF(RubyQueue, "Peeking at head of queue.\n");
-    const Message* msg_ptr = m_prio_heap.front().get();
+    const Message* msg_ptr = m_msg_wheel.front().get();
     assert(msg_ptr);
 
     DPRINTF(RubyQueue, "Message: %s\n", (*msg_ptr));
@@ -219,6 +233,13 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
                        bool ruby_is_random, bool ruby_warmup,
                        bool bypassStrictFIFO)
 {
+    assert(m_consumer != NULL);
+    if (isRemoteEnqueue()) {
+        enqueueRemote(message, current_time, delta, ruby_is_random,
+                      bypassStrictFIFO);
+        return;
+    }
+
     // record current time incase we have a pop that also adjusts my size
     if (m_time_last_time_enqueue < current_time) {
         m_msgs_this_cycle = 0;  // first msg this cycle
@@ -283,24 +304,139 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
     msg_ptr->setLastEnqueueTime(arrival_time);
     msg_ptr->setMsgCounter(m_msg_counter);
 
-    // Insert the message into the priority heap
-    m_prio_heap.push_back(message);
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    // Insert the message into the timing wheel
+    m_msg_wheel.push(message);
     // Increment the number of messages statistic
     m_buf_msgs++;
 
     assert((m_max_size == 0) ||
-           ((m_prio_heap.size() + m_stall_map_size) <= m_max_size));
+           ((m_msg_wheel.size() + m_stall_map_size) <= m_max_size));
 
     DPRINTF(RubyQueue, "Enqueue arrival_time: %lld, Message: %s\n",
             arrival_time, *(message.get()));
 
     // Schedule the wakeup
-    assert(m_consumer != NULL);
     m_consumer->scheduleEventAbsolute(arrival_time);
     m_consumer->storeEventInfo(m_vnet_id);
 }
 
+bool
+MessageBuffer::isRemoteEnqueue() const
+{
+    return inParallelMode &&
+        curEventQueue() != m_consumer->getObject()->eventQueue();
+}
+
+void
+MessageBuffer::enqueueRemote(MsgPtr message, Tick current_time, Tick delta,
+                             bool ruby_is_random, bool bypassStrictFIFO)
+{
+    // The consumer may already be up to one quantum ahead of us, so the
+    // message must not arrive before the end of the current quantum.
+    // Size checks and random delays would read state owned by the
+    // consumer's thread, so they are not supported either.
+    fatal_if(delta < simQuantum,
+             "%s: latency %d between event queues is lower than the "
+             "simulation quantum %d\n", name(), delta, simQuantum);
+    fatal_if(m_max_size > 0,
+             "%s: finite-sized message buffers cannot connect objects on "
+             "different event queues\n", name());
+    fatal_if((m_randomization == MessageRandomization::enabled) ||
+             ((m_randomization == MessageRandomization::ruby_system) &&
+              ruby_is_random),
+             "%s: message randomization is not supported between event "
+             "queues\n", name());
+
+    Message* msg_ptr = message.get();
+    assert(msg_ptr != NULL);
+    assert(current_time >= msg_ptr->getLastEnqueueTime() &&
+           "ensure we aren't dequeued early");
+    msg_ptr->updateDelayedTicks(current_time);
+
+    auto it = std::find(mainEventQueue.begin(), mainEventQueue.end(),
+                        curEventQueue());
+    assert(it != mainEventQueue.end());
+    uint32_t src_eventq = it - mainEventQueue.begin();
+
+    DPRINTF(RubyQueue, "Remote enqueue from eventq %d arrival_time: %lld, "
+            "Message: %s\n", src_eventq, current_time + delta, *msg_ptr);
+
+    std::lock_guard<std::mutex> lock(m_remote_mutex);
+    if (m_remote_msgs.empty()) {
+        std::lock_guard<std::mutex> pending_lock(pendingRemoteMutex);
+        pendingRemoteBuffers.push_back(this);
+    }
+    m_remote_msgs.push_back({current_time + delta, src_eventq,
+                             bypassStrictFIFO, message});
+}
+
+void
+MessageBuffer::deliverRemoteMessages()
+{
+    // Messages from the same event queue are already in the order they
+    // were enqueued in, so a stable sort on (arrival, source queue)
+    // gives an order that does not depend on host thread scheduling.
+    std::stable_sort(m_remote_msgs.begin(), m_remote_msgs.end(),
+        [](const RemoteMessage &a, const RemoteMessage &b)
+        {
+            if (a.arrival_time != b.arrival_time)
+                return a.arrival_time < b.arrival_time;
+            return a.src_eventq < b.src_eventq;
+        });
+
+    // All other threads are stopped, so we can temporarily act on
+    // behalf of the consumer's event queue to schedule its wakeups.
+    EventQueue *old_eventq = curEventQueue();
+    curEventQueue(m_consumer->getObject()->eventQueue());
+
+    for (auto &remote : m_remote_msgs) {
+        Tick arrival_time = remote.arrival_time;
+        if (m_strict_fifo &&
+            !(remote.bypass_strict_fifo ||
+              m_last_message_strict_fifo_bypassed)) {
+            panic_if(arrival_time < m_last_arrival_time,
+                     "FIFO ordering violated: %s name: %s arrival_time: %d "
+                     "last arrival_time: %d\n", *this, name(), arrival_time,
+                     m_last_arrival_time);
+        }
+        m_last_arrival_time = arrival_time;
+        m_last_message_strict_fifo_bypassed = remote.bypass_strict_fifo;
+
+        m_msg_counter++;
+        remote.msg->setLastEnqueueTime(arrival_time);
+        remote.msg->setMsgCounter(m_msg_counter);
+
+        m_msg_wheel.push(remote.msg);
+        m_buf_msgs++;
+
+        DPRINTF(RubyQueue, "Deliver arrival_time: %lld, Message: %s\n",
+                arrival_time, *(remote.msg.get()));
+
+        m_consumer->scheduleEventAbsolute(arrival_time);
+        m_consumer->storeEventInfo(m_vnet_id);
+    }
+    m_remote_msgs.clear();
+
+    curEventQueue(old_eventq);
+}
+
+void
+MessageBuffer::deliverAllRemoteMessages()
+{
+    std::lock_guard<std::mutex> lock(pendingRemoteMutex);
+    std::sort(pendingRemoteBuffers.begin(), pendingRemoteBuffers.end(),
+        [](const MessageBuffer *a, const MessageBuffer *b)
+        {
+            return a->m_buffer_id < b->m_buffer_id;
+        });
+
+    for (auto *buffer : pendingRemoteBuffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->m_remote_mutex);
+        buffer->deliverRemoteMessages();
+    }
+    pendingRemoteBuffers.clear();
+}
+
 Tick
 MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
 {
@@ -308,7 +444,7 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     assert(isReady(current_time));
 
     // get MsgPtr of the message about to be dequeued
-    MsgPtr message = m_prio_heap.front();
+    MsgPtr message = m_msg_wheel.front();
 
     // get the delay cycles
     message->updateDelayedTicks(current_time);
@@ -317,15 +453,14 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     // record previous size and time so the current buffer size isn't
     // adjusted until schd cycle
     if (m_time_last_time_pop < current_time) {
-        m_size_at_cycle_start = m_prio_heap.size();
+        m_size_at_cycle_start = m_msg_wheel.size();
         m_stalled_at_cycle_start = m_stall_map_size;
         m_time_last_time_pop = current_time;
         m_dequeues_this_cy = 0;
     }
     ++m_dequeues_this_cy;
 
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
-    m_prio_heap.pop_back();
+    m_msg_wheel.pop();
     if (decrement_messages) {
         // Record how much time is passed since the message was enqueued
         m_stall_time += curTick() - message->getLastEnqueueTime();
@@ -359,7 +494,7 @@ MessageBuffer::unregisterDequeueCallback()
 void
 MessageBuffer::clear()
 {
-    m_prio_heap.clear();
+    m_msg_wheel.clear();
 
     m_msg_counter = 0;
     m_time_last_time_enqueue = 0;
@@ -374,14 +509,13 @@ MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
 {
     DPRINTF(RubyQueue, "Recycling.\n");
     assert(isReady(current_time));
-    MsgPtr node = m_prio_heap.front();
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    MsgPtr node = m_msg_wheel.front();
+    m_msg_wheel.pop();
 
     Tick future_time = current_time + recycle_latency;
     node->setLastEnqueueTime(future_time);
 
-    m_prio_heap.back() = node;
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    m_msg_wheel.push(node);
     m_consumer->scheduleEventAbsolute(future_time);
 }
 
@@ -392,9 +526,7 @@ MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
         MsgPtr m = lt.front();
         assert(m->getLastEnqueueTime() <= schdTick);
 
-        m_prio_heap.push_back(m);
-        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                  std::greater<MsgPtr>());
+        m_msg_wheel.push(m);
 
         m_consumer->scheduleEventAbsolute(schdTick);
 
@@ -413,7 +545,7 @@ MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
 
     //
     // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // timing wheel.  The reanalyzeList call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle
     //
@@ -430,7 +562,7 @@ MessageBuffer::reanalyzeAllMessages(Tick current_time)
 
     //
     // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // timing wheel.  The reanalyzeList call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle.
     //
@@ -448,7 +580,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
 {
     DPRINTF(RubyQueue, "Stalling due to %#x\n", addr);
     assert(isReady(current_time));
-    MsgPtr message = m_prio_heap.front();
+    MsgPtr message = m_msg_wheel.front();
 
     // Since the message will just be moved to stall map, indicate that the
     // buffer should not decrement the m_buf_msgs statistic
@@ -509,9 +641,10 @@ MessageBuffer::print(std::ostream& out) const
         ccprintf(out, " consumer-yes ");
     }
 
-    std::vector<MsgPtr> copy(m_prio_heap);
-    std::sort_heap(copy.begin(), copy.end(), std::greater<MsgPtr>());
-    ccprintf(out, "%s] %s", copy, name());
+    // Print the messages latest first, as always
+    std::vector<MsgPtr> msgs = m_msg_wheel.sorted();
+    std::reverse(msgs.begin(), msgs.end());
+    ccprintf(out, "%s] %s", msgs, name());
 }
 
 bool
@@ -521,8 +654,8 @@ MessageBuffer::isReady(Tick current_time) const
     bool can_dequeue = (m_max_dequeue_rate == 0) ||
                        (m_time_last_time_pop < current_time) ||
                        (m_dequeues_this_cy < m_max_dequeue_rate);
-    bool is_ready = (m_prio_heap.size() > 0) &&
-                   (m_prio_heap.front()->getLastEnqueueTime() <= current_time);
+    bool is_ready = !m_msg_wheel.empty() &&
+                   (m_msg_wheel.front()->getLastEnqueueTime() <= current_time);
     if (!can_dequeue && is_ready) {
         // Make sure the Consumer executes next cycle to dequeue the ready msg
         m_consumer->scheduleEvent(Cycles(1));
@@ -533,10 +666,10 @@ MessageBuffer::isReady(Tick current_time) const
 Tick
 MessageBuffer::readyTime() const
 {
-    if (m_prio_heap.empty())
+    if (m_msg_wheel.empty())
         return MaxTick;
     else
-        return m_prio_heap.front()->getLastEnqueueTime();
+        return m_msg_wheel.front()->getLastEnqueueTime();
 }
 
 uint32_t
@@ -547,17 +680,20 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
 
     uint32_t num_functional_accesses = 0;
 
-    // Check the priority heap and write any messages that may
+    // Check the timing wheel and write any messages that may
     // correspond to the address in the packet.
-    for (unsigned int i = 0; i < m_prio_heap.size(); ++i) {
-        Message *msg = m_prio_heap[i].get();
+    bool found = m_msg_wheel.anyOf([&](const MsgPtr &msg_ptr) {
+        Message *msg = msg_ptr.get();
         if (is_read && !mask && msg->functionalRead(pkt))
-            return 1;
+            return true;
         else if (is_read && mask && msg->functionalRead(pkt, *mask))
             num_functional_accesses++;
         else if (!is_read && msg->functionalWrite(pkt))
             num_functional_accesses++;
-    }
+        return false;
+    });
+    if (found)
+        return 1;
 
     // Check the stall queue and write any messages that may
     // correspond to the address in the packet.
@@ -578,6 +714,18 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
         }
     }
 
+    // Check the messages that are still in flight from other event queues
+    std::lock_guard<std::mutex> lock(m_remote_mutex);
+    for (auto &remote : m_remote_msgs) {
+        Message *msg = remote.msg.get();
+        if (is_read && !mask && msg->functionalRead(pkt))
+            return 1;
+        else if (is_read && mask && msg->functionalRead(pkt, *mask))
+            num_functional_accesses++;
+        else if (!is_read && msg->functionalWrite(pkt))
+            num_functional_accesses++;
+    }
+
     return num_functional_accesses;
 }
 
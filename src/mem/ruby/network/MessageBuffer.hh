@@ -50,6 +50,7 @@
 #include <cassert>
 #include <functional>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -60,6 +61,7 @@
 #include "mem/port.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/network/MessageTimingWheel.hh"
 #include "mem/ruby/network/dummy_port.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 #include "params/MessageBuffer.hh"
@@ -93,10 +95,8 @@ class MessageBuffer : public SimObject
     delayHead(Tick current_time, Tick delta, bool ruby_is_random,
               bool ruby_warmup)
     {
-        MsgPtr m = m_prio_heap.front();
-        std::pop_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                      std::greater<MsgPtr>());
-        m_prio_heap.pop_back();
+        MsgPtr m = m_msg_wheel.front();
+        m_msg_wheel.pop();
         enqueue(m, current_time, delta, ruby_is_random, ruby_warmup);
     }
 
@@ -112,6 +112,8 @@ class MessageBuffer : public SimObject
                   *consumer, *this, *m_consumer);
         }
         m_consumer = consumer;
+        if (m_msg_wheel.empty())
+            m_msg_wheel.setSlotTicks(consumer->getObject()->clockPeriod());
     }
 
     Consumer* getConsumer() { return m_consumer; }
@@ -122,7 +124,7 @@ class MessageBuffer : public SimObject
     //! message queue.  The function assumes that the queue is nonempty.
     const Message* peek() const;
 
-    const MsgPtr &peekMsgPtr() const { return m_prio_heap.front(); }
+    const MsgPtr &peekMsgPtr() const { return m_msg_wheel.front(); }
 
     void enqueue(MsgPtr message, Tick curTime, Tick delta,
                 bool ruby_is_random, bool ruby_warmup,
@@ -149,7 +151,7 @@ class MessageBuffer : public SimObject
     void unregisterDequeueCallback();
 
     void recycle(Tick current_time, Tick recycle_latency);
-    bool isEmpty() const { return m_prio_heap.size() == 0; }
+    bool isEmpty() const { return m_msg_wheel.empty(); }
     bool isStallMapEmpty() { return m_stall_msg_map.size() == 0; }
     unsigned int getStallMapSize() { return m_stall_msg_map.size(); }
 
@@ -201,11 +203,35 @@ class MessageBuffer : public SimObject
 
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
+    /**
+     * True if the calling thread runs a different event queue than the
+     * consumer of this buffer, i.e., the message has to be handed over
+     * to the consumer's thread at the next quantum boundary.
+     */
+    bool isRemoteEnqueue() const;
+
+    void enqueueRemote(MsgPtr message, Tick current_time, Tick delta,
+                       bool ruby_is_random, bool bypassStrictFIFO);
+
+    /**
+     * Move the messages received from other event queues into the
+     * timing wheel and wake up the consumer. Must only be called while
+     * all other simulation threads are stopped.
+     */
+    void deliverRemoteMessages();
+
+    /**
+     * Deliver the pending cross-queue messages of all buffers. This is
+     * registered as a quantum callback of the GlobalSyncEvent.
+     */
+    static void deliverAllRemoteMessages();
+
   private:
     // Data Members (m_ prefix)
     //! Consumer to signal a wakeup(), can be NULL
     Consumer* m_consumer;
-    std::vector<MsgPtr> m_prio_heap;
+    //! Messages in arrival order, bucketed by the consumer's cycle
+    MessageTimingWheel m_msg_wheel;
 
     std::function<void()> m_dequeue_callback;
 
@@ -216,14 +242,14 @@ class MessageBuffer : public SimObject
     /**
      * A map from line addresses to lists of stalled messages for that line.
      * If this buffer allows the receiver to stall messages, on a stall
-     * request, the stalled message is removed from the m_prio_heap and placed
+     * request, the stalled message is removed from the m_msg_wheel and placed
      * in the m_stall_msg_map. Messages are held there until the receiver
      * requests they be reanalyzed, at which point they are moved back to
-     * m_prio_heap.
+     * m_msg_wheel.
      *
      * NOTE: The stall map holds messages in the order in which they were
      * initially received, and when a line is unblocked, the messages are
-     * moved back to the m_prio_heap in the same order. This prevents starving
+     * moved back to the m_msg_wheel in the same order. This prevents starving
      * older requests with younger ones.
      */
     StallMsgMapType m_stall_msg_map;
@@ -240,7 +266,7 @@ class MessageBuffer : public SimObject
      * Current size of the stall map.
      * Track the number of messages held in stall map lists. This is used to
      * ensure that if the buffer is finite-sized, it blocks further requests
-     * when the m_prio_heap and m_stall_msg_map contain m_max_size messages.
+     * when the m_msg_wheel and m_stall_msg_map contain m_max_size messages.
      */
     int m_stall_map_size;
 
@@ -287,6 +313,29 @@ class MessageBuffer : public SimObject
     int m_input_link_id;
     int m_vnet_id;
 
+    /** A message enqueued from a different event queue. */
+    struct RemoteMessage
+    {
+        Tick arrival_time;
+        uint32_t src_eventq;
+        bool bypass_strict_fifo;
+        MsgPtr msg;
+    };
+
+    //! Unique, construction-ordered id used to deliver cross-queue
+    //! messages of different buffers in a deterministic order
+    const uint64_t m_buffer_id;
+
+    //! Mutex protecting m_remote_msgs
+    std::mutex m_remote_mutex;
+    //! Messages waiting for the next quantum boundary
+    std::vector<RemoteMessage> m_remote_msgs;
+
+    static uint64_t numBuffers;
+    static std::mutex pendingRemoteMutex;
+    //! Buffers with a non-empty m_remote_msgs
+    static std::vector<MessageBuffer *> pendingRemoteBuffers;
+
     // Count the # of times I didn't have N slots available
     statistics::Scalar m_not_avail_count;
     statistics::Scalar m_msg_count;
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/network/MessageTimingWheel.hh"
+
+#include <algorithm>
+#include <functional>
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+void
+MessageTimingWheel::push(const MsgPtr &msg)
+{
+    const uint64_t cycle = cycleOf(msg);
+
+    if (empty()) {
+        assert(m_overflow.empty());
+        m_base = cycle;
+    }
+
+    if (cycle >= m_base + NumSlots) {
+        m_overflow.push_back(msg);
+        std::push_heap(m_overflow.begin(), m_overflow.end(),
+                       std::greater<MsgPtr>());
+    } else {
+        // Messages from before the current slot are all older than the
+        // messages of the later slots, so they can share the current
+        // slot, which is kept sorted.
+        insertInSlot(std::max(cycle, m_base), msg);
+    }
+    m_size++;
+}
+
+void
+MessageTimingWheel::pop()
+{
+    const unsigned slot = frontSlot();
+    Slot &front_slot = m_slots[slot];
+    front_slot.msgs[front_slot.head++] = nullptr;
+    if (front_slot.empty()) {
+        front_slot.msgs.clear();
+        front_slot.head = 0;
+        m_occupied &= ~(1ULL << slot);
+    }
+    m_size--;
+
+    // Turn the wheel up to the slot we popped from, since all slots
+    // before it are empty.
+    m_base += (slot + NumSlots - m_base % NumSlots) % NumSlots;
+
+    if (!m_occupied && !m_overflow.empty())
+        m_base = cycleOf(m_overflow.front());
+    refill();
+}
+
+void
+MessageTimingWheel::clear()
+{
+    for (auto &slot : m_slots) {
+        slot.msgs.clear();
+        slot.head = 0;
+    }
+    m_overflow.clear();
+    m_occupied = 0;
+    m_size = 0;
+}
+
+std::vector<MsgPtr>
+MessageTimingWheel::sorted() const
+{
+    std::vector<MsgPtr> msgs;
+    msgs.reserve(m_size);
+    anyOf([&msgs](const MsgPtr &msg) {
+        msgs.push_back(msg);
+        return false;
+    });
+    return msgs;
+}
+
+void
+MessageTimingWheel::insertInSlot(uint64_t cycle, const MsgPtr &msg)
+{
+    const unsigned slot = cycle % NumSlots;
+    auto &msgs = m_slots[slot].msgs;
+    const auto head = msgs.begin() + m_slots[slot].head;
+
+    // Messages usually arrive in order, so look for the insertion
+    // point from the back.
+    auto it = msgs.end();
+    while (it != head && *(it - 1) > msg)
+        --it;
+    msgs.insert(it, msg);
+
+    m_occupied |= 1ULL << slot;
+}
+
+void
+MessageTimingWheel::refill()
+{
+    while (!m_overflow.empty() &&
+           cycleOf(m_overflow.front()) < m_base + NumSlots) {
+        insertInSlot(cycleOf(m_overflow.front()), m_overflow.front());
+        std::pop_heap(m_overflow.begin(), m_overflow.end(),
+                      std::greater<MsgPtr>());
+        m_overflow.pop_back();
+    }
+}
+
+std::vector<MsgPtr>
+MessageTimingWheel::sortedOverflow() const
+{
+    std::vector<MsgPtr> msgs(m_overflow);
+    std::sort_heap(msgs.begin(), msgs.end(), std::greater<MsgPtr>());
+    // sort_heap with greater sorts in descending order
+    std::reverse(msgs.begin(), msgs.end());
+    return msgs;
+}
+
+} // namespace ruby
+} // namespace gem5
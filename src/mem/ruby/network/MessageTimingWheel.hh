@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_MESSAGETIMINGWHEEL_HH__
+#define __MEM_RUBY_NETWORK_MESSAGETIMINGWHEEL_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/types.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * The messages of a MessageBuffer, ordered by arrival time and then by
+ * message counter, i.e., in exactly the order of the binary heap it
+ * replaces.
+ *
+ * Messages arriving within the next NumSlots slots of slotTicks each
+ * are kept in the slot of their arrival time, and a bitmap of the
+ * occupied slots finds the head in constant time. Messages arriving
+ * later are kept in an overflow heap, and move to their slot as the
+ * wheel turns. Messages put back with an arrival time before the
+ * current slot, e.g. stalled messages that are reanalyzed, go to the
+ * current slot, which is kept sorted.
+ *
+ * The slots only allocate memory once they are used, so that the many
+ * message buffers that are rarely used stay small.
+ */
+class MessageTimingWheel
+{
+  public:
+    static constexpr unsigned NumSlots = 64;
+
+    MessageTimingWheel() = default;
+
+    /**
+     * Set the width of a slot, usually the clock period of the
+     * consumer. This only affects performance, not the order of the
+     * messages.
+     */
+    void
+    setSlotTicks(Tick slot_ticks)
+    {
+        assert(empty());
+        m_slot_ticks = slot_ticks ? slot_ticks : 1;
+    }
+
+    bool empty() const { return m_size == 0; }
+    size_t size() const { return m_size; }
+
+    //! The first message. The wheel must not be empty.
+    const MsgPtr &
+    front() const
+    {
+        assert(!empty());
+        return m_slots[frontSlot()].front();
+    }
+
+    void push(const MsgPtr &msg);
+
+    //! Remove the first message. The wheel must not be empty.
+    void pop();
+
+    void clear();
+
+    /**
+     * Call f on each message in order, until it returns true.
+     *
+     * @return true if f returned true.
+     */
+    template <typename F>
+    bool
+    anyOf(F &&f) const
+    {
+        for (unsigned i = 0; i < NumSlots; i++) {
+            const Slot &slot = m_slots[(m_base + i) % NumSlots];
+            for (size_t j = slot.head; j < slot.msgs.size(); j++) {
+                if (f(slot.msgs[j]))
+                    return true;
+            }
+        }
+        for (const auto &msg : sortedOverflow()) {
+            if (f(msg))
+                return true;
+        }
+        return false;
+    }
+
+    //! All the messages, in order
+    std::vector<MsgPtr> sorted() const;
+
+  private:
+    /**
+     * The messages of a slot, in order. Popped messages are only
+     * erased once the slot is empty, keeping its storage for later.
+     */
+    struct Slot
+    {
+        std::vector<MsgPtr> msgs;
+        //! Index of the first message
+        size_t head = 0;
+
+        bool empty() const { return head == msgs.size(); }
+        const MsgPtr &front() const { return msgs[head]; }
+    };
+
+    uint64_t
+    cycleOf(const MsgPtr &msg) const
+    {
+        return msg->getLastEnqueueTime() / m_slot_ticks;
+    }
+
+    //! The first occupied slot, starting from the current one
+    unsigned
+    frontSlot() const
+    {
+        assert(m_occupied);
+        const unsigned base_slot = m_base % NumSlots;
+        uint64_t rotated = base_slot ?
+            (m_occupied >> base_slot) |
+                (m_occupied << (NumSlots - base_slot)) :
+            m_occupied;
+        return (base_slot + findLsbSet(rotated)) % NumSlots;
+    }
+
+    //! Insert a message in the slot of a cycle within the wheel
+    void insertInSlot(uint64_t cycle, const MsgPtr &msg);
+
+    //! Move the overflow messages that now fit in the wheel
+    void refill();
+
+    std::vector<MsgPtr> sortedOverflow() const;
+
+    Tick m_slot_ticks = 1;
+
+    //! The cycle of the current slot. Slot i holds cycle m_base + j,
+    //! where j is the distance from the current slot to i.
+    uint64_t m_base = 0;
+
+    //! Bit i is set if slot i holds messages
+    uint64_t m_occupied = 0;
+
+    Slot m_slots[NumSlots];
+
+    //! Messages beyond the wheel, a heap ordered like the wheel
+    std::vector<MsgPtr> m_overflow;
+
+    size_t m_size = 0;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_MESSAGETIMINGWHEEL_HH__
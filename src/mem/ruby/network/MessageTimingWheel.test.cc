@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <ostream>
+#include <random>
+#include <vector>
+
+#include "mem/ruby/network/MessageTimingWheel.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+class TestMessage : public Message
+{
+  public:
+    TestMessage(Tick time, uint64_t counter)
+        : Message(time, 64, nullptr)
+    {
+        setMsgCounter(counter);
+    }
+
+    MsgPtr clone() const override { return new TestMessage(*this); }
+    void print(std::ostream &out) const override { out << "TestMessage"; }
+};
+
+/** The binary heap message buffers used before the timing wheel. */
+class MessageHeap
+{
+  public:
+    void
+    push(const MsgPtr &msg)
+    {
+        heap.push_back(msg);
+        std::push_heap(heap.begin(), heap.end(), std::greater<MsgPtr>());
+    }
+
+    MsgPtr
+    pop()
+    {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<MsgPtr>());
+        MsgPtr msg = heap.back();
+        heap.pop_back();
+        return msg;
+    }
+
+    std::vector<MsgPtr>
+    sorted() const
+    {
+        std::vector<MsgPtr> msgs(heap);
+        std::sort(msgs.begin(), msgs.end(),
+                  [](const MsgPtr &a, const MsgPtr &b) { return b > a; });
+        return msgs;
+    }
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+
+  private:
+    std::vector<MsgPtr> heap;
+};
+
+/**
+ * Push and pop random messages to a timing wheel and a heap, and check
+ * that the messages come out of both in the same order.
+ *
+ * @param seed Seed of the random operations
+ * @param slot_ticks Width of a wheel slot
+ * @param max_delay Largest arrival time after the current time
+ * @param max_early Largest arrival time before the current time
+ */
+void
+compareWithHeap(unsigned seed, Tick slot_ticks, Tick max_delay,
+                Tick max_early)
+{
+    std::mt19937_64 rng(seed);
+    MessageTimingWheel wheel;
+    MessageHeap heap;
+    wheel.setSlotTicks(slot_ticks);
+
+    Tick now = 1000000;
+    uint64_t counter = 0;
+    for (int op = 0; op < 20000; op++) {
+        if (heap.empty() || rng() % 3 != 0) {
+            // Messages mostly arrive in the future, but stalled
+            // messages may be put back with an earlier arrival time.
+            Tick time = now + rng() % (max_delay + 1);
+            if (rng() % 8 == 0)
+                time = now - rng() % (max_early + 1);
+            MsgPtr msg = new TestMessage(time, counter++);
+            wheel.push(msg);
+            heap.push(msg);
+        } else {
+            ASSERT_FALSE(wheel.empty());
+            MsgPtr expected = heap.pop();
+            ASSERT_EQ(wheel.front().get(), expected.get());
+            wheel.pop();
+            now = std::max(now, expected->getLastEnqueueTime());
+        }
+        ASSERT_EQ(wheel.size(), heap.size());
+
+        if (op % 1000 == 0)
+            ASSERT_EQ(wheel.sorted(), heap.sorted());
+    }
+
+    ASSERT_EQ(wheel.sorted(), heap.sorted());
+    while (!heap.empty()) {
+        MsgPtr expected = heap.pop();
+        ASSERT_EQ(wheel.front().get(), expected.get());
+        wheel.pop();
+    }
+    ASSERT_TRUE(wheel.empty());
+}
+
+} // anonymous namespace
+
+/** Messages that all fit in the wheel. */
+TEST(MessageTimingWheelTest, WithinWheel)
+{
+    for (unsigned seed = 0; seed < 10; seed++)
+        compareWithHeap(seed, 500, 30 * 500, 10 * 500);
+}
+
+/** Messages that often go beyond the wheel into the overflow heap. */
+TEST(MessageTimingWheelTest, Overflow)
+{
+    for (unsigned seed = 0; seed < 10; seed++)
+        compareWithHeap(seed, 500, 300 * 500, 100 * 500);
+}
+
+/** Many messages with the same arrival time, ordered by counter. */
+TEST(MessageTimingWheelTest, SameTicks)
+{
+    for (unsigned seed = 0; seed < 10; seed++)
+        compareWithHeap(seed, 1000, 3, 3);
+}
+
+/** Slots of a single tick, and arrival times not aligned to slots. */
+TEST(MessageTimingWheelTest, SingleTickSlots)
+{
+    for (unsigned seed = 0; seed < 10; seed++)
+        compareWithHeap(seed, 1, 100, 20);
+}
+
+/** The wheel can be cleared and reused. */
+TEST(MessageTimingWheelTest, Clear)
+{
+    MessageTimingWheel wheel;
+    wheel.setSlotTicks(10);
+    for (uint64_t i = 0; i < 100; i++)
+        wheel.push(new TestMessage(i * 7, i));
+    wheel.clear();
+    ASSERT_TRUE(wheel.empty());
+
+    MsgPtr msg = new TestMessage(5, 0);
+    wheel.push(msg);
+    ASSERT_EQ(wheel.front().get(), msg.get());
+    wheel.pop();
+    ASSERT_TRUE(wheel.empty());
+}
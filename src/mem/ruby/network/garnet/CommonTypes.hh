@@ -31,6 +31,11 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_COMMONTYPES_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_COMMONTYPES_HH__
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
 #include "mem/ruby/common/NetDest.hh"
 
 namespace gem5
@@ -72,6 +77,53 @@ struct RouteInfo
     int hops_traversed;
 };
 
+/**
+ * A set of router ports, iterated in port order. Routers use it to only
+ * evaluate the ports that have flits or credits in flight.
+ */
+class PortSet
+{
+  public:
+    void resize(int num_ports) { m_words.resize((num_ports + 63) / 64, 0); }
+
+    void insert(int port) { m_words[port / 64] |= 1ULL << (port % 64); }
+    void erase(int port) { m_words[port / 64] &= ~(1ULL << (port % 64)); }
+    void clear() { std::fill(m_words.begin(), m_words.end(), 0); }
+
+    bool
+    contains(int port) const
+    {
+        return m_words[port / 64] & (1ULL << (port % 64));
+    }
+
+    bool
+    empty() const
+    {
+        for (auto word : m_words) {
+            if (word)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * Call f on each port in the set, in port order. f may erase the
+     * port it is called on.
+     */
+    template <typename F>
+    void
+    forEach(F &&f) const
+    {
+        for (int i = 0; i < m_words.size(); i++) {
+            for (uint64_t word = m_words[i]; word; word &= word - 1)
+                f(i * 64 + findLsbSet(word));
+        }
+    }
+
+  private:
+    std::vector<uint64_t> m_words;
+};
+
 #define INFINITE_ 10000
 
 } // namespace garnet
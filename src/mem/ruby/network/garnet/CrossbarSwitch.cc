@@ -54,12 +54,14 @@ void
 CrossbarSwitch::init()
 {
     switchBuffers.resize(m_router->get_num_inports());
+    m_busy_inports.resize(m_router->get_num_inports());
 }
 
 /*
- * The wakeup function of the CrossbarSwitch loops through all input ports,
- * and sends the winning flit (from SA) out of its output port on to the
- * output link. The output link is scheduled for wakeup in the next cycle.
+ * The wakeup function of the CrossbarSwitch loops through the input ports
+ * holding flits, and sends the winning flit (from SA) out of its output port
+ * on to the output link. The output link is scheduled for wakeup in the next
+ * cycle.
  */
 
 void
@@ -69,9 +71,10 @@ CrossbarSwitch::wakeup()
             "at time: %lld\n",
             m_router->get_id(), m_router->curCycle());
 
-    for (auto& switch_buffer : switchBuffers) {
+    m_busy_inports.forEach([this](int inport) {
+        flitBuffer &switch_buffer = switchBuffers[inport];
         if (!switch_buffer.isReady(curTick())) {
-            continue;
+            return;
         }
 
         flit *t_flit = switch_buffer.peekTopFlit();
@@ -86,9 +89,11 @@ CrossbarSwitch::wakeup()
             // in the next cycle
             m_router->getOutputUnit(outport)->insert_flit(t_flit);
             switch_buffer.getTopFlit();
+            if (switch_buffer.isEmpty())
+                m_busy_inports.erase(inport);
             m_crossbar_activity++;
         }
-    }
+    });
 }
 
 bool
@@ -63,8 +63,11 @@ class CrossbarSwitch : public Consumer
     update_sw_winner(int inport, flit *t_flit)
     {
         switchBuffers[inport].insert(t_flit);
+        m_busy_inports.insert(inport);
     }
 
+    inline bool has_flits() const { return !m_busy_inports.empty(); }
+
     inline double get_crossbar_activity() { return m_crossbar_activity; }
 
     bool functionalRead(Packet *pkt, WriteMask &mask);
@@ -76,6 +79,8 @@ class CrossbarSwitch : public Consumer
     int m_num_vcs;
     double m_crossbar_activity;
     std::vector<flitBuffer> switchBuffers;
+    //! Inports with flits in their switch buffer
+    PortSet m_busy_inports;
 };
 
 } // namespace garnet
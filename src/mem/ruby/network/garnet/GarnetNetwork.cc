@@ -31,10 +31,12 @@
 
 #include "mem/ruby/network/garnet/GarnetNetwork.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "base/cast.hh"
 #include "base/compiler.hh"
+#include "base/intmath.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/network/MessageBuffer.hh"
@@ -45,6 +47,7 @@
 #include "mem/ruby/network/garnet/NetworkLink.hh"
 #include "mem/ruby/network/garnet/Router.hh"
 #include "mem/ruby/system/RubySystem.hh"
+#include "sim/global_event.hh"
 
 namespace gem5
 {
@@ -70,7 +73,6 @@ GarnetNetwork::GarnetNetwork(const Params &p)
     m_buffers_per_data_vc = p.buffers_per_data_vc;
     m_buffers_per_ctrl_vc = p.buffers_per_ctrl_vc;
     m_routing_algorithm = p.routing_algorithm;
-    m_next_packet_id = 0;
 
     m_enable_fault_model = p.enable_fault_model;
     if (m_enable_fault_model)
@@ -134,6 +136,47 @@ GarnetNetwork::init()
         m_num_cols = -1;
     }
 
+    // Links whose consumer runs on another event queue put their flits
+    // aside, and they are handed over at every quantum boundary in link
+    // order, so that the result does not depend on host thread
+    // scheduling.
+    std::vector<NetworkLink *> links(m_networklinks.begin(),
+                                     m_networklinks.end());
+    links.insert(links.end(), m_creditlinks.begin(), m_creditlinks.end());
+    for (auto *link : links) {
+        if (link->eventQueue() !=
+            link->getLinkConsumer()->getObject()->eventQueue()) {
+            link->setRemote(true);
+            m_remote_links.push_back(link);
+        }
+    }
+
+    // The network interfaces of each event queue allocate packet ids
+    // from their own range, whose prefix is the index of the queue in
+    // the order the interfaces are first seen.
+    std::vector<EventQueue *> partitions;
+    for (auto *ni : m_nis) {
+        auto it = std::find(partitions.begin(), partitions.end(),
+                            ni->eventQueue());
+        ni->setPartition(it - partitions.begin());
+        if (it == partitions.end())
+            partitions.push_back(ni->eventQueue());
+    }
+    m_packet_ids.resize(std::max<size_t>(partitions.size(), 1));
+    m_partition_stats.resize(m_packet_ids.size());
+    for (auto &stats : m_partition_stats)
+        stats.clear(m_virtual_networks, m_routers.size());
+    m_packet_id_bits = 31 - ceilLog2(m_packet_ids.size());
+
+    if (isPartitioned()) {
+        // Bridges reach into the objects on both of their sides
+        fatal_if(!m_networkbridges.empty(), "%s: network bridges (CDC or "
+                 "SerDes) are not supported when the network is partitioned "
+                 "over several event queues\n", name());
+        GlobalSyncEvent::quantumCallbacks().push_back(
+            [this]() { deliverRemoteFlits(); });
+    }
+
     // FaultModel: declare each router to the fault model
     if (isFaultModelEnabled()) {
         for (std::vector<Router*>::const_iterator i= m_routers.begin();
@@ -580,11 +623,69 @@ GarnetNetwork::collateStats()
     for (int i = 0; i < m_routers.size(); i++) {
         m_routers[i]->collateStats();
     }
+
+    collatePartitionStats();
+}
+
+void
+GarnetNetwork::PartitionStats::clear(int num_vnets, int num_routers)
+{
+    packetsInjected.assign(num_vnets, 0);
+    packetsReceived.assign(num_vnets, 0);
+    packetNetworkLatency.assign(num_vnets, 0);
+    packetQueueingLatency.assign(num_vnets, 0);
+    flitsInjected.assign(num_vnets, 0);
+    flitsReceived.assign(num_vnets, 0);
+    flitNetworkLatency.assign(num_vnets, 0);
+    flitQueueingLatency.assign(num_vnets, 0);
+    totalHops = 0;
+    dataTraffic.assign(num_routers * num_routers, 0);
+    ctrlTraffic.assign(num_routers * num_routers, 0);
+}
+
+void
+GarnetNetwork::collatePartitionStats()
+{
+    // The counters are only read here, when all the event queues are
+    // stopped to dump the statistics. Integer sums do not depend on the
+    // order the partitions are added in.
+    const int num_routers = m_routers.size();
+    for (auto &stats : m_partition_stats) {
+        for (int vnet = 0; vnet < m_virtual_networks; vnet++) {
+            m_packets_injected[vnet] += stats.packetsInjected[vnet];
+            m_packets_received[vnet] += stats.packetsReceived[vnet];
+            m_packet_network_latency[vnet] +=
+                stats.packetNetworkLatency[vnet];
+            m_packet_queueing_latency[vnet] +=
+                stats.packetQueueingLatency[vnet];
+            m_flits_injected[vnet] += stats.flitsInjected[vnet];
+            m_flits_received[vnet] += stats.flitsReceived[vnet];
+            m_flit_network_latency[vnet] += stats.flitNetworkLatency[vnet];
+            m_flit_queueing_latency[vnet] +=
+                stats.flitQueueingLatency[vnet];
+        }
+        m_total_hops += stats.totalHops;
+        for (int src = 0; src < num_routers; src++) {
+            for (int dest = 0; dest < num_routers; dest++) {
+                const int i = src * num_routers + dest;
+                if (stats.dataTraffic[i])
+                    *m_data_traffic_distribution[src][dest] +=
+                        stats.dataTraffic[i];
+                if (stats.ctrlTraffic[i])
+                    *m_ctrl_traffic_distribution[src][dest] +=
+                        stats.ctrlTraffic[i];
+            }
+        }
+        stats.clear(m_virtual_networks, num_routers);
+    }
 }
 
 void
 GarnetNetwork::resetStats()
 {
+    // Drop the counts since the last dump along with the statistics
+    for (auto &stats : m_partition_stats)
+        stats.clear(m_virtual_networks, m_routers.size());
     for (int i = 0; i < m_routers.size(); i++) {
         m_routers[i]->resetStats();
     }
@@ -603,16 +704,26 @@ GarnetNetwork::print(std::ostream& out) const
 }
 
 void
-GarnetNetwork::update_traffic_distribution(RouteInfo route)
+GarnetNetwork::deliverRemoteFlits()
+{
+    for (auto *link : m_remote_links)
+        link->deliverRemoteFlits();
+}
+
+void
+GarnetNetwork::update_traffic_distribution(int partition,
+                                           const RouteInfo &route)
 {
     int src_node = route.src_router;
     int dest_node = route.dest_router;
     int vnet = route.vnet;
 
+    PartitionStats &stats = m_partition_stats[partition];
+    const int i = src_node * m_routers.size() + dest_node;
     if (m_vnet_type[vnet] == DATA_VNET_)
-        (*m_data_traffic_distribution[src_node][dest_node])++;
+        stats.dataTraffic[i]++;
     else
-        (*m_ctrl_traffic_distribution[src_node][dest_node])++;
+        stats.ctrlTraffic[i]++;
 }
 
 bool
@@ -32,6 +32,7 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_GARNETNETWORK_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_GARNETNETWORK_HH__
 
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -117,45 +118,83 @@ class GarnetNetwork : public Network
     void resetStats();
     void print(std::ostream& out) const;
 
-    // increment counters
-    void increment_injected_packets(int vnet) { m_packets_injected[vnet]++; }
-    void increment_received_packets(int vnet) { m_packets_received[vnet]++; }
+    /**
+     * The network is partitioned over several event queues when some of
+     * its links connect objects on different queues.
+     */
+    bool isPartitioned() const { return !m_remote_links.empty(); }
 
+    // increment counters of the partition of a network interface, see
+    // PartitionStats
     void
-    increment_packet_network_latency(Tick latency, int vnet)
+    increment_injected_packets(int partition, int vnet)
     {
-        m_packet_network_latency[vnet] += latency;
+        m_partition_stats[partition].packetsInjected[vnet]++;
     }
 
     void
-    increment_packet_queueing_latency(Tick latency, int vnet)
+    increment_received_packets(int partition, int vnet)
     {
-        m_packet_queueing_latency[vnet] += latency;
+        m_partition_stats[partition].packetsReceived[vnet]++;
     }
 
-    void increment_injected_flits(int vnet) { m_flits_injected[vnet]++; }
-    void increment_received_flits(int vnet) { m_flits_received[vnet]++; }
+    void
+    increment_packet_network_latency(int partition, Tick latency, int vnet)
+    {
+        m_partition_stats[partition].packetNetworkLatency[vnet] += latency;
+    }
 
     void
-    increment_flit_network_latency(Tick latency, int vnet)
+    increment_packet_queueing_latency(int partition, Tick latency, int vnet)
     {
-        m_flit_network_latency[vnet] += latency;
+        m_partition_stats[partition].packetQueueingLatency[vnet] += latency;
     }
 
     void
-    increment_flit_queueing_latency(Tick latency, int vnet)
+    increment_injected_flits(int partition, int vnet)
     {
-        m_flit_queueing_latency[vnet] += latency;
+        m_partition_stats[partition].flitsInjected[vnet]++;
     }
 
     void
-    increment_total_hops(int hops)
+    increment_received_flits(int partition, int vnet)
     {
-        m_total_hops += hops;
+        m_partition_stats[partition].flitsReceived[vnet]++;
     }
 
-    void update_traffic_distribution(RouteInfo route);
-    int getNextPacketID() { return m_next_packet_id++; }
+    void
+    increment_flit_network_latency(int partition, Tick latency, int vnet)
+    {
+        m_partition_stats[partition].flitNetworkLatency[vnet] += latency;
+    }
+
+    void
+    increment_flit_queueing_latency(int partition, Tick latency, int vnet)
+    {
+        m_partition_stats[partition].flitQueueingLatency[vnet] += latency;
+    }
+
+    void
+    increment_total_hops(int partition, int hops)
+    {
+        m_partition_stats[partition].totalHops += hops;
+    }
+
+    void update_traffic_distribution(int partition, const RouteInfo &route);
+
+    /**
+     * Allocate a packet id for a network interface of a partition.
+     * Each partition, i.e., each event queue the network interfaces run
+     * on, draws its ids from its own range, so the ids do not depend on
+     * the host thread scheduling.
+     */
+    int
+    getNextPacketID(int partition)
+    {
+        const uint32_t local_id = m_packet_ids[partition].next++;
+        return (uint32_t(partition) << m_packet_id_bits) |
+            (local_id & ((1U << m_packet_id_bits) - 1));
+    }
 
   protected:
     // Configuration
@@ -213,7 +252,60 @@ class GarnetNetwork : public Network
     std::vector<NetworkBridge *> m_networkbridges; // All network bridges
     std::vector<CreditLink *> m_creditlinks; // All credit links in the network
     std::vector<NetworkInterface *> m_nis;   // All NI's in Network
-    int m_next_packet_id; // static vairable for packet id allocation
+
+    //! Next packet id of a partition, on its own cache line as each
+    //! partition is updated by its own thread
+    struct alignas(64) PacketIdCounter
+    {
+        uint32_t next = 0;
+    };
+    std::vector<PacketIdCounter> m_packet_ids;
+    //! Bits of a packet id below the partition prefix
+    unsigned m_packet_id_bits = 31;
+
+    /**
+     * Packet and flit counters of a partition. The network interfaces
+     * of a partition only update the counters of their partition, which
+     * are added to the statistics of the network when they are dumped,
+     * so the interfaces of different event queues never share a counter.
+     * Each partition is on its own cache lines, like its packet ids.
+     */
+    struct alignas(64) PartitionStats
+    {
+        std::vector<uint64_t> packetsInjected;
+        std::vector<uint64_t> packetsReceived;
+        std::vector<Tick> packetNetworkLatency;
+        std::vector<Tick> packetQueueingLatency;
+        std::vector<uint64_t> flitsInjected;
+        std::vector<uint64_t> flitsReceived;
+        std::vector<Tick> flitNetworkLatency;
+        std::vector<Tick> flitQueueingLatency;
+        uint64_t totalHops;
+        //! Packets of data and control vnets, indexed by source router
+        //! times the number of routers plus destination router
+        std::vector<uint64_t> dataTraffic;
+        std::vector<uint64_t> ctrlTraffic;
+
+        /** Clear the counters, sizing them for a network. */
+        void clear(int num_vnets, int num_routers);
+    };
+    std::vector<PartitionStats> m_partition_stats;
+
+    /**
+     * Add the counters of all the partitions to the statistics of the
+     * network, and clear them.
+     */
+    void collatePartitionStats();
+
+    //! Links whose consumer runs on another event queue
+    std::vector<NetworkLink *> m_remote_links;
+
+    /**
+     * Hand the flits and credits sent across event queues over to their
+     * consumers. This is registered as a quantum callback of the
+     * GlobalSyncEvent.
+     */
+    void deliverRemoteFlits();
 };
 
 inline std::ostream&
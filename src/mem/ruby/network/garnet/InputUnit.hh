@@ -116,6 +116,8 @@ class InputUnit : public Consumer
     inline flit*
     getTopFlit(int vc)
     {
+        if (--m_num_flits == 0)
+            m_router->set_inport_idle(m_id);
         return virtualChannels[vc].getTopFlit();
     }
 
@@ -141,6 +143,9 @@ class InputUnit : public Consumer
 
     inline int get_inlink_id() { return m_in_link->get_id(); }
 
+    //! No flits are in flight on the input link
+    inline bool is_link_idle() { return m_in_link->getBuffer()->isEmpty(); }
+
     inline void
     set_credit_link(CreditLink *credit_link)
     {
@@ -168,6 +173,8 @@ class InputUnit : public Consumer
 
     // Input Virtual channels
     std::vector<VirtualChannel> virtualChannels;
+    //! Number of flits in all input VCs
+    int m_num_flits;
 
     // Statistical variables
     std::vector<double> m_num_buffer_writes;
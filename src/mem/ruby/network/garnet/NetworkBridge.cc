@@ -111,8 +111,7 @@ NetworkBridge::scheduleFlit(flit *t_flit, Cycles latency)
     sendTime = std::max(nextAvailTick, sendTime);
     t_flit->set_time(sendTime);
     lastScheduledAt = sendTime;
-    linkBuffer.insert(t_flit);
-    link_consumer->scheduleEventAbsolute(sendTime);
+    sendFlit(t_flit, sendTime);
 }
 
 void
@@ -267,9 +266,7 @@ NetworkBridge::wakeup()
     }
 
     // Reschedule in case there is a waiting flit.
-    if (!link_srcQueue->isEmpty()) {
-        scheduleEvent(Cycles(1));
-    }
+    scheduleNextFlit();
 }
 
 } // namespace garnet
@@ -157,7 +157,7 @@ NetworkInterface::incrementStats(flit *t_flit)
     int vnet = t_flit->get_vnet();
 
     // Latency
-    m_net_ptr->increment_received_flits(vnet);
+    m_net_ptr->increment_received_flits(m_partition, vnet);
     Tick network_delay =
         t_flit->get_dequeue_time() -
         t_flit->get_enqueue_time() - cyclesToTicks(Cycles(1));
@@ -165,17 +165,22 @@ NetworkInterface::incrementStats(flit *t_flit)
     Tick dest_queueing_delay = (curTick() - t_flit->get_dequeue_time());
     Tick queueing_delay = src_queueing_delay + dest_queueing_delay;
 
-    m_net_ptr->increment_flit_network_latency(network_delay, vnet);
-    m_net_ptr->increment_flit_queueing_latency(queueing_delay, vnet);
+    m_net_ptr->increment_flit_network_latency(m_partition, network_delay,
+                                              vnet);
+    m_net_ptr->increment_flit_queueing_latency(m_partition, queueing_delay,
+                                               vnet);
 
     if (t_flit->get_type() == TAIL_ || t_flit->get_type() == HEAD_TAIL_) {
-        m_net_ptr->increment_received_packets(vnet);
-        m_net_ptr->increment_packet_network_latency(network_delay, vnet);
-        m_net_ptr->increment_packet_queueing_latency(queueing_delay, vnet);
+        m_net_ptr->increment_received_packets(m_partition, vnet);
+        m_net_ptr->increment_packet_network_latency(m_partition,
+                                                    network_delay, vnet);
+        m_net_ptr->increment_packet_queueing_latency(m_partition,
+                                                     queueing_delay, vnet);
     }
 
     // Hops
-    m_net_ptr->increment_total_hops(t_flit->get_route().hops_traversed);
+    m_net_ptr->increment_total_hops(m_partition,
+                                    t_flit->get_route().hops_traversed);
 }
 
 /*
@@ -439,11 +444,11 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         // so that the first router increments it to 0
         route.hops_traversed = -1;
 
-        m_net_ptr->increment_injected_packets(vnet);
-        m_net_ptr->update_traffic_distribution(route);
-        int packet_id = m_net_ptr->getNextPacketID();
+        m_net_ptr->increment_injected_packets(m_partition, vnet);
+        m_net_ptr->update_traffic_distribution(m_partition, route);
+        int packet_id = m_net_ptr->getNextPacketID(m_partition);
         for (int i = 0; i < num_flits; i++) {
-            m_net_ptr->increment_injected_flits(vnet);
+            m_net_ptr->increment_injected_flits(m_partition, vnet);
             flit *fl = new flit(packet_id,
                 i, vc, vnet, route, num_flits, new_msg_ptr,
                 m_net_ptr->MessageSizeType_to_int(
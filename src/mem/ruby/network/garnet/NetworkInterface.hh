@@ -78,6 +78,9 @@ class NetworkInterface : public ClockedObject, public Consumer
     void print(std::ostream& out) const;
     int get_vnet(int vc);
     void init_net_ptr(GarnetNetwork *net_ptr) { m_net_ptr = net_ptr; }
+    //! Set the partition of the network this interface allocates
+    //! packet ids in
+    void setPartition(int partition) { m_partition = partition; }
 
     bool functionalRead(Packet *pkt, WriteMask &mask);
     uint32_t functionalWrite(Packet *);
@@ -270,6 +273,7 @@ class NetworkInterface : public ClockedObject, public Consumer
 
   private:
     GarnetNetwork *m_net_ptr;
+    int m_partition = 0;
     const NodeID m_id;
     const int m_virtual_networks;
     int m_vc_per_vnet;
@@ -32,9 +32,11 @@
 
 #include "mem/ruby/network/garnet/NetworkLink.hh"
 
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/CreditLink.hh"
+#include "sim/eventq.hh"
 
 namespace gem5
 {
@@ -50,7 +52,7 @@ NetworkLink::NetworkLink(const Params &p)
       m_type(NUM_LINK_TYPES_),
       m_latency(p.link_latency), m_link_utilized(0),
       m_virt_nets(p.virt_nets), linkBuffer(),
-      link_consumer(nullptr), link_srcQueue(nullptr)
+      link_consumer(nullptr), link_srcQueue(nullptr), m_remote(false)
 {
     int num_vnets = (p.supported_vnets).size();
     mVnets.resize(num_vnets);
@@ -66,6 +68,12 @@ NetworkLink::setLinkConsumer(Consumer *consumer)
     link_consumer = consumer;
 }
 
+void
+NetworkLink::setArrivalCallback(std::function<void()> callback)
+{
+    m_arrival_callback = callback;
+}
+
 void
 NetworkLink::setVcsPerVnet(uint32_t consumerVcs)
 {
@@ -98,14 +106,62 @@ NetworkLink::wakeup()
                 (mVnets.size() == 0));
         }
         t_flit->set_time(clockEdge(m_latency));
-        linkBuffer.insert(t_flit);
-        link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
         m_link_utilized++;
         m_vc_load[t_flit->get_vc()]++;
+        sendFlit(t_flit, clockEdge(m_latency));
     }
 
+    scheduleNextFlit();
+}
+
+void
+NetworkLink::sendFlit(flit *t_flit, Tick arrival_time)
+{
+    if (m_remote && inParallelMode) {
+        // The consumer may already be up to one quantum ahead of us, so
+        // the flit must not arrive before the end of the current quantum.
+        fatal_if(arrival_time < curTick() + simQuantum,
+                 "%s: latency %d between event queues is lower than the "
+                 "simulation quantum %d\n", name(), arrival_time - curTick(),
+                 simQuantum);
+        m_remote_flits.emplace_back(t_flit, arrival_time);
+        return;
+    }
+
+    linkBuffer.insert(t_flit);
+    if (m_arrival_callback)
+        m_arrival_callback();
+    link_consumer->scheduleEventAbsolute(arrival_time);
+}
+
+void
+NetworkLink::deliverRemoteFlits()
+{
+    // All other threads are stopped, so we can temporarily act on
+    // behalf of the consumer's event queue to schedule its wakeups.
+    EventQueue *old_eventq = curEventQueue();
+    curEventQueue(link_consumer->getObject()->eventQueue());
+
+    for (auto &remote : m_remote_flits) {
+        linkBuffer.insert(remote.first);
+        if (m_arrival_callback)
+            m_arrival_callback();
+        link_consumer->scheduleEventAbsolute(remote.second);
+    }
+    m_remote_flits.clear();
+
+    curEventQueue(old_eventq);
+}
+
+void
+NetworkLink::scheduleNextFlit()
+{
+    // Rather than polling the source queue every cycle, sleep until its
+    // next flit is ready. Flits inserted later wake us up themselves.
     if (!link_srcQueue->isEmpty()) {
-        scheduleEvent(Cycles(1));
+        scheduleEventAbsolute(std::max(clockEdge(Cycles(1)),
+                                       link_srcQueue->peekTopFlit()->
+                                           get_time()));
     }
 }
 
@@ -122,13 +178,21 @@ NetworkLink::resetStats()
 bool
 NetworkLink::functionalRead(Packet *pkt, WriteMask &mask)
 {
-    return linkBuffer.functionalRead(pkt, mask);
+    bool read = linkBuffer.functionalRead(pkt, mask);
+    for (auto &remote : m_remote_flits) {
+        if (remote.first->functionalRead(pkt, mask))
+            read = true;
+    }
+    return read;
 }
 
 uint32_t
 NetworkLink::functionalWrite(Packet *pkt)
 {
-    return linkBuffer.functionalWrite(pkt);
+    uint32_t num_functional_writes = linkBuffer.functionalWrite(pkt);
+    for (auto &remote : m_remote_flits)
+        num_functional_writes += remote.first->functionalWrite(pkt);
+    return num_functional_writes;
 }
 
 } // namespace garnet
@@ -33,7 +33,9 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_NETWORKLINK_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_NETWORKLINK_HH__
 
+#include <functional>
 #include <iostream>
+#include <utility>
 #include <vector>
 
 #include "mem/ruby/common/Consumer.hh"
@@ -61,6 +63,10 @@ class NetworkLink : public ClockedObject, public Consumer
     ~NetworkLink() = default;
 
     void setLinkConsumer(Consumer *consumer);
+    Consumer *getLinkConsumer() { return link_consumer; }
+    //! Call a function whenever a flit is put on the link, e.g., to let
+    //! a router track its ports with flits in flight
+    void setArrivalCallback(std::function<void()> callback);
     void setSourceQueue(flitBuffer *src_queue, ClockedObject *srcClockObject);
     virtual void setVcsPerVnet(uint32_t consumerVcs);
     void setType(link_type type) { m_type = type; }
@@ -81,6 +87,21 @@ class NetworkLink : public ClockedObject, public Consumer
     inline flit* peekLink() { return linkBuffer.peekTopFlit(); }
     inline flit* consumeLink() { return linkBuffer.getTopFlit(); }
 
+    /**
+     * Flits for a consumer on another event queue are put aside and
+     * only put on the link at the next quantum boundary, see
+     * deliverRemoteFlits().
+     */
+    void setRemote(bool remote) { m_remote = remote; }
+    bool isRemote() const { return m_remote; }
+
+    /**
+     * Put the flits sent to a consumer on another event queue on the
+     * link and wake up the consumer. Must only be called while all
+     * other simulation threads are stopped.
+     */
+    void deliverRemoteFlits();
+
     bool functionalRead(Packet *pkt, WriteMask &mask);
     uint32_t functionalWrite(Packet *);
     void resetStats();
@@ -99,11 +120,29 @@ class NetworkLink : public ClockedObject, public Consumer
     unsigned int m_link_utilized;
     std::vector<unsigned int> m_vc_load;
 
+    //! The consumer runs on another event queue
+    bool m_remote;
+
+    /**
+     * Flits sent to a remote consumer during the current quantum, and
+     * the tick they arrive at. Only the thread of this link writes to
+     * it, and it is drained at the quantum boundary while that thread
+     * is stopped, so it needs no lock.
+     */
+    std::vector<std::pair<flit *, Tick>> m_remote_flits;
+
   protected:
+    //! Put a flit on the link and wake up the consumer when it arrives
+    void sendFlit(flit *t_flit, Tick arrival_time);
+
+    //! Wake up when the next flit in the source queue is ready, if any
+    void scheduleNextFlit();
+
     uint32_t m_virt_nets;
     flitBuffer linkBuffer;
     Consumer *link_consumer;
     flitBuffer *link_srcQueue;
+    std::function<void()> m_arrival_callback;
 
 };
 
@@ -165,6 +165,12 @@ OutputUnit::set_credit_link(CreditLink *credit_link)
     m_credit_link = credit_link;
 }
 
+bool
+OutputUnit::is_credit_link_idle()
+{
+    return m_credit_link->getBuffer()->isEmpty();
+}
+
 void
 OutputUnit::insert_flit(flit *t_flit)
 {
@@ -61,6 +61,8 @@ class OutputUnit : public Consumer
     ~OutputUnit() = default;
     void set_out_link(NetworkLink *link);
     void set_credit_link(CreditLink *credit_link);
+    //! No credits are in flight on the credit link
+    bool is_credit_link_idle();
     void wakeup();
     flitBuffer* getOutQueue();
     void print(std::ostream& out) const {};
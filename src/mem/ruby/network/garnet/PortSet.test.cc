@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <vector>
+
+#include "mem/ruby/network/garnet/CommonTypes.hh"
+
+using namespace gem5;
+using namespace gem5::ruby::garnet;
+
+namespace
+{
+
+std::vector<int>
+members(const PortSet &ports)
+{
+    std::vector<int> result;
+    ports.forEach([&result](int port) { result.push_back(port); });
+    return result;
+}
+
+} // anonymous namespace
+
+TEST(PortSetTest, Empty)
+{
+    PortSet ports;
+    ports.resize(5);
+    EXPECT_TRUE(ports.empty());
+    EXPECT_TRUE(members(ports).empty());
+
+    ports.insert(4);
+    EXPECT_FALSE(ports.empty());
+    EXPECT_TRUE(ports.contains(4));
+    EXPECT_FALSE(ports.contains(3));
+
+    ports.clear();
+    EXPECT_TRUE(ports.empty());
+    EXPECT_FALSE(ports.contains(4));
+}
+
+/** Ports are visited in port order, across words. */
+TEST(PortSetTest, PortOrder)
+{
+    PortSet ports;
+    ports.resize(200);
+    for (int port : {199, 64, 0, 63, 128, 5})
+        ports.insert(port);
+    EXPECT_EQ(members(ports), std::vector<int>({0, 5, 63, 64, 128, 199}));
+}
+
+/** The port being visited can be erased, as routers do once it is idle. */
+TEST(PortSetTest, EraseWhileVisiting)
+{
+    PortSet ports;
+    ports.resize(70);
+    for (int port = 0; port < 70; port += 3)
+        ports.insert(port);
+
+    std::vector<int> visited;
+    ports.forEach([&](int port) {
+        visited.push_back(port);
+        if (port % 2 == 0)
+            ports.erase(port);
+    });
+
+    std::vector<int> expected;
+    for (int port = 0; port < 70; port += 3)
+        expected.push_back(port);
+    EXPECT_EQ(visited, expected);
+
+    expected.clear();
+    for (int port = 3; port < 70; port += 6)
+        expected.push_back(port);
+    EXPECT_EQ(members(ports), expected);
+}
+
+/** Random insertions and erasures match an ordered set. */
+TEST(PortSetTest, MatchesOrderedSet)
+{
+    std::mt19937 rng(0);
+    for (int num_ports : {1, 7, 64, 65, 130}) {
+        PortSet ports;
+        ports.resize(num_ports);
+        std::set<int> expected;
+        for (int step = 0; step < 2000; step++) {
+            const int port = rng() % num_ports;
+            if (rng() % 2) {
+                ports.insert(port);
+                expected.insert(port);
+            } else {
+                ports.erase(port);
+                expected.erase(port);
+            }
+            ASSERT_EQ(ports.contains(port), expected.count(port) == 1);
+            ASSERT_EQ(ports.empty(), expected.empty());
+            ASSERT_EQ(members(ports),
+                      std::vector<int>(expected.begin(), expected.end()));
+        }
+    }
+}
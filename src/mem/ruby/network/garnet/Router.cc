@@ -75,9 +75,11 @@ Router::wakeup()
     assert(clockEdge() == curTick());
 
     // check for incoming flits
-    for (int inport = 0; inport < m_input_unit.size(); inport++) {
+    m_link_inports.forEach([this](int inport) {
         m_input_unit[inport]->wakeup();
-    }
+        if (m_input_unit[inport]->is_link_idle())
+            m_link_inports.erase(inport);
+    });
 
     // check for incoming credits
     // Note: the credit update is happening before SA
@@ -85,15 +87,19 @@ Router::wakeup()
     //     credit traversal (1-cycle) + SA (1-cycle) + Link Traversal (1-cycle)
     // if we want the credit update to take place after SA, this loop should
     // be moved after the SA request
-    for (int outport = 0; outport < m_output_unit.size(); outport++) {
+    m_credit_outports.forEach([this](int outport) {
         m_output_unit[outport]->wakeup();
-    }
+        if (m_output_unit[outport]->is_credit_link_idle())
+            m_credit_outports.erase(outport);
+    });
 
     // Switch Allocation
-    switchAllocator.wakeup();
+    if (!m_busy_inports.empty())
+        switchAllocator.wakeup();
 
     // Switch Traversal
-    crossbarSwitch.wakeup();
+    if (crossbarSwitch.has_flits())
+        crossbarSwitch.wakeup();
 }
 
 void
@@ -110,11 +116,15 @@ Router::addInPort(PortDirection inport_dirn,
     input_unit->set_in_link(in_link);
     input_unit->set_credit_link(credit_link);
     in_link->setLinkConsumer(this);
+    in_link->setArrivalCallback([this, port_num]() {
+        m_link_inports.insert(port_num); });
     in_link->setVcsPerVnet(get_vc_per_vnet());
     credit_link->setSourceQueue(input_unit->getCreditQueue(), this);
     credit_link->setVcsPerVnet(get_vc_per_vnet());
 
     m_input_unit.push_back(std::shared_ptr<InputUnit>(input_unit));
+    m_link_inports.resize(m_input_unit.size());
+    m_busy_inports.resize(m_input_unit.size());
 
     routingUnit.addInDirection(inport_dirn, port_num);
 }
@@ -135,11 +145,14 @@ Router::addOutPort(PortDirection outport_dirn,
     output_unit->set_out_link(out_link);
     output_unit->set_credit_link(credit_link);
     credit_link->setLinkConsumer(this);
+    credit_link->setArrivalCallback([this, port_num]() {
+        m_credit_outports.insert(port_num); });
     credit_link->setVcsPerVnet(consumerVcs);
     out_link->setSourceQueue(output_unit->getOutQueue(), this);
     out_link->setVcsPerVnet(consumerVcs);
 
     m_output_unit.push_back(std::shared_ptr<OutputUnit>(output_unit));
+    m_credit_outports.resize(m_output_unit.size());
 
     routingUnit.addRoute(routing_table_entry);
     routingUnit.addWeight(link_weight);
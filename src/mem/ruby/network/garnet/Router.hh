@@ -120,6 +120,11 @@ class Router : public BasicRouter, public Consumer
     void grant_switch(int inport, flit *t_flit);
     void schedule_wakeup(Cycles time);
 
+    //! Inports with flits in their input VCs
+    const PortSet &get_busy_inports() const { return m_busy_inports; }
+    void set_inport_busy(int inport) { m_busy_inports.insert(inport); }
+    void set_inport_idle(int inport) { m_busy_inports.erase(inport); }
+
     std::string getPortDirectionName(PortDirection direction);
     void printFaultVector(std::ostream& out);
     void printAggregateFaultProbability(std::ostream& out);
@@ -155,6 +160,15 @@ class Router : public BasicRouter, public Consumer
     std::vector<std::shared_ptr<InputUnit>> m_input_unit;
     std::vector<std::shared_ptr<OutputUnit>> m_output_unit;
 
+    // Only the ports with work in flight are evaluated on a wakeup, so
+    // that idle ports, and idle routers, cost nothing.
+    //! Inports with flits on their input link
+    PortSet m_link_inports;
+    //! Outports with credits on their credit link
+    PortSet m_credit_outports;
+    //! Inports with flits in their input VCs
+    PortSet m_busy_inports;
+
     // Statistical variables required for power computations
     statistics::Scalar m_buffer_reads;
     statistics::Scalar m_buffer_writes;
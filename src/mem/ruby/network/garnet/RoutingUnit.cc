@@ -47,6 +47,7 @@ namespace garnet
 {
 
 RoutingUnit::RoutingUnit(Router *router)
+    : m_rng(Random::genRandom())
 {
     m_router = router;
     m_routing_table.clear();
@@ -137,8 +138,12 @@ RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
 
     // Randomly select any candidate output link
     int candidate = 0;
-    if (!(m_router->get_net_ptr())->isVNetOrdered(vnet))
-        candidate = rand() % num_candidates;
+    if (!(m_router->get_net_ptr())->isVNetOrdered(vnet)) {
+        if (m_router->get_net_ptr()->isPartitioned())
+            candidate = m_rng->random(0, num_candidates - 1);
+        else
+            candidate = rand() % num_candidates;
+    }
 
     output_link = output_link_candidates.at(candidate);
     return output_link;
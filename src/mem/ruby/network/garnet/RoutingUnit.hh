@@ -31,6 +31,7 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_ROUTINGUNIT_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_ROUTINGUNIT_HH__
 
+#include "base/random.hh"
 #include "mem/ruby/common/Consumer.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
@@ -86,6 +87,11 @@ class RoutingUnit
   private:
     Router *m_router;
 
+    //! Picks among equivalent routes when the network is partitioned
+    //! over several event queues, where the shared rand() state would
+    //! make the result depend on host thread scheduling
+    Random::RandomPtr m_rng;
+
     // Routing Table
     std::vector<std::vector<NetDest>> m_routing_table;
     std::vector<int> m_weight_table;
@@ -66,6 +66,7 @@ SwitchAllocator::init()
     m_round_robin_invc.resize(m_num_inports);
     m_port_requests.resize(m_num_inports);
     m_vc_winners.resize(m_num_inports);
+    m_requested_outports.resize(m_num_outports);
 
     for (int i = 0; i < m_num_inports; i++) {
         m_round_robin_invc[i] = 0;
@@ -112,7 +113,8 @@ SwitchAllocator::arbitrate_inports()
 {
     // Select a VC from each input in a round robin manner
     // Independent arbiter at each input port
-    for (int inport = 0; inport < m_num_inports; inport++) {
+    // Only the input ports holding flits can place a request
+    m_router->get_busy_inports().forEach([this](int inport) {
         int invc = m_round_robin_invc[inport];
 
         for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
@@ -133,6 +135,7 @@ SwitchAllocator::arbitrate_inports()
                     m_input_arbiter_activity++;
                     m_port_requests[inport] = outport;
                     m_vc_winners[inport] = invc;
+                    m_requested_outports.insert(outport);
 
                     break; // got one vc winner for this port
                 }
@@ -142,7 +145,7 @@ SwitchAllocator::arbitrate_inports()
             if (invc >= m_num_vcs)
                 invc = 0;
         }
-    }
+    });
 }
 
 /*
@@ -165,7 +168,8 @@ SwitchAllocator::arbitrate_outports()
     // Now there are a set of input vc requests for output vcs.
     // Again do round robin arbitration on these requests
     // Independent arbiter at each output port
-    for (int outport = 0; outport < m_num_outports; outport++) {
+    // Only the output ports requested during SA-I have a winner
+    m_requested_outports.forEach([this](int outport) {
         int inport = m_round_robin_inport[outport];
 
         for (int inport_iter = 0; inport_iter < m_num_inports;
@@ -263,7 +267,7 @@ SwitchAllocator::arbitrate_outports()
             if (inport >= m_num_inports)
                 inport = 0;
         }
-    }
+    });
 }
 
 /*
@@ -362,14 +366,16 @@ SwitchAllocator::check_for_wakeup()
         return;
     }
 
-    for (int i = 0; i < m_num_inports; i++) {
-        for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
-                m_router->schedule_wakeup(Cycles(1));
-                return;
-            }
+    bool wakeup = false;
+    m_router->get_busy_inports().forEach([&](int i) {
+        for (int j = 0; !wakeup && j < m_num_vcs; j++) {
+            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle))
+                wakeup = true;
         }
-    }
+    });
+
+    if (wakeup)
+        m_router->schedule_wakeup(Cycles(1));
 }
 
 int
@@ -387,6 +393,7 @@ void
 SwitchAllocator::clear_request_vector()
 {
     std::fill(m_port_requests.begin(), m_port_requests.end(), -1);
+    m_requested_outports.clear();
 }
 
 void
@@ -90,6 +90,8 @@ class SwitchAllocator : public Consumer
     std::vector<int> m_round_robin_inport;
     std::vector<int> m_port_requests;
     std::vector<int> m_vc_winners;
+    //! Output ports requested during SA-I
+    PortSet m_requested_outports;
 };
 
 } // namespace garnet
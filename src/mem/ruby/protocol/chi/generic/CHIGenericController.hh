@@ -128,9 +128,9 @@ class CHIGenericController : public AbstractController
     using CHIRequestMsg = CHI::CHIRequestMsg;
     using CHIResponseMsg = CHI::CHIResponseMsg;
     using CHIDataMsg = CHI::CHIDataMsg;
-    using CHIRequestMsgPtr = std::shared_ptr<CHIRequestMsg>;
-    using CHIResponseMsgPtr = std::shared_ptr<CHIResponseMsg>;
-    using CHIDataMsgPtr = std::shared_ptr<CHIDataMsg>;
+    using CHIRequestMsgPtr = RefCountingPtr<CHIRequestMsg>;
+    using CHIResponseMsgPtr = RefCountingPtr<CHIResponseMsg>;
+    using CHIDataMsgPtr = RefCountingPtr<CHIDataMsg>;
 
     bool
     sendRequestMsg(CHIRequestMsgPtr msg)
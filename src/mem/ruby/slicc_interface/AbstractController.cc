@@ -277,7 +277,7 @@ AbstractController::serviceMemoryQueue()
     }
 
     RequestPtr req
-        = std::make_shared<Request>(mem_msg->m_addr, req_size, 0, m_id);
+        = Request::create(mem_msg->m_addr, req_size, 0, m_id);
     PacketPtr pkt;
     if (mem_msg->getType() == MemoryRequestType_MEMORY_WB) {
         pkt = Packet::createWrite(req);
@@ -387,8 +387,8 @@ AbstractController::recvTimingResp(PacketPtr pkt)
 
     int blk_size = m_ruby_system->getBlockSizeBytes();
 
-    std::shared_ptr<MemoryMsg> msg =
-        std::make_shared<MemoryMsg>(clockEdge(), blk_size, m_ruby_system);
+    RefCountingPtr<MemoryMsg> msg =
+        new MemoryMsg(clockEdge(), blk_size, m_ruby_system);
     (*msg).m_addr = pkt->getAddr();
     (*msg).m_Sender = m_machineID;
 
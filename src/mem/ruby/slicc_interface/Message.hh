@@ -41,10 +41,11 @@
 #ifndef __MEM_RUBY_SLICC_INTERFACE_MESSAGE_HH__
 #define __MEM_RUBY_SLICC_INTERFACE_MESSAGE_HH__
 
+#include <atomic>
 #include <iostream>
-#include <memory>
 #include <stack>
 
+#include "base/refcnt.hh"
 #include "mem/packet.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/common/WriteMask.hh"
@@ -57,7 +58,13 @@ namespace ruby
 {
 
 class Message;
-typedef std::shared_ptr<Message> MsgPtr;
+
+/**
+ * Messages are reference counted intrusively. The count is only
+ * updated with atomic operations when the simulation runs several
+ * event queues, which may hand messages over between threads.
+ */
+typedef RefCountingPtr<Message> MsgPtr;
 
 class Message
 {
@@ -69,10 +76,68 @@ class Message
           m_DelayedTicks(0), m_msg_counter(0)
     { }
 
-    Message(const Message &other) = default;
+    // The copy starts without any references to it
+    Message(const Message &other)
+        : m_block_size(other.m_block_size),
+          m_time(other.m_time),
+          m_LastEnqueueTime(other.m_LastEnqueueTime),
+          m_DelayedTicks(other.m_DelayedTicks),
+          m_msg_counter(other.m_msg_counter),
+          incoming_link(other.incoming_link),
+          vnet(other.vnet)
+    { }
+
+    // Assigning a message copies its fields, but keeps the references
+    // to the message assigned to
+    Message &
+    operator=(const Message &other)
+    {
+        m_block_size = other.m_block_size;
+        m_time = other.m_time;
+        m_LastEnqueueTime = other.m_LastEnqueueTime;
+        m_DelayedTicks = other.m_DelayedTicks;
+        m_msg_counter = other.m_msg_counter;
+        incoming_link = other.incoming_link;
+        vnet = other.vnet;
+        return *this;
+    }
 
     virtual ~Message() { }
 
+    /**
+     * Use atomic operations to update the reference counts of all
+     * messages. This must be set before the simulation threads start.
+     */
+    static void setAtomicRefCount(bool atomic) { atomicRefCount = atomic; }
+
+    /// Increment the reference count
+    void
+    incref() const
+    {
+        if (atomicRefCount) {
+            refCount.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            refCount.store(refCount.load(std::memory_order_relaxed) + 1,
+                           std::memory_order_relaxed);
+        }
+    }
+
+    /// Decrement the reference count and destroy the message if all
+    /// references are gone.
+    void
+    decref() const
+    {
+        int count;
+        if (atomicRefCount) {
+            count = refCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        } else {
+            count = refCount.load(std::memory_order_relaxed) - 1;
+            refCount.store(count, std::memory_order_relaxed);
+        }
+        if (count <= 0)
+            delete this;
+    }
+
     virtual MsgPtr clone() const = 0;
     virtual void print(std::ostream& out) const = 0;
 
@@ -126,6 +191,13 @@ class Message
     int m_block_size = 0;
 
   private:
+    //! Use atomic operations to update the reference counts
+    static inline bool atomicRefCount = false;
+
+    //! Number of references to the message, mutable to count references
+    //! to const messages
+    mutable std::atomic<int> refCount{0};
+
     Tick m_time;
     Tick m_LastEnqueueTime; // my last enqueue time
     Tick m_DelayedTicks; // my delayed cycles
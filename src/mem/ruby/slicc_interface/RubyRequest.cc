@@ -133,6 +133,25 @@ RubyRequest::setWriteMask(uint32_t offset, uint32_t len,
     m_writeMask.setAtomicOps(atomicOps);
 }
 
+#if USE_MEM_POOLS
+FreeListPool &
+RubyRequest::pool()
+{
+    // Never destroyed, since requests may still be freed during exit
+    static FreeListPool *the_pool =
+        new FreeListPool("rubyRequest", sizeof(RubyRequest));
+    return *the_pool;
+}
+
+namespace
+{
+
+// Create the pool during static initialization, so that it is
+// registered before the pool statistics are set up.
+[[maybe_unused]] FreeListPool &rubyRequestPool = RubyRequest::pool();
+
+} // anonymous namespace
+#endif
 
 } // namespace ruby
 } // namespace gem5
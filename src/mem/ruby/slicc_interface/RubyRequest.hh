@@ -44,6 +44,8 @@
 #include <ostream>
 #include <vector>
 
+#include "base/free_list_pool.hh"
+#include "config/use_mem_pools.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/common/WriteMask.hh"
@@ -233,7 +235,24 @@ class RubyRequest : public Message
     {
     }
     MsgPtr clone() const
-    { return std::shared_ptr<Message>(new RubyRequest(*this)); }
+    { return MsgPtr(new RubyRequest(*this)); }
+
+#if USE_MEM_POOLS
+    /** Pool the requests are allocated from. */
+    static FreeListPool &pool();
+
+    static void *
+    operator new(size_t size)
+    {
+        return pool().allocate(size);
+    }
+
+    static void
+    operator delete(void *ptr, size_t size)
+    {
+        pool().deallocate(ptr, size);
+    }
+#endif
 
     Addr getLineAddress() const { return m_LineAddress; }
     Addr getPhysicalAddress() const { return m_PhysicalAddress; }
@@ -69,6 +69,7 @@ operator<<(std::ostream& out, const CacheMemory& obj)
 
 CacheMemory::CacheMemory(const Params &p)
     : SimObject(p),
+    m_tag_index_type(p.tag_index),
     dataArray(p.dataArrayBanks, p.dataAccessLatency, p.start_index_bit),
     tagArray(p.tagArrayBanks, p.tagAccessLatency, p.start_index_bit),
     atomicALUArray(p.atomicALUs, p.atomicLatency),
@@ -111,6 +112,8 @@ CacheMemory::init()
 
     m_cache.resize(m_cache_num_sets,
                     std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
+    if (m_tag_index_type != RubyCacheTagIndex::hash_map)
+        m_flat_tags.resize(m_cache_num_sets * m_cache_assoc, invalidTag);
     replacement_data.resize(m_cache_num_sets,
                                std::vector<ReplData>(m_cache_assoc, nullptr));
     // instantiate all the replacement_data here
@@ -147,13 +150,10 @@ CacheMemory::addressToCacheSet(Addr address) const
 int
 CacheMemory::findTagInSet(int64_t cacheSet, Addr tag) const
 {
-    assert(tag == makeLineAddress(tag));
-    // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        if (m_cache[cacheSet][it->second]->m_Permission !=
-            AccessPermission_NotPresent)
-            return it->second;
+    int loc = findTagInSetIgnorePermissions(cacheSet, tag);
+    if (loc != -1 &&
+        m_cache[cacheSet][loc]->m_Permission != AccessPermission_NotPresent)
+        return loc;
     return -1; // Not found
 }
 
@@ -165,12 +165,59 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
+    switch (m_tag_index_type) {
+      case RubyCacheTagIndex::hash_map:
+        return findTagInHashMap(tag);
+      case RubyCacheTagIndex::flat:
+        return findTagInFlatSet(cacheSet, tag);
+      default:
+        {
+            int loc = findTagInFlatSet(cacheSet, tag);
+            panic_if(loc != findTagInHashMap(tag),
+                     "%s: Tag indices disagree on address %#x: "
+                     "flat %d, hash map %d.", name(), tag, loc,
+                     findTagInHashMap(tag));
+            return loc;
+        }
+    }
+}
+
+int
+CacheMemory::findTagInHashMap(Addr tag) const
+{
     auto it = m_tag_index.find(tag);
     if (it != m_tag_index.end())
         return it->second;
     return -1; // Not found
 }
 
+void
+CacheMemory::insertTag(int64_t cacheSet, int loc, Addr tag)
+{
+    if (m_tag_index_type != RubyCacheTagIndex::hash_map) {
+        Addr &flat_tag = m_flat_tags[cacheSet * m_cache_assoc + loc];
+        // A NotPresent block may be replaced without being deallocated,
+        // in which case the hash map keeps a stale mapping for it. Drop
+        // it when checking, as the flat index can not keep it.
+        if (m_tag_index_type == RubyCacheTagIndex::checked &&
+            flat_tag != invalidTag) {
+            m_tag_index.erase(flat_tag);
+        }
+        flat_tag = tag;
+    }
+    if (m_tag_index_type != RubyCacheTagIndex::flat)
+        m_tag_index[tag] = loc;
+}
+
+void
+CacheMemory::eraseTag(int64_t cacheSet, int loc, Addr tag)
+{
+    if (m_tag_index_type != RubyCacheTagIndex::hash_map)
+        m_flat_tags[cacheSet * m_cache_assoc + loc] = invalidTag;
+    if (m_tag_index_type != RubyCacheTagIndex::flat)
+        m_tag_index.erase(tag);
+}
+
 // Given an unique cache block identifier (idx): return the valid address
 // stored by the cache block.  If the block is invalid/notpresent, the
 // function returns the 0 address
@@ -317,7 +364,7 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
             DPRINTF(RubyCache, "Allocate clearing lock for addr: 0x%x\n",
                     address);
             set[i]->m_locked = -1;
-            m_tag_index[address] = i;
+            insertTag(cacheSet, i, address);
             set[i]->setPosition(cacheSet, i);
             set[i]->replacementData = replacement_data[cacheSet][i];
             set[i]->setLastAccess(curTick());
@@ -343,7 +390,7 @@ CacheMemory::deallocate(Addr address)
     uint32_t way = entry->getWay();
     delete entry;
     m_cache[cache_set][way] = NULL;
-    m_tag_index.erase(address);
+    eraseTag(cache_set, way, address);
 }
 
 // Returns with the physical address of the conflicting cache line
@@ -47,6 +47,7 @@
 #include <vector>
 
 #include "base/statistics.hh"
+#include "enums/RubyCacheTagIndex.hh"
 #include "mem/cache/replacement_policies/base.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/ruby/common/DataBlock.hh"
@@ -171,6 +172,27 @@ class CacheMemory : public SimObject
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
 
+    // Tag index lookups, returning -1 if the tag is not found
+    int findTagInHashMap(Addr tag) const;
+    int
+    findTagInFlatSet(int64_t cacheSet, Addr tag) const
+    {
+        // Scan the whole set without an early exit, which lets the
+        // compiler vectorize the tag compare. The tags of a set are
+        // unique, so at most one way matches.
+        const Addr *tags = &m_flat_tags[cacheSet * m_cache_assoc];
+        int loc = -1;
+        for (int i = 0; i < m_cache_assoc; i++) {
+            if (tags[i] == tag)
+                loc = i;
+        }
+        return loc;
+    }
+
+    // Update the tag index when a way is (de)allocated
+    void insertTag(int64_t cacheSet, int loc, Addr tag);
+    void eraseTag(int64_t cacheSet, int loc, Addr tag);
+
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
     CacheMemory& operator=(const CacheMemory& obj);
@@ -179,11 +201,18 @@ class CacheMemory : public SimObject
     // Data Members (m_prefix)
     bool m_is_instruction_only_cache;
 
+    const RubyCacheTagIndex m_tag_index_type;
+
     // The first index is the # of cache lines.
     // The second index is the the amount associativity.
     std::unordered_map<Addr, int> m_tag_index;
     std::vector<std::vector<AbstractCacheEntry*> > m_cache;
 
+    // The tags of all the ways, set after set, used by the flat tag
+    // index. Ways without a block hold invalidTag.
+    std::vector<Addr> m_flat_tags;
+    static constexpr Addr invalidTag = MaxAddr;
+
     /** We use the replacement policies from the Classic memory system. */
     replacement_policy::Base *m_replacementPolicy_ptr;
 
@@ -30,6 +30,14 @@ from m5.proxy import *
 from m5.SimObject import SimObject
 
 
+# The tag index finds the way holding a block in a set. 'hash_map' looks
+# the block address up in a node-based hash map, while 'flat' scans the
+# tags of the set, which are stored contiguously. 'checked' uses both and
+# fails if they disagree.
+class RubyCacheTagIndex(ScopedEnum):
+    vals = ["hash_map", "flat", "checked"]
+
+
 class RubyCache(SimObject):
     type = "RubyCache"
     cxx_class = "gem5::ruby::CacheMemory"
@@ -43,6 +51,9 @@ class RubyCache(SimObject):
     block_size = Param.MemorySize(
         "0B", "block size in bytes. 0 means default RubyBlockSize"
     )
+    tag_index = Param.RubyCacheTagIndex(
+        "flat", "data structure used to find the blocks in the cache"
+    )
 
     # Atomic parameters only applicable to GPU atomics
     # Zero atomic latency corresponds to instantanous atomic ALU operations
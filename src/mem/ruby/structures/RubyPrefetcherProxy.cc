@@ -124,17 +124,17 @@ RubyPrefetcherProxy::issuePrefetch()
                 RubyRequestType req_type = pkt->needsWritable() ?
                                     RubyRequestType_ST : RubyRequestType_LD;
 
-                std::shared_ptr<RubyRequest> msg =
-                    std::make_shared<RubyRequest>(cacheCntrl->clockEdge(),
-                                                  blk_size,
-                                                  cacheCntrl->m_ruby_system,
-                                                  pkt->getAddr(),
-                                                  blk_size,
-                                                  0, // pc
-                                                  req_type,
-                                                  RubyAccessMode_Supervisor,
-                                                  pkt,
-                                                  PrefetchBit_Yes);
+                RefCountingPtr<RubyRequest> msg =
+                    new RubyRequest(cacheCntrl->clockEdge(),
+                                    blk_size,
+                                    cacheCntrl->m_ruby_system,
+                                    pkt->getAddr(),
+                                    blk_size,
+                                    0, // pc
+                                    req_type,
+                                    RubyAccessMode_Supervisor,
+                                    pkt,
+                                    PrefetchBit_Yes);
 
                 // enqueue request into prefetch queue to the cache
                 pfQueue->enqueue(msg, cacheCntrl->clockEdge(),
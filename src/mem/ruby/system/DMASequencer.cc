@@ -112,8 +112,8 @@ DMASequencer::makeRequest(PacketPtr pkt)
 
     int blk_size = m_ruby_system->getBlockSizeBytes();
 
-    std::shared_ptr<SequencerMsg> msg =
-        std::make_shared<SequencerMsg>(clockEdge(), blk_size, m_ruby_system);
+    RefCountingPtr<SequencerMsg> msg =
+        new SequencerMsg(clockEdge(), blk_size, m_ruby_system);
     msg->getPhysicalAddress() = paddr;
     msg->getLineAddress() = line_addr;
 
@@ -188,8 +188,8 @@ DMASequencer::issueNext(const Addr& address)
 
     int blk_size = m_ruby_system->getBlockSizeBytes();
 
-    std::shared_ptr<SequencerMsg> msg =
-        std::make_shared<SequencerMsg>(clockEdge(), blk_size, m_ruby_system);
+    RefCountingPtr<SequencerMsg> msg =
+        new SequencerMsg(clockEdge(), blk_size, m_ruby_system);
     msg->getPhysicalAddress() = active_request.start_paddr +
                                 active_request.bytes_completed;
 
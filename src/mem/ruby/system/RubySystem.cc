@@ -223,6 +223,9 @@ RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
 void
 RubySystem::memWriteback()
 {
+    fatal_if(m_multi_eventq, "Flushing the Ruby caches is not supported "
+             "when controllers run on different event queues\n");
+
     m_cooldown_enabled = true;
 
     // Make the trace so we know what to write back.
@@ -429,6 +432,25 @@ void
 RubySystem::init()
 {
     registerRequestorIDs();
+
+    // Controllers (and the network) may be partitioned over several event
+    // queues, in which case messages between them are handed over at
+    // quantum boundaries by the MessageBuffers.
+    for (auto *cntrl : m_abs_cntrl_vec) {
+        if (cntrl->eventQueue() != eventQueue()) {
+            m_multi_eventq = true;
+            break;
+        }
+    }
+
+    fatal_if(m_multi_eventq && m_randomization,
+             "Ruby randomization is not supported when controllers run on "
+             "different event queues\n");
+
+    // Any object, e.g., the network, may be on another event queue than
+    // its neighbours and share messages with another thread
+    if (numMainEventQueues > 1)
+        Message::setAtomicRefCount(true);
 }
 
 void
@@ -452,6 +474,10 @@ RubySystem::startup()
     // state was checkpointed.
 
     if (m_warmup_enabled) {
+        fatal_if(m_multi_eventq, "Restoring the Ruby cache state is not "
+                 "supported when controllers run on different event "
+                 "queues\n");
+
         DPRINTF(RubyCacheTrace, "Starting ruby cache warmup\n");
         // save the current tick value
         Tick curtick_original = curTick();
@@ -152,6 +152,8 @@ class RubySystem : public ClockedObject
 
     bool m_warmup_enabled = false;
     bool m_cooldown_enabled = false;
+    //! True if the controllers are spread over several event queues
+    bool m_multi_eventq = false;
     memory::SimpleMemory *m_phys_mem;
     const bool m_access_backing_store;
 
@@ -67,8 +67,8 @@ class DeferEnqueueingStatementAST(StatementAST):
 
         # Declare message
         code(
-            "std::shared_ptr<${{msg_type.c_ident}}> out_msg = "
-            "std::make_shared<${{msg_type.c_ident}}>(clockEdge(),"
+            "RefCountingPtr<${{msg_type.c_ident}}> out_msg = "
+            "new ${{msg_type.c_ident}}(clockEdge(), "
             "    m_ruby_system->getBlockSizeBytes(), m_ruby_system);"
         )
 
@@ -75,8 +75,8 @@ class EnqueueStatementAST(StatementAST):
 
         # Declare message
         code(
-            "std::shared_ptr<${{msg_type.c_ident}}> out_msg = "
-            "std::make_shared<${{msg_type.c_ident}}>(clockEdge(), "
+            "RefCountingPtr<${{msg_type.c_ident}}> out_msg = "
+            "new ${{msg_type.c_ident}}(clockEdge(), "
             "    m_ruby_system->getBlockSizeBytes(), m_ruby_system);"
         )
 
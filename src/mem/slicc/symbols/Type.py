@@ -254,6 +254,10 @@ class Type(Symbol):
                     '#include "mem/ruby/protocol/$0.hh"', dm.type.gen_filename
                 )
 
+        if self.isMessage:
+            code('#include "base/free_list_pool.hh"')
+            code('#include "config/use_mem_pools.hh"')
+
         parent = ""
         if "interface" in self:
             code('#include "mem/ruby/protocol/$0.hh"', self["interface"])
@@ -424,8 +428,25 @@ $klass ${{self.c_ident}}$parent
 MsgPtr
 clone() const
 {
-     return std::shared_ptr<Message>(new ${{self.c_ident}}(*this));
+     return MsgPtr(new ${{self.c_ident}}(*this));
+}
+
+#if USE_MEM_POOLS
+/** Pool the messages of this type are allocated from. */
+static FreeListPool &pool();
+
+static void *
+operator new(size_t size)
+{
+    return pool().allocate(size);
 }
+
+static void
+operator delete(void *ptr, size_t size)
+{
+    pool().deallocate(ptr, size);
+}
+#endif
 """
             )
         else:
@@ -647,6 +668,37 @@ out << "${{dm.ident}} = " << printAddress(m_${{dm.ident}}, block_size_bits) << "
         for item in self.methods:
             code(self.methods[item].generateCode())
 
+        if self.isMessage:
+            if self.shared:
+                pool_name = f"ruby_{self.c_ident}"
+            else:
+                protocol = self.symtab.slicc.protocol
+                pool_name = f"ruby_{protocol}_{self.c_ident}"
+            code(
+                """
+
+#if USE_MEM_POOLS
+FreeListPool &
+${{self.c_ident}}::pool()
+{
+    // Never destroyed, since messages may still be freed during exit
+    static FreeListPool *the_pool =
+        new FreeListPool("${{pool_name}}", sizeof(${{self.c_ident}}));
+    return *the_pool;
+}
+
+namespace
+{
+
+// Create the pool during static initialization, so that it is
+// registered before the pool statistics are set up.
+[[maybe_unused]] FreeListPool &${{self.c_ident}}Pool =
+    ${{self.c_ident}}::pool();
+
+} // anonymous namespace
+#endif"""
+            )
+
         # For protocol-specific types, close the protocol namespace
         if not self.shared:
             code(
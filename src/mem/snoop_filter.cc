@@ -156,6 +156,23 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
     return snoopSelected(maskToPortList(interested & ~req_port), lookupLatency);
 }
 
+SnoopFilter::SnoopList
+SnoopFilter::peekRequest(const Packet* cpkt,
+                         const ResponsePort& cpu_side_port) const
+{
+    Addr line_addr = cpkt->getBlockAddr(linesize);
+    if (cpkt->isSecure()) {
+        line_addr |= LineSecure;
+    }
+
+    auto it = cachedLocations.find(line_addr);
+    if (it == cachedLocations.end())
+        return SnoopList();
+
+    SnoopMask interested = it->second.holder | it->second.requested;
+    return maskToPortList(interested & ~portToMask(cpu_side_port));
+}
+
 void
 SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 {
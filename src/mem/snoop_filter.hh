@@ -142,6 +142,18 @@ class SnoopFilter : public SimObject
     std::pair<SnoopList, Cycles> lookupRequest(const Packet* cpkt,
                                         const ResponsePort& cpu_side_port);
 
+    /**
+     * Determine the snoop targets of a request from a CPU-side port,
+     * like lookupRequest, but without updating the snoop filter or its
+     * statistics.
+     *
+     * @param cpkt          Pointer to the request packet. Not changed.
+     * @param cpu_side_port Response port where the request was seen.
+     * @return Vector of snoop target ports.
+     */
+    SnoopList peekRequest(const Packet* cpkt,
+                          const ResponsePort& cpu_side_port) const;
+
     /**
      * For an un-successful request, revert the change to the snoop
      * filter. Also take care of erasing any null entries. This method
@@ -68,6 +68,7 @@ BaseXBar::BaseXBar(const BaseXBarParams &p)
                           p.port_mem_side_ports_connection_count, false),
       gotAllAddrRanges(false), defaultPortID(InvalidPortID),
       useDefaultRange(p.use_default_range),
+      crossQueueBufferSize(p.cross_queue_buffer_size),
 
       ADD_STAT(transDist, statistics::units::Count::get(),
                "Transaction distribution"),
@@ -104,6 +105,33 @@ BaseXBar::getPort(const std::string &if_name, PortID idx)
     }
 }
 
+void
+BaseXBar::spliceCrossQueuePorts()
+{
+    if (numMainEventQueues < 2)
+        return;
+
+    std::vector<Port *> ports(cpuSidePorts.begin(), cpuSidePorts.end());
+    ports.insert(ports.end(), memSidePorts.begin(), memSidePorts.end());
+
+    for (auto *port : ports) {
+        if (!port->isConnected())
+            continue;
+
+        // Peers connected from C++ rather than from the configuration
+        // have no known owner and are assumed to be local.
+        SimObject *owner = port->getPeer().ownerObject();
+        EventQueue *peer_eq = owner ? owner->eventQueue() : eventQueue();
+        if (peer_eq == eventQueue())
+            continue;
+
+        DPRINTF(BaseXBar, "Splicing cross-queue port in front of %s\n",
+                port->getPeer());
+        crossQueuePorts.emplace_back(new CrossQueuePort(
+            *port, eventQueue(), peer_eq, crossQueueBufferSize));
+    }
+}
+
 void
 BaseXBar::calcPacketTiming(PacketPtr pkt, Tick header_delay)
 {
@@ -47,10 +47,12 @@
 #define __MEM_XBAR_HH__
 
 #include <deque>
+#include <memory>
 #include <unordered_map>
 
 #include "base/addr_range_map.hh"
 #include "base/types.hh"
+#include "mem/cross_queue_port.hh"
 #include "mem/qport.hh"
 #include "params/BaseXBar.hh"
 #include "sim/clocked_object.hh"
@@ -395,8 +397,21 @@ class BaseXBar : public ClockedObject
        addresses not handled by another port to default device. */
     const bool useDefaultRange;
 
+    /** Packets of each type a cross-queue port can put aside */
+    const unsigned crossQueueBufferSize;
+
+    /** Ports spliced in front of peers on other event queues */
+    std::vector<std::unique_ptr<CrossQueuePort>> crossQueuePorts;
+
     BaseXBar(const BaseXBarParams &p);
 
+    /**
+     * Splice a CrossQueuePort in front of each peer of the crossbar
+     * that runs on another event queue. This must be called from
+     * init(), once the ports are connected.
+     */
+    void spliceCrossQueuePorts();
+
     /**
      * Stats for transaction distribution and data passing through the
      * crossbar. The transaction distribution is globally counting
@@ -631,6 +631,7 @@ class SimObject(metaclass=MetaSimObject):
     eventq_index = Param.UInt32(Parent.eventq_index, "Event Queue Index")
 
     cxx_exports = [
+        PyBindMethod("checkpointTaken"),
         PyBindMethod("init"),
         PyBindMethod("initState"),
         PyBindMethod("memInvalidate"),
@@ -25,6 +25,11 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 from .abstract_stat import AbstractStat
+from .columnar import (
+    ColumnarDump,
+    ColumnarLoader,
+    ColumnarStat,
+)
 from .group import (
     Group,
     SimObjectGroup,
@@ -0,0 +1,335 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import struct
+from array import array
+from typing import (
+    IO,
+    Dict,
+    Iterator,
+    List,
+    Optional,
+    Union,
+)
+
+from .group import Group
+from .simstat import SimStat
+from .statistic import (
+    Scalar,
+    Statistic,
+    Vector,
+)
+
+_MAGIC = b"gem5col\0"
+_BYTE_ORDER_MARK = 0x01020304
+_VERSION = 1
+
+_SCHEMA_RECORD = 1
+_DUMP_RECORD = 2
+
+_FULL_ENCODING = 0
+_CHANGE_ENCODING = 1
+
+
+class ColumnarStat:
+    """
+    The schema of a stat in a columnar stat file. The values of the stat
+    are stored in the columns [offset, offset + len(labels)) of a dump.
+    """
+
+    def __init__(
+        self,
+        name: str,
+        type: str,
+        unit: str,
+        description: str,
+        labels: List[str],
+        offset: int,
+    ):
+        self.name = name
+        self.type = type
+        self.unit = unit
+        self.description = description
+        self.labels = labels
+        self.offset = offset
+
+    def __len__(self) -> int:
+        return len(self.labels)
+
+    def __repr__(self) -> str:
+        return f"ColumnarStat({self.name}, {self.type}, {len(self)} columns)"
+
+
+class ColumnarDump:
+    """
+    A single stat dump. Scalars are returned as floats and all other
+    stats as a dictionary mapping column labels to values.
+    """
+
+    def __init__(
+        self, tick: int, stats: Dict[str, ColumnarStat], values: array
+    ):
+        self.tick = tick
+        self.stats = stats
+        self.values = values
+
+    def __contains__(self, name: str) -> bool:
+        return name in self.stats
+
+    def __getitem__(self, name: str) -> Union[float, Dict[str, float]]:
+        stat = self.stats[name]
+        if stat.type == "Scalar":
+            return self.values[stat.offset]
+        return dict(
+            zip(
+                stat.labels,
+                self.values[stat.offset : stat.offset + len(stat)],
+            )
+        )
+
+    def to_simstat(self) -> SimStat:
+        """
+        Convert the dump to a SimStat. Stat names are split into groups
+        at each dot. Stats other than scalars are converted to vectors
+        of scalars indexed by their column labels.
+        """
+
+        root = {}
+        for name, stat in self.stats.items():
+            *groups, leaf = name.split(".")
+            node = root
+            for group in groups:
+                node = node.setdefault(group, {})
+            node[leaf] = self._to_statistic(stat)
+
+        def to_group(node: dict) -> Dict[str, Union[Group, Statistic]]:
+            return {
+                key: (
+                    Group(**to_group(value))
+                    if isinstance(value, dict)
+                    else value
+                )
+                for key, value in node.items()
+            }
+
+        return SimStat(simulated_end_time=self.tick, **to_group(root))
+
+    def _to_statistic(self, stat: ColumnarStat) -> Statistic:
+        description = stat.description or None
+        if stat.type == "Scalar":
+            return Scalar(
+                value=self.values[stat.offset],
+                unit=stat.unit,
+                description=description,
+            )
+
+        # Vectors index numeric subnames by number
+        return Vector(
+            value={
+                int(label) if label.isdigit() else label: Scalar(
+                    value=value, unit=stat.unit
+                )
+                for label, value in zip(
+                    stat.labels,
+                    self.values[stat.offset : stat.offset + len(stat)],
+                )
+            },
+            type=stat.type,
+            description=description,
+        )
+
+
+class ColumnarLoader:
+    """
+    Reader of the stat files written by the columnar stat output
+    (columnar://stats.col). Dumps stored as changes are reconstructed
+    by replaying the file from its start, so iterating over the dumps is
+    much cheaper than accessing them one at a time.
+
+    Usage
+    -----
+
+    .. code-block::
+
+            from m5.ext.pystats import ColumnarLoader
+
+            with open(path, "rb") as f:
+                stats = ColumnarLoader(f)
+
+            for dump in stats:
+                print(dump.tick, dump["system.cpu.ipc"])
+
+            ipc = stats.column("system.cpu.ipc")
+            simstat = stats[-1].to_simstat()
+
+    """
+
+    def __init__(self, stat_file: IO[bytes]):
+        self._data = stat_file.read()
+        header = self._data[: len(_MAGIC) + 8]
+        if len(header) < len(_MAGIC) + 8 or header[: len(_MAGIC)] != _MAGIC:
+            raise ValueError("Not a columnar stat file")
+
+        bom = header[len(_MAGIC) : len(_MAGIC) + 4]
+        if struct.unpack("<I", bom)[0] == _BYTE_ORDER_MARK:
+            self._order = "<"
+        elif struct.unpack(">I", bom)[0] == _BYTE_ORDER_MARK:
+            self._order = ">"
+        else:
+            raise ValueError("Invalid byte order mark")
+        self._swap = struct.pack("=I", 1) != struct.pack(self._order + "I", 1)
+
+        (version,) = self._unpack("I", len(_MAGIC) + 4)
+        if version != _VERSION:
+            raise ValueError(f"Unsupported columnar stat version {version}")
+
+        # Index the records, each being (kind, payload offset, length)
+        self._records = []
+        pos = len(header)
+        while pos + 12 <= len(self._data):
+            kind, length = self._unpack("IQ", pos)
+            pos += 12
+            if pos + length > len(self._data):
+                # Truncated record, e.g., the simulation is still running
+                break
+            self._records.append((kind, pos, length))
+            pos += length
+
+        self._num_dumps = sum(
+            1 for kind, _, _ in self._records if kind == _DUMP_RECORD
+        )
+
+    def __len__(self) -> int:
+        return self._num_dumps
+
+    def __iter__(self) -> Iterator[ColumnarDump]:
+        schema = []
+        stats = {}
+        values = array("d")
+        for kind, pos, length in self._records:
+            if kind == _SCHEMA_RECORD:
+                schema = self._read_schema(schema, pos)
+                stats = {stat.name: stat for stat in schema}
+            elif kind == _DUMP_RECORD:
+                num_cols = schema[-1].offset + len(schema[-1]) if schema else 0
+                tick, values = self._read_dump(values, num_cols, pos, length)
+                yield ColumnarDump(tick, stats, values)
+
+    def __getitem__(self, index: int) -> ColumnarDump:
+        if index < 0:
+            index += len(self)
+        if not 0 <= index < len(self):
+            raise IndexError("Stat dump index out of range")
+        for i, dump in enumerate(self):
+            if i == index:
+                return dump
+
+    def ticks(self) -> List[int]:
+        """The tick of each dump."""
+        ticks = []
+        for kind, pos, _ in self._records:
+            if kind == _DUMP_RECORD:
+                ticks.append(self._unpack("Q", pos)[0])
+        return ticks
+
+    def column(
+        self, name: str, label: Optional[str] = None
+    ) -> List[Optional[Union[float, Dict[str, float]]]]:
+        """
+        The values of a stat in each dump, or of a single column of it
+        if a label is given. The value is None for the dumps that don't
+        include the stat or column.
+        """
+        series = []
+        for dump in self:
+            stat = dump.stats.get(name)
+            if stat is None:
+                series.append(None)
+            elif label is None:
+                series.append(dump[name])
+            elif label not in stat.labels:
+                series.append(None)
+            else:
+                series.append(
+                    dump.values[stat.offset + stat.labels.index(label)]
+                )
+        return series
+
+    def _unpack(self, fmt: str, pos: int):
+        return struct.unpack_from(self._order + fmt, self._data, pos)
+
+    def _read_str(self, pos: int):
+        (length,) = self._unpack("I", pos)
+        pos += 4
+        return self._data[pos : pos + length].decode(), pos + length
+
+    def _read_schema(
+        self, schema: List[ColumnarStat], pos: int
+    ) -> List[ColumnarStat]:
+        first, num_stats = self._unpack("II", pos)
+        pos += 8
+        schema = schema[:first]
+        offset = schema[-1].offset + len(schema[-1]) if schema else 0
+        for _ in range(num_stats):
+            name, pos = self._read_str(pos)
+            type, pos = self._read_str(pos)
+            unit, pos = self._read_str(pos)
+            description, pos = self._read_str(pos)
+            (num_cols,) = self._unpack("I", pos)
+            pos += 4
+            labels = []
+            for _ in range(num_cols):
+                label, pos = self._read_str(pos)
+                labels.append(label)
+            schema.append(
+                ColumnarStat(name, type, unit, description, labels, offset)
+            )
+            offset += num_cols
+        return schema
+
+    def _read_dump(self, values: array, num_cols: int, pos: int, length: int):
+        tick, encoding = self._unpack("QI", pos)
+        end = pos + length
+        pos += 12
+        if encoding == _FULL_ENCODING:
+            values = array("d")
+            values.frombytes(self._data[pos:end])
+            if self._swap:
+                values.byteswap()
+        elif encoding == _CHANGE_ENCODING:
+            values = array("d", values)
+            (count,) = self._unpack("I", pos)
+            pos += 4
+            for column, value in struct.iter_unpack(
+                self._order + "Id", self._data[pos : pos + count * 12]
+            ):
+                values[column] = value
+        else:
+            raise ValueError(f"Unknown dump encoding {encoding}")
+
+        if len(values) != num_cols:
+            raise ValueError("Stat dump doesn't match the stat schema")
+        return tick, values
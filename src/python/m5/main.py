@@ -227,6 +227,14 @@ def parse_options():
         default="stats.txt",
         help="Sets the output file for statistics [Default: %default]",
     )
+    option(
+        "--stats-select",
+        metavar="GLOB[,GLOB]",
+        action="append",
+        split=",",
+        help="Only prepare and dump the stats whose full name matches "
+        "any GLOB (e.g., 'system.cpu*.ipc')",
+    )
     option(
         "--stats-help",
         action="callback",
@@ -301,6 +309,13 @@ def parse_options():
         help="Sets the output file for debug. Append '.gz' to the name for it"
         " to be compressed automatically [Default: %default]",
     )
+    option(
+        "--debug-binary",
+        action="store_true",
+        help="Record debug output in a compact binary format, to be "
+        "rendered as text by util/render_debug_trace.py. The output file "
+        "defaults to trace.bin.",
+    )
     option(
         "--debug-activate",
         metavar="EXPR[,EXPR]",
@@ -396,6 +411,7 @@ def main():
         inform,
         isInteractive,
         panic,
+        warn,
     )
 
     options, arguments = parse_options()
@@ -564,6 +580,8 @@ def main():
 
     # set stats options
     stats.addStatVisitor(options.stats_file)
+    if options.stats_select:
+        stats.select(*options.stats_select)
 
     # Disable listeners unless running interactively or explicitly
     # enabled
@@ -603,6 +621,8 @@ def main():
                 debug.flags[flag].disable()
             else:
                 debug.flags[flag].enable()
+                if debug.flags[flag].compiledOut:
+                    warn(f"Debug flag '{flag}' is compiled out of this build.")
 
     if options.debug_start:
         _check_tracing()
@@ -616,7 +636,13 @@ def main():
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_binary:
+        if options.debug_file == "cout":
+            trace.binaryOutput("trace.bin")
+        else:
+            trace.binaryOutput(options.debug_file)
+    else:
+        trace.output(options.debug_file)
 
     for activate in options.debug_activate:
         _check_tracing()
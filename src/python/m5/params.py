@@ -2210,6 +2210,8 @@ class PortRef:
 
         port = self.simobj.getPort(self.name, self.index)
         peer_port = peer.simobj.getPort(peer.name, peer.index)
+        port.setOwnerObject(self.simobj.getCCObject())
+        peer_port.setOwnerObject(peer.simobj.getCCObject())
         port.bind(peer_port)
 
         self.ccConnected = True
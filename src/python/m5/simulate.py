@@ -335,6 +335,9 @@ def checkpoint(dir):
     print("Writing checkpoint")
     _m5.core.serializeAll(dir)
 
+    for obj in root.descendants():
+        obj.checkpointTaken()
+
 
 def _changeMemoryMode(system, mode):
     if not isinstance(system, (objects.Root, objects.System)):
@@ -190,6 +190,33 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
 
+@_url_factory(["columnar"])
+def _columnarFactory(fn, changes=True, desc=True, formulas=True):
+    """Output stats in a binary, columnar format.
+
+    The names and shapes of all stats are written once, and each stat
+    dump only appends the vector of stat values. This makes frequent
+    (e.g., periodic) stat dumps of large systems much cheaper to write
+    and store than text stat files. With change encoding, a dump only
+    stores the values that changed since the previous dump.
+
+    Derived values, such as vector totals and distribution means, are
+    not stored. Stat files can be read with
+    m5.ext.pystats.ColumnarLoader.
+
+    Parameters:
+      * changes (bool): Only store changed values if smaller (default: True)
+      * desc (bool): Output stat descriptions (default: True)
+      * formulas (bool): Output derived stats (default: True)
+
+    Example:
+      columnar://stats.col?changes=False;desc=False
+
+    """
+
+    return _m5.stats.initColumnar(fn, changes, desc, formulas)
+
+
 @_url_factory(["json"])
 def _jsonFactory(fn):
     """Output stats in JSON format.
@@ -307,6 +334,52 @@ names = []
 stats_dict = {}
 stats_list = []
 
+# Stat selection patterns, as (pattern, is_regex) tuples
+_selection = []
+
+
+def select(*patterns, regex=False):
+    """Only prepare and dump the stats matching any of the patterns
+
+    Patterns are matched against the full name of the stats (e.g.,
+    system.cpu.ipc). Glob patterns are used by default, where '*'
+    matches any sequence of characters, dots included. Set regex to
+    use ECMAScript regular expressions instead. The selection is
+    cumulative, and all stats are selected if it is empty.
+
+    The selection is applied when the stats are enabled, after which
+    the stat groups without any selected stat are skipped entirely when
+    preparing and dumping stats. This makes stat dumps of large
+    systems much cheaper if only a few stats are needed.
+
+    Example:
+      select("system.cpu*.ipc", "simSeconds")
+      select("system.cpu[0-9]+.(ipc|cpi)", regex=True)
+
+    """
+
+    _selection.extend((pattern, regex) for pattern in patterns)
+    if _m5.stats.enabled():
+        _select_stats()
+
+
+def _select_stats():
+    stat_filter = _m5.stats.StatFilter()
+    for pattern, regex in _selection:
+        if regex:
+            stat_filter.addRegex(pattern)
+        else:
+            stat_filter.addGlob(pattern)
+
+    # Legacy stats
+    for stat in stats_list:
+        stat.selected = stat_filter.match(stat.name)
+
+    # New stats
+    root = Root.getInstance()
+    if root:
+        root.selectStats(stat_filter, "")
+
 
 def enable():
     """Enable the statistics package.  Before the statistics package is
@@ -343,44 +416,40 @@ def enable():
 
     _m5.stats.enable()
 
+    if _selection:
+        _select_stats()
+
 
 def prepare():
-    """Prepare all stats for data access.  This must be done before
-    dumping and serialization."""
+    """Prepare all selected stats for data access.  This must be done
+    before dumping and serialization."""
 
     # Legacy stats
     for stat in stats_list:
-        stat.prepare()
+        if stat.selected:
+            stat.prepare()
 
     # New stats
-    _visit_stats(lambda g, s: s.prepare())
+    Root.getInstance().prepareStats()
 
 
 def _dump_to_visitor(visitor, roots=None):
-    # New stats
-    def dump_group(group):
-        for stat in group.getStats():
-            stat.visit(visitor)
-        for n, g in group.getStatGroups().items():
-            visitor.beginGroup(n)
-            dump_group(g)
-            visitor.endGroup()
-
     if roots:
         # New stats from selected subroots.
         for root in roots:
             for p in root.path_list():
                 visitor.beginGroup(p)
-            dump_group(root)
+            root.visitStats(visitor)
             for p in reversed(root.path_list()):
                 visitor.endGroup()
     else:
         # New stats starting from root.
-        dump_group(Root.getInstance())
+        Root.getInstance().visitStats(visitor)
 
         # Legacy stats
         for stat in stats_list:
-            stat.visit(visitor)
+            if stat.selected:
+                stat.visit(visitor)
 
 
 lastDump = 0
@@ -417,17 +486,22 @@ def dump(roots=None):
             sim_root.preDumpStats()
         prepare()
 
-    for output in outputList:
-        if isinstance(output, JsonOutputVistor):
-            if not all_roots:
-                output.dump(Root.getInstance())
+    # Formulas are evaluated at most once while dumping
+    _m5.stats.beginDump()
+    try:
+        for output in outputList:
+            if isinstance(output, JsonOutputVistor):
+                if not all_roots:
+                    output.dump(Root.getInstance())
+                else:
+                    output.dump(all_roots)
             else:
-                output.dump(all_roots)
-        else:
-            if output.valid():
-                output.begin()
-                _dump_to_visitor(output, roots=all_roots)
-                output.end()
+                if output.valid():
+                    output.begin()
+                    _dump_to_visitor(output, roots=all_roots)
+                    output.end()
+    finally:
+        _m5.stats.endDump()
 
 
 def reset():
@@ -27,8 +27,10 @@
 # Export native methods to Python
 from _m5.trace import (
     activate,
+    binaryOutput,
     disable,
     enable,
     ignore,
     output,
+    render,
 )
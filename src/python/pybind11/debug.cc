@@ -42,13 +42,20 @@
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
+#include <fstream>
+#include <iostream>
 #include <map>
+#include <memory>
 #include <vector>
+#include <zfstream.h>
 
+#include "base/binary_trace.hh"
 #include "base/compiler.hh"
 #include "base/debug.hh"
+#include "base/logging.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
 
 namespace py = pybind11;
@@ -67,6 +74,44 @@ output(const char *filename)
     trace::setDebugLogger(new trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+binaryOutput(const char *filename)
+{
+    OutputStream *file_stream = simout.find(filename);
+
+    if (!file_stream)
+        file_stream = simout.create(filename, true);
+
+    auto *logger = new trace::BinaryLogger(*file_stream->stream());
+    trace::setDebugLogger(logger);
+
+    // Messages are only written by a background thread, so make sure
+    // none of them is left behind when exiting, including through
+    // panic() and fatal(), which don't run the exit callbacks.
+    registerExitCallback([logger]() { logger->flush(); });
+    Logger::addExitHook([logger]() { logger->flush(); });
+}
+
+static void
+render(const std::string &input, const std::string &output)
+{
+    std::unique_ptr<std::istream> in;
+    if (input.size() > 3 && input.compare(input.size() - 3, 3, ".gz") == 0)
+        in.reset(new gzifstream(input.c_str(), std::ios::in));
+    else
+        in.reset(new std::ifstream(input, std::ios::binary));
+    fatal_if(!*in, "Can't open binary trace '%s'.\n", input);
+
+    std::ofstream file;
+    if (output != "cout") {
+        file.open(output);
+        fatal_if(!file, "Can't open output file '%s'.\n", output);
+    }
+
+    fatal_if(!trace::renderBinaryTrace(*in, file.is_open() ? file : std::cout),
+             "'%s' is not a valid binary trace.\n", input);
+}
+
 static void
 activate(const char *expr)
 {
@@ -102,6 +147,7 @@ pybind_init_debug(py::module_ &m_native)
         .def_property_readonly("desc", &debug::Flag::desc)
         .def("enable", &debug::Flag::enable)
         .def("disable", &debug::Flag::disable)
+        .def_property_readonly("compiledOut", &debug::Flag::compiledOut)
         .def_property("tracing",
                       [](const debug::Flag *flag) {
                           return flag->tracing();
@@ -129,6 +175,8 @@ pybind_init_debug(py::module_ &m_native)
     py::module_ m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("binaryOutput", &binaryOutput)
+        .def("render", &render)
         .def("activate", &activate)
         .def("ignore", &ignore)
         .def("enable", &trace::enable)
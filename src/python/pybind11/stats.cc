@@ -42,6 +42,8 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/columnar.hh"
+#include "base/stats/filter.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -116,6 +118,7 @@ pybind_init_stats(py::module_ &m_native)
 #if HAVE_HDF5
         .def("initHDF5", &statistics::initHDF5)
 #endif
+        .def("initColumnar", &statistics::initColumnar)
         .def("registerPythonStatsHandlers",
              &statistics::registerPythonStatsHandlers)
         .def("schedStatEvent", &statistics::schedStatEvent)
@@ -123,6 +126,8 @@ pybind_init_stats(py::module_ &m_native)
         .def("updateEvents", &statistics::updateEvents)
         .def("processResetQueue", &statistics::processResetQueue)
         .def("processDumpQueue", &statistics::processDumpQueue)
+        .def("beginDump", &statistics::beginDump)
+        .def("endDump", &statistics::endDump)
         .def("enable", &statistics::enable)
         .def("enabled", &statistics::enabled)
         .def("statsList", &statistics::statsList)
@@ -136,6 +141,14 @@ pybind_init_stats(py::module_ &m_native)
         .def("endGroup", &statistics::Output::endGroup)
         ;
 
+    py::class_<statistics::StatFilter>(m, "StatFilter")
+        .def(py::init<>())
+        .def("addGlob", &statistics::StatFilter::addGlob)
+        .def("addRegex", &statistics::StatFilter::addRegex)
+        .def("empty", &statistics::StatFilter::empty)
+        .def("match", &statistics::StatFilter::match)
+        ;
+
     py::class_<statistics::Info,
         std::unique_ptr<statistics::Info, py::nodelete>>(m, "Info")
         .def_readwrite("name", &statistics::Info::name)
@@ -144,6 +157,7 @@ pybind_init_stats(py::module_ &m_native)
             })
         .def_readonly("desc", &statistics::Info::desc)
         .def_readonly("id", &statistics::Info::id)
+        .def_readwrite("selected", &statistics::Info::selected)
         .def_property_readonly("flags", [](const statistics::Info &info) {
                 return (statistics::FlagsType)info.flags;
             })
@@ -246,6 +260,9 @@ pybind_init_stats(py::module_ &m_native)
         .def("regStats", &statistics::Group::regStats)
         .def("resetStats", &statistics::Group::resetStats)
         .def("preDumpStats", &statistics::Group::preDumpStats)
+        .def("selectStats", &statistics::Group::selectStats)
+        .def("prepareStats", &statistics::Group::prepareStats)
+        .def("visitStats", &statistics::Group::visitStats)
         .def("getStats", [](const statistics::Group &self)
              -> std::vector<py::object> {
 
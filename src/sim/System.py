@@ -49,6 +49,15 @@ class MemoryMode(Enum):
     vals = ["invalid", "atomic", "timing", "atomic_noncaching"]
 
 
+# The format the backing store of the memories is checkpointed in.
+# 'gzip' compresses the whole store. 'raw' writes an uncompressed sparse
+# image, which is restored by mapping the file copy-on-write. 'chunked'
+# splits the store into chunks that are compressed in parallel, using zstd
+# if available, and skips the chunks only holding zeros.
+class MemoryStoreFormat(ScopedEnum):
+    vals = ["gzip", "raw", "chunked"]
+
+
 class System(SimObject):
     type = "System"
     cxx_header = "sim/system.hh"
@@ -103,6 +112,21 @@ class System(SimObject):
         "shmem segment file upon destruction. This is used only if "
         "shared_backstore is non-empty.",
     )
+    memory_store_format = Param.MemoryStoreFormat(
+        "gzip", "Format of the memory backing store in checkpoints"
+    )
+    memory_store_threads = Param.Unsigned(
+        0,
+        "Number of threads compressing and decompressing chunked memory "
+        "stores, 0 to use one per host core",
+    )
+    memory_store_delta = Param.Bool(
+        False,
+        "Only checkpoint the pages of the memory backing store written "
+        "since the previous checkpoint taken or restored by this simulation, "
+        "referring to that checkpoint for the other pages. Requires a "
+        "kernel tracking soft-dirty pages",
+    )
 
     cache_line_size = Param.Unsigned(64, "Cache line size in bytes")
 
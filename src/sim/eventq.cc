@@ -30,6 +30,7 @@
 
 #include "sim/eventq.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <mutex>
@@ -39,6 +40,7 @@
 
 #include "base/logging.hh"
 #include "base/trace.hh"
+#include "config/use_calendar_eventq.hh"
 #include "cpu/smt.hh"
 #include "debug/Checkpoint.hh"
 
@@ -47,6 +49,23 @@ namespace gem5
 
 Tick simQuantum = 0;
 
+const EventQueue::Backend EventQueue::defaultBackend =
+#if USE_CALENDAR_EVENTQ
+    EventQueue::Backend::Calendar;
+#else
+    EventQueue::Backend::BinList;
+#endif
+
+namespace
+{
+
+//! Smallest number of calendar buckets (must be a power of 2)
+const size_t minCalendarBuckets = 16;
+//! Number of bins sampled to size the calendar buckets
+const size_t calendarWidthSamples = 32;
+
+} // anonymous namespace
+
 //
 // Main Event Queues
 //
@@ -134,19 +153,20 @@ Event::releaseImpl()
         delete this;
 }
 
-void
-EventQueue::insert(Event *event)
+bool
+EventQueue::insertIntoBins(Event *&bins, Event *event)
 {
     // Deal with the head case
-    if (!head || *event <= *head) {
-        head = Event::insertBefore(event, head);
-        return;
+    if (!bins || *event <= *bins) {
+        bool new_bin = !bins || *event < *bins;
+        bins = Event::insertBefore(event, bins);
+        return new_bin;
     }
 
     // Figure out either which 'in bin' list we are on, or where a new list
     // needs to be inserted
-    Event *prev = head;
-    Event *curr = head->nextBin;
+    Event *prev = bins;
+    Event *curr = bins->nextBin;
     while (curr && *curr < *event) {
         prev = curr;
         curr = curr->nextBin;
@@ -154,7 +174,18 @@ EventQueue::insert(Event *event)
 
     // Note: this operation may render all nextBin pointers on the
     // prev 'in bin' list stale (except for the top one)
+    bool new_bin = !curr || *event < *curr;
     prev->nextBin = Event::insertBefore(event, curr);
+    return new_bin;
+}
+
+void
+EventQueue::insert(Event *event)
+{
+    if (backend == Backend::Calendar)
+        calendarInsert(event);
+    else
+        insertIntoBins(head, event);
 }
 
 Event *
@@ -188,24 +219,23 @@ Event::removeItem(Event *event, Event *top)
     return top;
 }
 
-void
-EventQueue::remove(Event *event)
+bool
+EventQueue::removeFromBins(Event *&bins, Event *event)
 {
-    if (head == NULL)
+    if (bins == NULL)
         panic("event not found!");
 
-    assert(event->queue == this);
-
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
-    if (*head == *event) {
-        head = Event::removeItem(event, head);
-        return;
+    if (*bins == *event) {
+        bool last = event == bins && !bins->nextInBin;
+        bins = Event::removeItem(event, bins);
+        return last;
     }
 
     // Find the 'in bin' list that this event belongs on
-    Event *prev = head;
-    Event *curr = head->nextBin;
+    Event *prev = bins;
+    Event *curr = bins->nextBin;
     while (curr && *curr < *event) {
         prev = curr;
         curr = curr->nextBin;
@@ -217,7 +247,203 @@ EventQueue::remove(Event *event)
     // curr points to the top item of the the correct 'in bin' list, when
     // we remove an item, it returns the new top item (which may be
     // unchanged)
+    bool last = event == curr && !curr->nextInBin;
     prev->nextBin = Event::removeItem(event, curr);
+    return last;
+}
+
+void
+EventQueue::remove(Event *event)
+{
+    assert(event->queue == this);
+
+    if (backend == Backend::Calendar)
+        calendarRemove(event);
+    else
+        removeFromBins(head, event);
+}
+
+void
+EventQueue::calendarSetHead(Event *bin)
+{
+    head = bin;
+    if (!bin)
+        return;
+
+    // The window of the head bucket ends at the start of the next
+    // bucket, which may be beyond MaxTick.
+    Tick bucket_start = bin->when() - bin->when() % bucketWidth;
+    curBucket = bucketIndex(bin->when());
+    bucketTop = bucket_start > MaxTick - bucketWidth ?
+        MaxTick : bucket_start + bucketWidth;
+}
+
+void
+EventQueue::calendarFindHead()
+{
+    if (!numBins) {
+        head = NULL;
+        return;
+    }
+
+    // Look for the first bucket, starting from the one of the previous
+    // head, whose earliest bin falls in the window the bucket covers
+    // in the current round of the calendar. No bin precedes the
+    // previous head, so that bin is the earliest one of the queue.
+    const size_t mask = buckets.size() - 1;
+    size_t index = curBucket;
+    Tick top = bucketTop;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        Event *bin = buckets[index];
+        if (bin && bin->when() < top) {
+            head = bin;
+            curBucket = index;
+            bucketTop = top;
+            return;
+        }
+
+        index = (index + 1) & mask;
+        top = top > MaxTick - bucketWidth ? MaxTick : top + bucketWidth;
+    }
+
+    // All bins are at least a round away, search them directly
+    Event *earliest = NULL;
+    for (auto *bin : buckets) {
+        if (bin && (!earliest || *bin < *earliest))
+            earliest = bin;
+    }
+    calendarSetHead(earliest);
+}
+
+void
+EventQueue::calendarInsert(Event *event)
+{
+    if (insertIntoBins(buckets[bucketIndex(event->when())], event))
+        ++numBins;
+
+    // The event is at the top of its bin, so it becomes the head if
+    // it is in the head bin or before it.
+    if (!head || *event <= *head)
+        calendarSetHead(event);
+
+    if (numBins > 2 * buckets.size())
+        calendarResize(2 * buckets.size());
+}
+
+void
+EventQueue::calendarRemove(Event *event)
+{
+    const bool head_bin = *event == *head;
+
+    if (removeFromBins(buckets[bucketIndex(event->when())], event))
+        --numBins;
+
+    // The head bin, if it still exists, is at the front of its bucket
+    // and is found right away.
+    if (head_bin)
+        calendarFindHead();
+
+    if (buckets.size() > minCalendarBuckets && numBins < buckets.size() / 2)
+        calendarResize(buckets.size() / 2);
+}
+
+void
+EventQueue::calendarInsertBin(Event *bin)
+{
+    Event **link = &buckets[bucketIndex(bin->when())];
+    while (*link && **link < *bin)
+        link = &(*link)->nextBin;
+
+    assert(!*link || **link != *bin);
+    bin->nextBin = *link;
+    *link = bin;
+    ++numBins;
+
+    if (!head || *bin < *head)
+        calendarSetHead(bin);
+}
+
+void
+EventQueue::calendarResize(size_t num_buckets)
+{
+    std::vector<Event *> bins = sortedBins();
+
+    // Size the buckets to hold a few bins each, based on the average
+    // distance between the upcoming bins. Distances well above the
+    // average are left out, so that a few far away events do not make
+    // the buckets too wide.
+    const size_t samples = std::min(bins.size(), calendarWidthSamples);
+    if (samples > 1) {
+        Tick span = bins[samples - 1]->when() - bins[0]->when();
+        Tick average = span / (samples - 1);
+
+        Tick total = 0;
+        size_t count = 0;
+        for (size_t i = 1; i < samples; ++i) {
+            Tick distance = bins[i]->when() - bins[i - 1]->when();
+            if (distance / 2 <= average) {
+                total += distance;
+                ++count;
+            }
+        }
+
+        if (count && total) {
+            Tick width = total / count;
+            bucketWidth = width > MaxTick / 3 ? MaxTick : 3 * width;
+            bucketWidth = std::max<Tick>(1, bucketWidth);
+        }
+    }
+
+    buckets.assign(num_buckets, NULL);
+
+    // Link the bins from the latest one so that each bucket ends up
+    // sorted.
+    for (auto it = bins.rbegin(); it != bins.rend(); ++it) {
+        Event *&bucket = buckets[bucketIndex((*it)->when())];
+        (*it)->nextBin = bucket;
+        bucket = *it;
+    }
+
+    calendarSetHead(head);
+}
+
+Event *
+EventQueue::calendarExtract()
+{
+    std::vector<Event *> bins = sortedBins();
+
+    Event *first = NULL;
+    for (auto it = bins.rbegin(); it != bins.rend(); ++it) {
+        (*it)->nextBin = first;
+        first = *it;
+    }
+
+    buckets.assign(minCalendarBuckets, NULL);
+    numBins = 0;
+    head = NULL;
+
+    return first;
+}
+
+std::vector<Event *>
+EventQueue::sortedBins() const
+{
+    std::vector<Event *> bins;
+
+    if (backend == Backend::Calendar) {
+        bins.reserve(numBins);
+        for (auto *bucket : buckets) {
+            for (Event *bin = bucket; bin; bin = bin->nextBin)
+                bins.push_back(bin);
+        }
+        std::sort(bins.begin(), bins.end(),
+                  [](const Event *l, const Event *r) { return *l < *r; });
+    } else {
+        for (Event *bin = head; bin; bin = bin->nextBin)
+            bins.push_back(bin);
+    }
+
+    return bins;
 }
 
 Event *
@@ -225,10 +451,11 @@ EventQueue::serviceOne()
 {
     std::lock_guard<EventQueue> lock(*this);
     Event *event = head;
-    Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
 
-    if (next) {
+    if (backend == Backend::Calendar) {
+        calendarRemove(event);
+    } else if (Event *next = head->nextInBin) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
 
@@ -321,15 +548,12 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
+        for (Event *nextBin : sortedBins()) {
             Event *nextInBin = nextBin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -342,10 +566,9 @@ EventQueue::debugVerify() const
     std::unordered_map<long, bool> map;
 
     Tick time = 0;
-    short priority = 0;
+    Event::Priority priority = Event::Minimum_Pri;
 
-    Event *nextBin = head;
-    while (nextBin) {
+    for (Event *nextBin : sortedBins()) {
         Event *nextInBin = nextBin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
@@ -371,8 +594,6 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
@@ -381,6 +602,24 @@ EventQueue::debugVerify() const
 Event*
 EventQueue::replaceHead(Event* s)
 {
+    if (backend == Backend::Calendar) {
+        // Hand out the bins as a sorted list, as kept by the bin list
+        // backend, and take the new bins from such a list.
+        Event *t = calendarExtract();
+        for (Event *bin = s; bin; ) {
+            Event *next = bin->nextBin;
+            calendarInsertBin(bin);
+            bin = next;
+        }
+        if (numBins > 2 * buckets.size()) {
+            size_t num_buckets = buckets.size();
+            while (numBins > 2 * num_buckets)
+                num_buckets *= 2;
+            calendarResize(num_buckets);
+        }
+        return t;
+    }
+
     Event* t = head;
     head = s;
     return t;
@@ -441,9 +680,12 @@ Event::dump() const
     }
 }
 
-EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
+EventQueue::EventQueue(const std::string &n, Backend _backend)
+    : objName(n), head(NULL), _curTick(0), backend(_backend),
+      bucketWidth(1000), numBins(0), curBucket(0), bucketTop(0)
 {
+    if (backend == Backend::Calendar)
+        buckets.assign(minCalendarBuckets, NULL);
 }
 
 void
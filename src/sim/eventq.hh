@@ -43,6 +43,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/debug.hh"
 #include "base/flags.hh"
@@ -264,7 +265,9 @@ class Event : public EventBase, public Serializable
     // result is that the insert/removal in 'nextBin' is
     // linear/constant, and the lookup/removal in 'nextInBin' is
     // constant/constant.  Hopefully this is a significant improvement
-    // over the current fully linear insertion.
+    // over the current fully linear insertion.  When an EventQueue
+    // uses the calendar backend, the bins are spread over buckets and
+    // 'nextBin' links the bins of the same bucket instead.
     Event *nextBin;
     Event *nextInBin;
 
@@ -614,6 +617,28 @@ operator!=(const Event &l, const Event &r)
  */
 class EventQueue
 {
+  public:
+    /**
+     * Data structure used to keep the events sorted. Both backends
+     * process events in exactly the same order.
+     *
+     * @ingroup api_eventq
+     */
+    enum class Backend
+    {
+        /** A sorted list of bins, with linear insertion and removal */
+        BinList,
+        /**
+         * A calendar queue: the bins are hashed on their tick into
+         * buckets that are resized as the queue grows and shrinks,
+         * giving amortized constant time insertion and removal.
+         */
+        Calendar
+    };
+
+    /** Backend used by default, selected when building gem5. */
+    static const Backend defaultBackend;
+
   private:
     friend void curEventQueue(EventQueue *);
 
@@ -621,6 +646,19 @@ class EventQueue
     Event *head;
     Tick _curTick;
 
+    const Backend backend;
+
+    //! Calendar buckets, each one a sorted list of bins. The bin
+    //! with the earliest tick of a bucket is at the front of its list.
+    std::vector<Event *> buckets;
+    //! Number of ticks covered by a bucket
+    Tick bucketWidth;
+    //! Number of bins in the calendar
+    size_t numBins;
+    //! Bucket of the head of the queue, and the end of its window
+    size_t curBucket;
+    Tick bucketTop;
+
     //! Mutex to protect async queue.
     UncontendedMutex async_queue_mutex;
 
@@ -654,6 +692,29 @@ class EventQueue
     void insert(Event *event);
     void remove(Event *event);
 
+    //! Insert / remove an event from a sorted list of bins. Return true
+    //! if a bin was created / removed.
+    static bool insertIntoBins(Event *&bins, Event *event);
+    static bool removeFromBins(Event *&bins, Event *event);
+
+    //! The bins of the queue in the order they will be serviced in.
+    std::vector<Event *> sortedBins() const;
+
+    //! Calendar backend implementation.
+    size_t
+    bucketIndex(Tick when) const
+    {
+        return (when / bucketWidth) & (buckets.size() - 1);
+    }
+
+    void calendarInsert(Event *event);
+    void calendarRemove(Event *event);
+    void calendarInsertBin(Event *bin);
+    void calendarSetHead(Event *bin);
+    void calendarFindHead();
+    void calendarResize(size_t num_buckets);
+    Event *calendarExtract();
+
     //! Function for adding events to the async queue. The added events
     //! are added to main event queue later. Threads, other than the
     //! owning thread, should call this function instead of insert().
@@ -738,7 +799,7 @@ class EventQueue
     /**
      * @ingroup api_eventq
      */
-    EventQueue(const std::string &n);
+    EventQueue(const std::string &n, Backend backend=defaultBackend);
 
     /**
      * @ingroup api_eventq
@@ -157,6 +157,8 @@ GlobalSyncEvent::BarrierEvent::process()
 void
 GlobalSyncEvent::process()
 {
+    quantumCallbacks().process();
+
     if (repeat) {
         schedule(curTick() + repeat);
     }
@@ -168,4 +170,11 @@ GlobalSyncEvent::description() const
     return "GlobalSyncEvent";
 }
 
+CallbackQueue &
+GlobalSyncEvent::quantumCallbacks()
+{
+    static CallbackQueue callbacks;
+    return callbacks;
+}
+
 } // namespace gem5
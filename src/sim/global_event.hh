@@ -34,6 +34,7 @@
 #include <vector>
 
 #include "base/barrier.hh"
+#include "base/callback.hh"
 #include "sim/eventq.hh"
 
 namespace gem5
@@ -237,6 +238,14 @@ class GlobalSyncEvent : public BaseGlobalEventTemplate<GlobalSyncEvent>
 
     const char *description() const;
 
+    /**
+     * Callbacks run at every quantum boundary by exactly one thread,
+     * while all other threads are waiting on the barrier. Objects that
+     * exchange state across event queues can use this to publish it
+     * in an order that does not depend on host thread scheduling.
+     */
+    static CallbackQueue &quantumCallbacks();
+
     Tick repeat;
 };
 
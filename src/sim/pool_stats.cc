@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/pool_stats.hh"
+
+#include "base/trace.hh"
+#include "debug/MemPools.hh"
+#include "sim/core.hh"
+
+namespace gem5
+{
+
+PoolStats &
+PoolStats::instance()
+{
+    static PoolStats the_instance;
+    return the_instance;
+}
+
+PoolStats::PoolStats()
+    : statistics::Group(nullptr)
+{
+    for (auto *pool : FreeListPool::pools())
+        poolGroups.emplace_back(new PoolGroup(this, *pool));
+
+    registerExitCallback([this]() { checkLeaks(); });
+}
+
+PoolStats::PoolGroup::PoolGroup(statistics::Group *parent,
+                                FreeListPool &_pool)
+    : statistics::Group(parent, _pool.name().c_str()),
+      pool(_pool),
+      ADD_STAT(hits, statistics::units::Count::get(),
+               "Number of allocations served from a free list"),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of allocations served from the heap"),
+      ADD_STAT(live, statistics::units::Count::get(),
+               "Number of blocks currently in use"),
+      ADD_STAT(hitRate, statistics::units::Ratio::get(),
+               "Fraction of allocations served from a free list",
+               hits / (hits + misses))
+{
+    hits.functor([this]() { return pool.counters().hits - base.hits; });
+    misses.functor([this]() {
+        return pool.counters().misses - base.misses;
+    });
+    live.functor([this]() { return pool.counters().live(); });
+}
+
+void
+PoolStats::PoolGroup::resetStats()
+{
+    statistics::Group::resetStats();
+    base = pool.counters();
+}
+
+void
+PoolStats::checkLeaks() const
+{
+    for (const auto &group : poolGroups) {
+        const uint64_t live = group->pool.counters().live();
+        if (live) {
+            DPRINTFR(MemPools, "Pool %s: %d blocks still in use at exit\n",
+                     group->pool.name(), live);
+        }
+    }
+}
+
+} // namespace gem5
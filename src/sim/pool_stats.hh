@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_POOL_STATS_HH__
+#define __SIM_POOL_STATS_HH__
+
+#include <memory>
+#include <vector>
+
+#include "base/free_list_pool.hh"
+#include "base/statistics.hh"
+
+namespace gem5
+{
+
+/**
+ * Statistics of all the free-list pools, which are added to the root
+ * as the "pools" group. The pools must be created before the group,
+ * typically during static initialization.
+ *
+ * The group also registers an exit callback that reports the pools
+ * that still have blocks in use when the simulator exits, which is
+ * enabled by the MemPools debug flag. Blocks in use at exit are not
+ * necessarily leaked since objects may still be in flight, so this is
+ * mostly useful after draining the system.
+ */
+class PoolStats : public statistics::Group
+{
+  public:
+    static PoolStats &instance();
+
+  private:
+    PoolStats();
+
+    struct PoolGroup : public statistics::Group
+    {
+        PoolGroup(statistics::Group *parent, FreeListPool &_pool);
+
+        void resetStats() override;
+
+        FreeListPool &pool;
+
+        //! Counters at the last reset
+        FreeListPool::Counters base;
+
+        statistics::Value hits;
+        statistics::Value misses;
+        statistics::Value live;
+        statistics::Formula hitRate;
+    };
+
+    /** Report the pools with blocks still in use. */
+    void checkLeaks() const;
+
+    std::vector<std::unique_ptr<PoolGroup>> poolGroups;
+};
+
+} // namespace gem5
+
+#endif // __SIM_POOL_STATS_HH__
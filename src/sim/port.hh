@@ -55,6 +55,8 @@
 namespace gem5
 {
 
+class SimObject;
+
 /**
  * Ports are used to interface objects to each other.
  */
@@ -89,6 +91,12 @@ class Port
      */
     bool _connected;
 
+    /**
+     * The object owning this port, if known. This is set when ports
+     * are connected from the configuration scripts.
+     */
+    SimObject *_ownerObject = nullptr;
+
     /**
      * Abstract base class for ports
      *
@@ -113,6 +121,12 @@ class Port
     /** Get the port id. */
     PortID getId() const { return id; }
 
+    /** Return the object owning this port, or nullptr if unknown. */
+    SimObject *ownerObject() const { return _ownerObject; }
+
+    /** Record the object owning this port. */
+    void setOwnerObject(SimObject *obj) { _ownerObject = obj; }
+
     /** Attach to a peer port. */
     virtual void
     bind(Port &peer)
@@ -28,6 +28,7 @@
 #include "pybind11/pybind11.h"
 #include "sim/init.hh"
 #include "sim/port.hh"
+#include "sim/sim_object.hh"
 
 namespace gem5
 {
@@ -43,6 +44,7 @@ sim_pybind(pybind11::module_ &m_internal)
         Port, std::unique_ptr<Port, pybind11::nodelete>>(m, "Port")
         .def("bind", &Port::bind)
         .def("name", &Port::name)
+        .def("setOwnerObject", &Port::setOwnerObject)
         ;
 }
 EmbeddedPyBind embed_("sim", &sim_pybind);
@@ -47,6 +47,7 @@
 #include "sim/cur_tick.hh"
 #include "sim/eventq.hh"
 #include "sim/full_system.hh"
+#include "sim/pool_stats.hh"
 #include "sim/root.hh"
 
 namespace gem5
@@ -193,6 +194,9 @@ Root::Root(const RootParams &p, int)
     // having a single global stat group for global stats. Merge that
     // group into the root object here.
     mergeStatGroup(&Root::RootStats::instance);
+
+    // The free-list pools are not owned by any object either.
+    addStatGroup("pools", &PoolStats::instance());
 }
 
 void
@@ -312,6 +312,17 @@ class SimObject : public EventManager, public Serializable, public Drainable,
      */
     virtual void memInvalidate() {};
 
+    /**
+     * Notify the object that a checkpoint was just written.
+     *
+     * This method is called once all the objects were serialized,
+     * for objects which track their changes relative to the latest
+     * checkpoint, as serialize() mustn't change their state.
+     *
+     * @ingroup api_simobject
+     */
+    virtual void checkpointTaken() {};
+
     void serialize(CheckpointOut &cp) const override {};
     void unserialize(CheckpointIn &cp) override {};
 
@@ -223,6 +223,10 @@ simulate(Tick num_cycles)
         fatal_if(simQuantum == 0,
                  "Quantum for multi-eventq simulation not specified");
 
+        // Publish any cross-queue state left over from the previous
+        // call to simulate() before the threads start running again.
+        GlobalSyncEvent::quantumCallbacks().process();
+
         quantum_event.reset(
             new GlobalSyncEvent(curTick() + simQuantum, simQuantum,
                                 EventBase::Progress_Event_Pri, 0));
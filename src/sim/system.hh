@@ -579,6 +579,7 @@ class System : public SimObject, public PCEventScope
 
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
+    void checkpointTaken() override { physmem.checkpointTaken(); }
 
   public:
     std::map<std::pair<uint32_t, uint32_t>, Tick>  lastWorkItemStarted;
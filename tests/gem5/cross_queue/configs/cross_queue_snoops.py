@@ -0,0 +1,113 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+This script runs memory testers whose caches are on different event
+queues, so that coherence traffic crosses partitions. Every core has a
+tester and a small L1 (and optionally a private L2) on its own event
+queue, and they share a coherent membus on the first event queue. A
+cacheless tester on the membus plays the role of a DMA engine: its
+requests snoop the caches of all the cores mid-quantum, and the
+writebacks of the small caches snoop the caches of the other cores.
+"""
+
+import argparse
+
+import m5
+from m5.objects import *
+
+m5.util.addToPath("../../../../configs/")
+from common.Caches import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument(
+    "-c", "--cores", type=int, default=4, help="Number of cores (max 7)"
+)
+parser.add_argument(
+    "--l2", action="store_true", help="Give every core a private L2"
+)
+parser.add_argument(
+    "--no-snoop-filter",
+    action="store_true",
+    help="Broadcast all snoops, including the ones of writebacks",
+)
+parser.add_argument(
+    "--max-loads", type=int, default=20000, help="Loads per tester"
+)
+args = parser.parse_args()
+
+# the testers falsely share the blocks, one byte per tester
+assert 1 <= args.cores <= 7
+
+tester_args = dict(
+    max_loads=args.max_loads,
+    progress_interval=args.max_loads // 10,
+    # functional accesses can't be ordered against the other queues
+    percent_functional=0,
+    percent_uncacheable=0,
+)
+
+system = System(
+    cpu=[MemTest(**tester_args) for i in range(args.cores)],
+    dma=MemTest(**tester_args),
+    physmem=SimpleMemory(),
+    membus=SystemXBar(),
+)
+system.voltage_domain = VoltageDomain()
+system.clk_domain = SrcClockDomain(
+    clock="1GHz", voltage_domain=system.voltage_domain
+)
+if args.no_snoop_filter:
+    system.membus.snoop_filter = NULL
+
+for i, cpu in enumerate(system.cpu):
+    # the caches are children of the tester, and inherit its queue
+    cpu.eventq_index = i + 1
+    # small caches, to make them write back a lot
+    cpu.l1c = L1Cache(size="1KiB", assoc=2)
+    cpu.l1c.cpu_side = cpu.port
+    if args.l2:
+        cpu.l2bus = L2XBar()
+        cpu.l2c = L2Cache(size="4KiB", assoc=4)
+        cpu.l1c.mem_side = cpu.l2bus.cpu_side_ports
+        cpu.l2c.cpu_side = cpu.l2bus.mem_side_ports
+        cpu.l2c.mem_side = system.membus.cpu_side_ports
+    else:
+        cpu.l1c.mem_side = system.membus.cpu_side_ports
+
+system.dma.port = system.membus.cpu_side_ports
+system.system_port = system.membus.cpu_side_ports
+system.physmem.port = system.membus.mem_side_ports
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = "timing"
+root.sim_quantum = 1000
+
+m5.instantiate()
+exit_event = m5.simulate()
+if exit_event.getCause() != "maximum number of loads reached":
+    print(f"Unexpected exit: {exit_event.getCause()}")
+    exit(1)
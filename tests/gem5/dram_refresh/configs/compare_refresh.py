@@ -0,0 +1,197 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+This script checks that coalescing the refresh events of idle DRAM ranks
+does not change the results. Two identical memory controllers, one with
+coalescing enabled and one with it disabled, are driven by identical
+traffic generators. The traffic alternates short bursts of reads or
+writes with idle periods of several refresh intervals, and the stats are
+dumped and reset at times unrelated to the refreshes. All the stats of
+the two controllers must match in every dump. The controllers are either
+MemCtrls or HBMCtrls, whose second pseudo channel catches up on its
+refreshes separately, and the ranks may use their power-down states,
+which keep their refresh events.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+
+addToPath(os.path.join(os.path.dirname(__file__), "../../../../configs"))
+
+from common import ObjectList
+
+parser = argparse.ArgumentParser()
+
+parser.add_argument(
+    "--mem-type",
+    default=None,
+    choices=ObjectList.mem_list.get_names(),
+    help="type of memory to use (default: DDR4_2400_16x4, or "
+    "HBM_2000_4H_1x64 with --hbm)",
+)
+parser.add_argument(
+    "--mem-ranks", "-r", type=int, default=None, help="Number of ranks"
+)
+parser.add_argument(
+    "--hbm",
+    action="store_true",
+    help="Use HBM controllers, each with two pseudo channels",
+)
+parser.add_argument(
+    "--low-power",
+    action="store_true",
+    help="Enable the power-down states of the ranks",
+)
+
+args = parser.parse_args()
+
+if args.mem_type is None:
+    args.mem_type = "HBM_2000_4H_1x64" if args.hbm else "DDR4_2400_16x4"
+mem_class = ObjectList.mem_list.get(args.mem_type)
+if args.mem_ranks is None:
+    args.mem_ranks = mem_class.ranks_per_channel.value if args.hbm else 4
+
+system = System()
+system.clk_domain = SrcClockDomain(
+    clock="2.0GHz", voltage_domain=VoltageDomain(voltage="1V")
+)
+
+# Each HBM controller interleaves its pseudo channels at 64 bytes
+size = 256 * 1024 * 1024
+if args.hbm:
+    size *= 2
+system.mem_ranges = [AddrRange(0, size=2 * size)]
+
+ctrls = []
+gens = []
+for i, coalesce in enumerate([True, False]):
+
+    def dram(pseudo_channel=None):
+        if pseudo_channel is None:
+            mem_range = AddrRange(i * size, size=size)
+        else:
+            mem_range = AddrRange(
+                i * size,
+                size=size,
+                masks=[1 << 6],
+                intlvMatch=pseudo_channel,
+            )
+        return mem_class(
+            range=mem_range,
+            ranks_per_channel=args.mem_ranks,
+            enable_dram_powerdown=args.low_power,
+            coalesce_refresh=coalesce,
+            null=True,
+        )
+
+    if args.hbm:
+        ctrls.append(HBMCtrl(dram=dram(0), dram_2=dram(1)))
+    else:
+        ctrls.append(MemCtrl(dram=dram()))
+    gens.append(PyTrafficGen())
+    gens[i].port = ctrls[i].port
+
+system.ctrls = ctrls
+system.gens = gens
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = "timing"
+
+m5.instantiate()
+
+us = 1000000
+
+
+def trace(gen, base):
+    # Alternate bursts of reads and writes with idle periods of a few
+    # refresh intervals, some of them not a multiple of it
+    for i in range(8):
+        yield gen.createLinear(
+            2 * us, base, base + size - 1, 64, 5000, 5000, 100 * (i % 2), 0
+        )
+        yield gen.createIdle((23 + 17 * i) * us)
+    yield gen.createExit(0)
+
+
+for i, gen in enumerate(gens):
+    gen.start(trace(gen, i * size))
+
+# Dump the stats at times unrelated to the traffic and the refreshes, and
+# reset them after every other dump
+dumps = 0
+while True:
+    event = m5.simulate(37 * us + 123)
+    m5.stats.dump()
+    dumps += 1
+    if event.getCause() != "simulate() limit reached":
+        break
+    if dumps % 2 == 0:
+        m5.stats.reset()
+
+
+def ctrl_stats(lines, i):
+    """The stats of a controller, without its name."""
+    prefix = f"system.ctrls{i}."
+    stats = {}
+    for line in lines:
+        fields = line.split()
+        if fields and fields[0].startswith(prefix):
+            stats[fields[0][len(prefix) :]] = fields[1:]
+    return stats
+
+
+with open(os.path.join(m5.options.outdir, "stats.txt")) as f:
+    sections = re.split("Begin Simulation Statistics", f.read())[1:]
+
+if len(sections) != dumps:
+    sys.exit(f"Expected {dumps} stat dumps, found {len(sections)}")
+
+mismatches = 0
+for n, section in enumerate(sections):
+    lines = section.splitlines()
+    coalesced = ctrl_stats(lines, 0)
+    reference = ctrl_stats(lines, 1)
+    if not reference:
+        sys.exit(f"No controller stats in dump {n}")
+    for name in sorted(set(coalesced) | set(reference)):
+        if coalesced.get(name) != reference.get(name):
+            print(
+                f"Dump {n}: {name} is {coalesced.get(name)} with coalescing "
+                f"and {reference.get(name)} without"
+            )
+            mismatches += 1
+
+if mismatches:
+    sys.exit(f"{mismatches} stats differ with coalesced refresh events")
+
+print(f"All controller stats match in {dumps} dumps")
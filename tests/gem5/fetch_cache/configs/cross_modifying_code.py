@@ -0,0 +1,144 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Runs a program modifying the code another thread keeps running, on two
+AtomicSimpleCPUs with fetch caches, and optionally block caches of the
+instructions decoded from them, and exits with an error if the
+program sees stale code. With --caches, each CPU has private L1 caches,
+which hold the writes of the modifying CPU, and a shared L2 cache.
+"""
+
+import argparse
+import sys
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument("binary", help="Path to the cross-modifying program")
+parser.add_argument(
+    "--caches", action="store_true", help="Add caches to the CPUs"
+)
+parser.add_argument(
+    "--fetch-cache-lines",
+    type=int,
+    default=256,
+    help="Number of lines in the fetch cache of each CPU",
+)
+parser.add_argument(
+    "--block-cache-blocks",
+    type=int,
+    default=0,
+    help="Number of blocks in the block cache of each CPU",
+)
+args = parser.parse_args()
+
+system = System()
+system.clk_domain = SrcClockDomain(
+    clock="1GHz", voltage_domain=VoltageDomain()
+)
+system.mem_mode = "atomic"
+system.mem_ranges = [AddrRange("512MiB")]
+
+system.membus = SystemXBar()
+system.system_port = system.membus.cpu_side_ports
+
+system.cpu = [
+    X86AtomicSimpleCPU(
+        cpu_id=i,
+        fetch_cache_lines=args.fetch_cache_lines,
+        block_cache_blocks=args.block_cache_blocks,
+    )
+    for i in range(2)
+]
+
+if args.caches:
+    system.l2bus = L2XBar()
+    system.l2cache = Cache(
+        size="256KiB",
+        assoc=8,
+        tag_latency=20,
+        data_latency=20,
+        response_latency=20,
+        mshrs=20,
+        tgts_per_mshr=12,
+    )
+    system.l2cache.cpu_side = system.l2bus.mem_side_ports
+    system.l2cache.mem_side = system.membus.cpu_side_ports
+
+process = Process(cmd=[args.binary])
+
+for cpu in system.cpu:
+    if args.caches:
+        cpu.icache = Cache(
+            size="16KiB",
+            assoc=2,
+            tag_latency=2,
+            data_latency=2,
+            response_latency=2,
+            mshrs=4,
+            tgts_per_mshr=20,
+        )
+        cpu.dcache = Cache(
+            size="64KiB",
+            assoc=2,
+            tag_latency=2,
+            data_latency=2,
+            response_latency=2,
+            mshrs=4,
+            tgts_per_mshr=20,
+        )
+        cpu.icache_port = cpu.icache.cpu_side
+        cpu.dcache_port = cpu.dcache.cpu_side
+        cpu.icache.mem_side = system.l2bus.cpu_side_ports
+        cpu.dcache.mem_side = system.l2bus.cpu_side_ports
+    else:
+        cpu.icache_port = system.membus.cpu_side_ports
+        cpu.dcache_port = system.membus.cpu_side_ports
+
+    cpu.createInterruptController()
+    cpu.interrupts[0].pio = system.membus.mem_side_ports
+    cpu.interrupts[0].int_requestor = system.membus.cpu_side_ports
+    cpu.interrupts[0].int_responder = system.membus.mem_side_ports
+
+    # Both CPUs run the same process, the second one starting when the
+    # program creates its thread
+    cpu.workload = process
+    cpu.createThreads()
+
+system.mem_ctrl = MemCtrl(dram=DDR3_1600_8x8(range=system.mem_ranges[0]))
+system.mem_ctrl.port = system.membus.mem_side_ports
+
+system.workload = SEWorkload.init_compatible(args.binary)
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+exit_event = m5.simulate()
+print(f"Exiting @ tick {m5.curTick()} because {exit_event.getCause()}")
+if exit_event.getCode() != 0:
+    sys.exit(f"The program failed with exit code {exit_event.getCode()}")
@@ -0,0 +1,71 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Checks that the fetch cache of AtomicSimpleCPU, and the block cache of
+the instructions decoded from it, notice the code written by another
+CPU, with and without caches holding the writes.
+"""
+
+import re
+from itertools import product
+
+from testlib import *
+
+base_path = joinpath(config.bin_path, "smc", "x86")
+
+binary = "smc"
+url = config.resource_url + "/test-progs/smc/bin/x86/linux/" + binary
+smc = DownloadedProgram(url, base_path, binary)
+
+for caches, blocks in product((False, True), (0, 64)):
+    gem5_verify_config(
+        name="test-fetch-cache-cross-modifying-code"
+        + ("-caches" if caches else "")
+        + ("-block-cache" if blocks else ""),
+        fixtures=(smc,),
+        verifiers=(
+            verifier.MatchRegex(
+                re.compile("Ran the code modified by another thread")
+            ),
+        ),
+        config=joinpath(
+            config.base_dir,
+            "tests",
+            "gem5",
+            "fetch_cache",
+            "configs",
+            "cross_modifying_code.py",
+        ),
+        config_args=[
+            joinpath(base_path, binary),
+            "--block-cache-blocks",
+            str(blocks),
+        ]
+        + (["--caches"] if caches else []),
+        valid_isas=(constants.all_compiled_tag,),
+        valid_hosts=constants.supported_hosts,
+    )
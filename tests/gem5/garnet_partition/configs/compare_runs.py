@@ -0,0 +1,104 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+This script checks that a system partitioned over several event queues
+gives the same results every time it is run. It runs a config script,
+by default the garnet_synth_traffic.py example, twice in separate gem5
+processes, with the same arguments and so the same random seed, and
+checks that all the simulated statistics match. Only the host
+statistics, such as the host time, may differ. The arguments not known
+to this script are passed on to the config script.
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+parser = argparse.ArgumentParser()
+
+parser.add_argument(
+    "--runs", type=int, default=2, help="Number of runs to compare"
+)
+parser.add_argument(
+    "--config",
+    default="configs/example/garnet_synth_traffic.py",
+    help="Config script to run, relative to the root of gem5",
+)
+
+args, config_args = parser.parse_known_args()
+
+gem5_root = os.path.join(os.path.dirname(__file__), "../../../..")
+run_config = os.path.join(gem5_root, args.config)
+
+# The binary running this script
+gem5 = os.path.realpath("/proc/self/exe")
+
+
+def sim_stats(outdir):
+    """The simulated stats of a run, without its host stats."""
+    stats = []
+    with open(os.path.join(outdir, "stats.txt")) as f:
+        for line in f:
+            fields = line.split()
+            if not fields or fields[0].startswith("-"):
+                continue
+            if fields[0].split(".")[-1].startswith("host"):
+                continue
+            stats.append((fields[0], fields[1:]))
+    return stats
+
+
+runs = []
+with tempfile.TemporaryDirectory() as tmpdir:
+    for i in range(args.runs):
+        outdir = os.path.join(tmpdir, f"run{i}")
+        status = subprocess.call(
+            [gem5, "-d", outdir, run_config] + config_args,
+            stdout=subprocess.DEVNULL,
+        )
+        if status != 0:
+            sys.exit(f"Run {i} failed with status {status}")
+        runs.append(sim_stats(outdir))
+
+if not runs[0]:
+    sys.exit("No stats in the first run")
+
+mismatches = 0
+for i, run in enumerate(runs[1:], 1):
+    if [name for name, _ in run] != [name for name, _ in runs[0]]:
+        sys.exit(f"Run {i} does not have the same stats as run 0")
+    for (name, values), (_, reference) in zip(run, runs[0]):
+        if values != reference:
+            print(f"Run {i}: {name} is {values}, was {reference} in run 0")
+            mismatches += 1
+
+if mismatches:
+    sys.exit(f"{mismatches} stats differ between the runs")
+
+print(f"All {len(runs[0])} stats match in {args.runs} runs")
@@ -0,0 +1,79 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Checks that garnet networks partitioned over several event queues, and
+so simulated by several host threads, give the same stats when they are
+run twice.
+"""
+
+from testlib import *
+
+common_args = [
+    "--network=garnet",
+    "--topology=Mesh_XY",
+    "--mesh-rows=4",
+    "--num-cpus=16",
+    "--num-dirs=16",
+    "--sim-cycles=20000",
+]
+
+configs = {
+    "uniform-random-2-queues": [
+        "--synthetic=uniform_random",
+        "--injectionrate=0.1",
+        "--garnet-event-queues=2",
+    ],
+    "uniform-random-4-queues": [
+        "--synthetic=uniform_random",
+        "--injectionrate=0.1",
+        "--garnet-event-queues=4",
+    ],
+    "tornado-4-queues": [
+        "--synthetic=tornado",
+        "--injectionrate=0.2",
+        "--garnet-event-queues=4",
+    ],
+}
+
+for name, args in configs.items():
+    gem5_verify_config(
+        name=f"test-garnet-partition-determinism-{name}",
+        fixtures=(),
+        verifiers=(),
+        config=joinpath(
+            config.base_dir,
+            "tests",
+            "gem5",
+            "garnet_partition",
+            "configs",
+            "compare_runs.py",
+        ),
+        config_args=common_args + args,
+        valid_isas=(constants.null_tag,),
+        valid_hosts=constants.supported_hosts,
+        length=constants.long_tag,
+    )
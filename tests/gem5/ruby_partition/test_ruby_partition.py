@@ -0,0 +1,65 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Runs the Ruby memory tester with the CPUs and their L1 controllers
+partitioned over several event queues, so that Ruby messages cross the
+event queues. The testers check the data they read, and each test runs
+twice and checks that the stats are the same in both runs.
+"""
+
+from testlib import *
+
+common_args = [
+    "--config",
+    "configs/example/ruby_mem_test.py",
+    "--num-cpus=8",
+    "--maxloads=5000",
+]
+
+configs = {
+    "simple-2-queues": ["--network=simple", "--ruby-event-queues=2"],
+    "simple-4-queues": ["--network=simple", "--ruby-event-queues=4"],
+    "garnet-4-queues": ["--network=garnet", "--ruby-event-queues=4"],
+}
+
+for name, args in configs.items():
+    gem5_verify_config(
+        name=f"test-ruby-partition-{name}",
+        fixtures=(),
+        verifiers=(),
+        config=joinpath(
+            config.base_dir,
+            "tests",
+            "gem5",
+            "garnet_partition",
+            "configs",
+            "compare_runs.py",
+        ),
+        config_args=common_args + args,
+        valid_isas=(constants.null_tag,),
+        length=constants.long_tag,
+    )
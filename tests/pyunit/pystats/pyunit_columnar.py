@@ -0,0 +1,121 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import io
+import struct
+import unittest
+
+from m5.ext.pystats import ColumnarLoader
+
+
+def _str(s: str) -> bytes:
+    return struct.pack("<I", len(s)) + s.encode()
+
+
+def _record(kind: int, payload: bytes) -> bytes:
+    return struct.pack("<IQ", kind, len(payload)) + payload
+
+
+def _schema(first: int, stats) -> bytes:
+    payload = struct.pack("<II", first, len(stats))
+    for name, type, labels in stats:
+        payload += _str(name) + _str(type) + _str("Count") + _str("")
+        payload += struct.pack("<I", len(labels))
+        for label in labels:
+            payload += _str(label)
+    return _record(1, payload)
+
+
+def _full_dump(tick: int, values) -> bytes:
+    payload = struct.pack("<QI", tick, 0)
+    payload += struct.pack(f"<{len(values)}d", *values)
+    return _record(2, payload)
+
+
+def _change_dump(tick: int, changes) -> bytes:
+    payload = struct.pack("<QII", tick, 1, len(changes))
+    for column, value in changes:
+        payload += struct.pack("<Id", column, value)
+    return _record(2, payload)
+
+
+def _mock_stat_file() -> io.BytesIO:
+    """A stat file with three dumps, the last of which adds a key to a
+    sparse histogram, and a trailing truncated record."""
+    data = b"gem5col\0" + struct.pack("<II", 0x01020304, 1)
+    data += _schema(
+        0,
+        [
+            ("system.cpu.numCycles", "Scalar", [""]),
+            ("system.cpu.committed", "Vector", ["0", "1", "total"]),
+            ("system.hist", "SparseHist", ["samples"]),
+        ],
+    )
+    data += _full_dump(1000, [10.0, 1.0, 2.0, 3.0, 0.0])
+    data += _change_dump(2000, [(0, 20.0), (2, 5.0)])
+    data += _schema(2, [("system.hist", "SparseHist", ["samples", "4"])])
+    data += _full_dump(3000, [30.0, 1.0, 5.0, 6.0, 1.0, 1.0])
+    data += _full_dump(4000, [40.0])[:-4]
+    return io.BytesIO(data)
+
+
+class ColumnarLoaderTestSuite(unittest.TestCase):
+    def test_dumps(self):
+        stats = ColumnarLoader(_mock_stat_file())
+        self.assertEqual(len(stats), 3)
+        self.assertEqual(stats.ticks(), [1000, 2000, 3000])
+
+        dumps = list(stats)
+        self.assertEqual(dumps[0]["system.cpu.numCycles"], 10.0)
+        self.assertEqual(dumps[1]["system.cpu.numCycles"], 20.0)
+        self.assertEqual(
+            dumps[1]["system.cpu.committed"],
+            {"0": 1.0, "1": 5.0, "total": 3.0},
+        )
+        self.assertEqual(dumps[1]["system.hist"], {"samples": 0.0})
+        self.assertEqual(dumps[2]["system.hist"], {"samples": 1.0, "4": 1.0})
+
+    def test_column(self):
+        stats = ColumnarLoader(_mock_stat_file())
+        self.assertEqual(
+            stats.column("system.cpu.numCycles"), [10.0, 20.0, 30.0]
+        )
+        self.assertEqual(
+            stats.column("system.cpu.committed", "1"), [2.0, 5.0, 5.0]
+        )
+        self.assertEqual(stats.column("system.hist", "4"), [None, None, 1.0])
+
+    def test_simstat(self):
+        simstat = ColumnarLoader(_mock_stat_file())[-1].to_simstat()
+        self.assertEqual(simstat.simulated_end_time, 3000)
+        self.assertEqual(simstat.system.cpu.numCycles.value, 30.0)
+        self.assertEqual(simstat.system.cpu.numCycles.unit, "Count")
+        self.assertEqual(simstat.system.cpu.committed[1].value, 5.0)
+        self.assertEqual(simstat.system.cpu.committed["total"].value, 6.0)
+
+    def test_invalid_file(self):
+        with self.assertRaises(ValueError):
+            ColumnarLoader(io.BytesIO(b"---------- Begin Simulation"))
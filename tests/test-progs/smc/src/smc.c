@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Cross-modifying code test. A thread rewrites a function that another
+ * thread keeps calling, without any serializing instruction in the
+ * calling thread, which must eventually run the new code.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define ROUNDS 8
+#define MAX_CALLS 100000
+
+typedef int (*func_t)(void);
+
+static unsigned char *code;
+static volatile int seen;
+static volatile int written;
+
+/* Write a function returning a value, i.e., mov $value, %eax; ret */
+static void
+emit(int value)
+{
+    unsigned char insts[] = { 0xb8, value, 0, 0, 0, 0xc3 };
+    memcpy(code, insts, sizeof(insts));
+}
+
+static void *
+modify(void *arg)
+{
+    for (int round = 1; round < ROUNDS; round++) {
+        while (seen != round)
+            ;
+        emit(round + 1);
+        written = round + 1;
+    }
+    return NULL;
+}
+
+int
+main(int argc, char *argv[])
+{
+    code = mmap(NULL, 4096, PROT_READ | PROT_WRITE | PROT_EXEC,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    emit(1);
+
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, modify, NULL)) {
+        printf("Can't create the modifying thread\n");
+        return 1;
+    }
+
+    volatile func_t func = (func_t)code;
+    for (int round = 1; round <= ROUNDS; round++) {
+        /* Only count the calls made once the new code is written */
+        int calls = 0;
+        while (func() != round) {
+            if (written == round && ++calls == MAX_CALLS) {
+                printf("Round %d: stale code still running after %d "
+                       "calls\n", round, calls);
+                return 1;
+            }
+        }
+        seen = round;
+    }
+
+    pthread_join(thread, NULL);
+    printf("Ran the code modified by another thread %d times\n", ROUNDS);
+    return 0;
+}
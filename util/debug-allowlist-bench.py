@@ -0,0 +1,123 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script measures the host time gem5 binaries need to run a set of
+# regression test configurations, to compare binaries built with and
+# without a DEBUG_FLAG_ALLOWLIST. Runs are given as a config script and
+# its arguments, relative to the root of gem5. The default runs are the
+# NULL ISA memory regression tests, whose caches are full of trace
+# points; add the runs of other tests, e.g., Ruby or O3 CPU ones, for
+# binaries that can run them. The first binary is the reference, e.g.,
+# one built without an allowlist.
+#
+# Example:
+#   scons build/NULL/gem5.opt
+#   scons defconfig build/NULL_allowlist build_opts/NULL
+#   scons setconfig build/NULL_allowlist \
+#       DEBUG_FLAG_ALLOWLIST="Checkpoint Event"
+#   scons build/NULL_allowlist/gem5.opt
+#   util/debug-allowlist-bench.py -n 3 \
+#       build/NULL/gem5.opt build/NULL_allowlist/gem5.opt
+
+import argparse
+import os
+import re
+import shlex
+import subprocess
+import sys
+import tempfile
+
+default_runs = [
+    "tests/gem5/memory/memtest-run.py",
+    "tests/gem5/memory/simple-run.py",
+]
+
+parser = argparse.ArgumentParser()
+
+parser.add_argument(
+    "-r",
+    "--run",
+    action="append",
+    help="Config script and its arguments, may be given several times "
+    f"(default: {', '.join(default_runs)})",
+)
+parser.add_argument(
+    "-n",
+    "--repeat",
+    type=int,
+    default=1,
+    help="Runs per binary, the fastest one is reported",
+)
+parser.add_argument("binaries", nargs="+")
+
+args = parser.parse_args()
+
+gem5_root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def host_seconds(binary, run):
+    config, *config_args = shlex.split(run)
+    with tempfile.TemporaryDirectory() as outdir:
+        status = subprocess.call(
+            [binary, "-d", outdir, os.path.join(gem5_root, config)]
+            + config_args,
+            stdout=subprocess.DEVNULL,
+        )
+        if status != 0:
+            print(f"Error: {binary} failed to run {run}")
+            sys.exit(1)
+
+        with open(os.path.join(outdir, "stats.txt")) as stats:
+            for line in stats:
+                match = re.match(r"hostSeconds\s+(\S+)", line)
+                if match:
+                    return float(match.group(1))
+
+    print(f"Error: no hostSeconds in the stats of {binary} for {run}")
+    sys.exit(1)
+
+
+header = f"{'run':<40}" + "".join(f" {b[-24:]:>24}" for b in args.binaries)
+if len(args.binaries) > 1:
+    header += f" {'speedup':>8}"
+print(header)
+
+totals = [0.0] * len(args.binaries)
+for run in args.run or default_runs:
+    times = [
+        min(host_seconds(binary, run) for _ in range(args.repeat))
+        for binary in args.binaries
+    ]
+    totals = [total + t for total, t in zip(totals, times)]
+    line = f"{run[-40:]:<40}" + "".join(f" {t:>24.2f}" for t in times)
+    if len(times) > 1:
+        line += f" {times[0] / max(times[-1], 1e-9):>7.2f}x"
+    print(line)
+
+line = f"{'total':<40}" + "".join(f" {t:>24.2f}" for t in totals)
+if len(totals) > 1:
+    line += f" {totals[0] / max(totals[-1], 1e-9):>7.2f}x"
+print(line)
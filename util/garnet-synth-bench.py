@@ -0,0 +1,131 @@
+# Copyright (c) 2026 The Regents of the University of California
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script measures the host time needed to simulate a Garnet mesh
+# with the garnet_synth_traffic.py example script, across a range of
+# injection rates. It is meant to compare the simulation speed of
+# gem5 binaries, e.g., before and after a change to Garnet, so any
+# number of binaries can be given. The binaries have to be built with
+# the Garnet_standalone protocol, e.g., build/NULL/gem5.opt.
+#
+# Example:
+#   util/garnet-synth-bench.py -r 16 old/gem5.opt build/NULL/gem5.opt
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+parser = argparse.ArgumentParser()
+
+parser.add_argument(
+    "-r", "--mesh-rows", type=int, default=16, help="Rows of the mesh"
+)
+parser.add_argument(
+    "-c",
+    "--sim-cycles",
+    type=int,
+    default=100000,
+    help="Number of simulation cycles",
+)
+parser.add_argument(
+    "-i",
+    "--injection-rates",
+    type=float,
+    nargs="+",
+    default=[0.001, 0.005, 0.01, 0.05, 0.1, 0.2],
+    help="Injection rates in packets per cycle per node",
+)
+parser.add_argument(
+    "--synthetic", default="uniform_random", help="Traffic pattern"
+)
+parser.add_argument(
+    "-n",
+    "--repeat",
+    type=int,
+    default=1,
+    help="Runs per data point, the fastest one is reported",
+)
+parser.add_argument("binaries", nargs="+")
+
+args = parser.parse_args()
+
+gem5_root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+config = os.path.join(
+    gem5_root, "configs", "example", "garnet_synth_traffic.py"
+)
+nodes = args.mesh_rows * args.mesh_rows
+
+
+def host_seconds(binary, rate):
+    with tempfile.TemporaryDirectory() as outdir:
+        status = subprocess.call(
+            [
+                binary,
+                "-d",
+                outdir,
+                config,
+                "--network=garnet",
+                "--topology=Mesh_XY",
+                f"--mesh-rows={args.mesh_rows}",
+                f"--num-cpus={nodes}",
+                f"--num-dirs={nodes}",
+                f"--sim-cycles={args.sim_cycles}",
+                f"--synthetic={args.synthetic}",
+                f"--injectionrate={rate}",
+            ],
+            stdout=subprocess.DEVNULL,
+        )
+        if status != 0:
+            print(f"Error: {binary} failed at injection rate {rate}")
+            sys.exit(1)
+
+        with open(os.path.join(outdir, "stats.txt")) as stats:
+            for line in stats:
+                match = re.match(r"hostSeconds\s+(\S+)", line)
+                if match:
+                    return float(match.group(1))
+
+    print(f"Error: no hostSeconds in the stats of {binary}")
+    sys.exit(1)
+
+
+print(f"{args.mesh_rows}x{args.mesh_rows} mesh, {args.sim_cycles} cycles")
+header = f"{'rate':>8}" + "".join(f" {b[-24:]:>24}" for b in args.binaries)
+if len(args.binaries) > 1:
+    header += f" {'speedup':>8}"
+print(header)
+
+for rate in args.injection_rates:
+    times = [
+        min(host_seconds(binary, rate) for _ in range(args.repeat))
+        for binary in args.binaries
+    ]
+    line = f"{rate:>8}" + "".join(f" {t:>24.2f}" for t in times)
+    if len(times) > 1:
+        line += f" {times[0] / max(times[-1], 1e-9):>7.2f}x"
+    print(line)
@@ -0,0 +1,64 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Render a debug trace recorded with --debug-binary as text, formatted as
+if it had been recorded with the default text output.
+
+Usage
+=====
+
+```sh
+./build/ALL/gem5.opt util/render_debug_trace.py m5out/trace.bin trace.txt
+```
+
+The trace is written to the standard output if no output file is given.
+Format flags apply as they do to the text output, e.g., the flag of each
+message is shown by passing `--debug-flags=FmtFlag` to gem5 when
+rendering the trace.
+"""
+
+if __name__ == "__m5_main__":
+    import argparse
+
+    from m5 import trace
+
+    parser = argparse.ArgumentParser(
+        description="Render a binary debug trace as text."
+    )
+    parser.add_argument("input", help="Binary trace to render")
+    parser.add_argument(
+        "output",
+        nargs="?",
+        default="cout",
+        help="Text file to write the trace to",
+    )
+    args = parser.parse_args()
+
+    trace.render(args.input, args.output)
+
+if __name__ == "__main__":
+    print("Error: This script is meant to be run with the gem5 binary")